@@ -0,0 +1,322 @@
+#ifndef ALMACEN_EVENTOS_H
+#define ALMACEN_EVENTOS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "estructuras.h"
+#include "receptor_eventos.h"
+
+// Estado de un tramo del diagrama de Gantt guardado como número
+enum EstadoEvento : int32_t {
+    EVENTO_RUNNING,
+    EVENTO_WAITING,
+    EVENTO_ACCESSED,
+    EVENTO_OVERHEAD,
+    EVENTO_IO
+};
+
+inline const char* nombreEstadoEvento(int32_t estado) {
+    switch (estado) {
+        case EVENTO_RUNNING:  return "RUNNING";
+        case EVENTO_WAITING:  return "WAITING";
+        case EVENTO_ACCESSED: return "ACCESSED";
+        case EVENTO_OVERHEAD: return "OVERHEAD";
+        case EVENTO_IO:       return "IO";
+    }
+    return "?";
+}
+
+inline EstadoEvento estadoEvento(const std::string& estado) {
+    if (estado == "RUNNING") return EVENTO_RUNNING;
+    if (estado == "WAITING") return EVENTO_WAITING;
+    if (estado == "ACCESSED") return EVENTO_ACCESSED;
+    if (estado == "OVERHEAD") return EVENTO_OVERHEAD;
+    if (estado == "IO") return EVENTO_IO;
+    throw std::runtime_error("Estado de evento desconocido: " + estado);
+}
+
+// Tramo en formato fijo (40 bytes)
+struct RegistroEvento {
+    Tiempo inicio;
+    Tiempo fin;
+    Tiempo ejecutadoAntes;  // Solo RUNNING: ciclos en RUNNING del proceso antes de este tramo
+    int64_t anterior;       // Solo RUNNING: registro RUNNING anterior del proceso, o -1
+    int32_t proceso;        // Índice del pid (los de la carga primero, en su orden)
+    int32_t estado;         // EstadoEvento
+};
+
+// ------------------------------------------------------------
+// Almacén de eventos fuera de memoria
+// ------------------------------------------------------------
+// Guarda los tramos como registros fijos que solo se agregan al final de
+// un archivo temporal mapeado en memoria. El archivo se desvincula al
+// crearlo (desaparece al cerrarse) y sus páginas las puede devolver el
+// sistema al disco, así que el tamaño del diagrama queda limitado por el
+// disco y no por la RAM. En memoria solo hay índices pequeños:
+//   - por bloque de BLOQUE registros, el menor inicio y el mayor fin:
+//     recorrerEn(desde, hasta) lee solo los bloques que tocan el
+//     intervalo;
+//   - por proceso, uno de cada MUESTRA de sus tramos RUNNING: con los
+//     enlaces "anterior", ejecutadoEn(i, ciclo) cuesta O(log n + MUESTRA);
+//   - por proceso, el mayor fin de sus tramos.
+// Los registros quedan en el orden de emisión, que no es el de inicio
+// (una E/S se publica al volver). Solo se supone que los tramos RUNNING
+// de un proceso no se superponen y se emiten en orden, como en todos los
+// simuladores.
+class AlmacenEventos {
+public:
+    static const size_t BLOQUE = 1024;
+    static const size_t MUESTRA = 64;
+
+    // El archivo se crea en "directorio" (vacío: $TMPDIR o /tmp). Los pid
+    // de la carga reciben los índices 0..n-1
+    explicit AlmacenEventos(const std::vector<Proceso>& carga, const std::string& directorio = "")
+        : fd(-1), datos(nullptr), capacidad(0), numRegistros(0), maxFin(0), registrosSufijo(0) {
+        std::string dir = directorio;
+        if (dir.empty()) {
+            const char* tmp = std::getenv("TMPDIR");
+            dir = tmp && *tmp ? tmp : "/tmp";
+        }
+        std::string ruta = dir + "/eventos-XXXXXX";
+        std::vector<char> plantilla(ruta.begin(), ruta.end());
+        plantilla.push_back('\0');
+        fd = ::mkstemp(plantilla.data());
+        if (fd < 0) {
+            throw std::runtime_error("No se pudo crear el almacén de eventos en " + dir + ": " +
+                                     std::strerror(errno));
+        }
+        ::unlink(plantilla.data());
+
+        for (const auto& p : carga) {
+            indiceDe(p.pid);
+        }
+        try {
+            crecer(CAPACIDAD_INICIAL);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+    }
+
+    ~AlmacenEventos() {
+        if (datos) ::munmap(datos, capacidad * sizeof(RegistroEvento));
+        if (fd >= 0) ::close(fd);
+    }
+
+    AlmacenEventos(const AlmacenEventos&) = delete;
+    AlmacenEventos& operator=(const AlmacenEventos&) = delete;
+
+    void agregar(const EventoGantt& e) {
+        agregar(indiceDe(e.pid), estadoEvento(e.estado), e.inicio, e.fin);
+    }
+
+    // Igual, con el índice del pid ya conocido (el de la carga); los
+    // simuladores lo tienen y así se evita buscar el pid en cada evento
+    void agregar(const EventoGantt& e, int32_t proceso) {
+        agregar(proceso, estadoEvento(e.estado), e.inicio, e.fin);
+    }
+
+    // Copiar los primeros n registros de otro almacén (al reanudar una
+    // corrida desde un punto de control)
+    void agregarPrefijo(const AlmacenEventos& otro, size_t n) {
+        n = std::min(n, otro.numRegistros);
+        for (size_t k = 0; k < n; ++k) {
+            const RegistroEvento& r = otro.datos[k];
+            agregar(indiceDe(otro.pids[r.proceso]), r.estado, r.inicio, r.fin);
+        }
+    }
+
+    size_t tamano() const { return numRegistros; }
+
+    const RegistroEvento& registro(size_t k) const { return datos[k]; }
+
+    EventoGantt evento(size_t k) const {
+        const RegistroEvento& r = datos[k];
+        return EventoGantt(pids[r.proceso], r.inicio, r.fin, nombreEstadoEvento(r.estado));
+    }
+
+    const std::string& pid(int32_t proceso) const { return pids[proceso]; }
+
+    // Mayor fin de todos los tramos (0 si no hay)
+    Tiempo getMaxFin() const { return maxFin; }
+
+    // Mayor fin de los tramos del proceso i, o TIEMPO_MAXIMO si no tiene
+    Tiempo finDe(size_t i) const {
+        if (i >= porProceso.size() || porProceso[i].fin == LLONG_MIN) return TIEMPO_MAXIMO;
+        return porProceso[i].fin;
+    }
+
+    // Todos los registros, en orden de emisión
+    template <class F>
+    void recorrer(F f) const {
+        for (size_t k = 0; k < numRegistros; ++k) {
+            f(datos[k]);
+        }
+    }
+
+    // Los registros que se superponen a [desde, hasta), en orden de emisión
+    template <class F>
+    void recorrerEn(Tiempo desde, Tiempo hasta, F f) const {
+        prepararSufijo();
+        size_t b = std::upper_bound(finAcumulado.begin(), finAcumulado.end(), desde) - finAcumulado.begin();
+        for (; b < bloques.size() && inicioSufijo[b] < hasta; ++b) {
+            if (bloques[b].minInicio >= hasta || bloques[b].maxFin <= desde) continue;
+            size_t ultimo = std::min(numRegistros, (b + 1) * BLOQUE);
+            for (size_t k = b * BLOQUE; k < ultimo; ++k) {
+                const RegistroEvento& r = datos[k];
+                if (r.inicio < hasta && r.fin > desde) f(r);
+            }
+        }
+    }
+
+    // Ciclos en RUNNING del proceso i antes del ciclo "ciclo": desde la
+    // primera muestra posterior se retrocede hasta el último tramo que
+    // empieza en "ciclo" o antes
+    Tiempo ejecutadoEn(size_t i, Tiempo ciclo) const {
+        if (i >= porProceso.size()) return 0;
+        const DatosProceso& d = porProceso[i];
+        auto it = std::upper_bound(d.muestras.begin(), d.muestras.end(), ciclo,
+            [](Tiempo c, const Muestra& m) { return c < m.inicio; });
+        int64_t k = it == d.muestras.end() ? d.ultimoRunning : datos[it->registro].anterior;
+        while (k >= 0 && datos[k].inicio > ciclo) {
+            k = datos[k].anterior;
+        }
+        if (k < 0) return 0;
+        const RegistroEvento& r = datos[k];
+        return r.ejecutadoAntes + std::min(ciclo, r.fin) - r.inicio;
+    }
+
+    // Reenviar todos los tramos a un receptor (p. ej. un exportador)
+    void reenviar(ReceptorEventos& receptor) const {
+        for (size_t k = 0; k < numRegistros; ++k) {
+            receptor.alEvento(evento(k));
+        }
+    }
+
+private:
+    static const size_t CAPACIDAD_INICIAL = 4096;
+
+    struct Bloque {
+        Tiempo minInicio;
+        Tiempo maxFin;
+    };
+
+    struct Muestra {
+        Tiempo inicio;
+        int64_t registro;
+    };
+
+    struct DatosProceso {
+        Tiempo ejecutado = 0;
+        Tiempo fin = LLONG_MIN;
+        int64_t ultimoRunning = -1;
+        size_t numRunning = 0;
+        std::vector<Muestra> muestras;
+    };
+
+    int fd;
+    RegistroEvento* datos;
+    size_t capacidad;
+    size_t numRegistros;
+    Tiempo maxFin;
+
+    std::vector<std::string> pids;
+    std::unordered_map<std::string, int32_t> indice;
+    std::vector<DatosProceso> porProceso;
+
+    // Índice de tiempo: un Bloque por cada BLOQUE registros y el máximo
+    // acumulado de su fin (monótono: da el primer bloque que puede tocar
+    // un ciclo). El mínimo de los inicios desde cada bloque hasta el final
+    // (para saber dónde parar) se rehace al consultar si hubo agregados.
+    std::vector<Bloque> bloques;
+    std::vector<Tiempo> finAcumulado;
+    mutable std::vector<Tiempo> inicioSufijo;
+    mutable size_t registrosSufijo;
+
+    int32_t indiceDe(const std::string& pid) {
+        auto it = indice.find(pid);
+        if (it != indice.end()) return it->second;
+        int32_t i = static_cast<int32_t>(pids.size());
+        indice.emplace(pid, i);
+        pids.push_back(pid);
+        porProceso.emplace_back();
+        return i;
+    }
+
+    void agregar(int32_t proceso, int32_t estado, Tiempo inicio, Tiempo fin) {
+        if (numRegistros == capacidad) crecer(capacidad * 2);
+        RegistroEvento& r = datos[numRegistros];
+        r.inicio = inicio;
+        r.fin = fin;
+        r.ejecutadoAntes = 0;
+        r.anterior = -1;
+        r.proceso = proceso;
+        r.estado = estado;
+
+        DatosProceso& d = porProceso[proceso];
+        if (estado == EVENTO_RUNNING) {
+            r.ejecutadoAntes = d.ejecutado;
+            r.anterior = d.ultimoRunning;
+            if (d.numRunning % MUESTRA == 0) {
+                d.muestras.push_back({inicio, static_cast<int64_t>(numRegistros)});
+            }
+            d.numRunning++;
+            d.ejecutado += fin - inicio;
+            d.ultimoRunning = static_cast<int64_t>(numRegistros);
+        }
+        d.fin = std::max(d.fin, fin);
+
+        if (numRegistros % BLOQUE == 0) {
+            bloques.push_back({inicio, fin});
+            finAcumulado.push_back(finAcumulado.empty() ? fin : std::max(finAcumulado.back(), fin));
+        } else {
+            Bloque& b = bloques.back();
+            b.minInicio = std::min(b.minInicio, inicio);
+            b.maxFin = std::max(b.maxFin, fin);
+            finAcumulado.back() = std::max(finAcumulado.back(), fin);
+        }
+        maxFin = std::max(maxFin, fin);
+        numRegistros++;
+    }
+
+    void prepararSufijo() const {
+        if (registrosSufijo == numRegistros && inicioSufijo.size() == bloques.size()) return;
+        inicioSufijo.resize(bloques.size());
+        Tiempo minimo = TIEMPO_MAXIMO;
+        for (size_t b = bloques.size(); b-- > 0;) {
+            minimo = std::min(minimo, bloques[b].minInicio);
+            inicioSufijo[b] = minimo;
+        }
+        registrosSufijo = numRegistros;
+    }
+
+    // Agrandar el archivo y volver a mapearlo completo
+    void crecer(size_t nueva) {
+        size_t bytes = nueva * sizeof(RegistroEvento);
+        if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error(std::string("No se pudo agrandar el almacén de eventos: ") +
+                                     std::strerror(errno));
+        }
+        void* mapa = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapa == MAP_FAILED) {
+            throw std::runtime_error(std::string("No se pudo mapear el almacén de eventos: ") +
+                                     std::strerror(errno));
+        }
+        if (datos) ::munmap(datos, capacidad * sizeof(RegistroEvento));
+        datos = static_cast<RegistroEvento*>(mapa);
+        capacidad = nueva;
+    }
+};
+
+#endif
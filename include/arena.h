@@ -0,0 +1,94 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// ------------------------------------------------------------
+// Arena de memoria por corrida
+// ------------------------------------------------------------
+// Asignador monótono para los contenedores que solo viven durante una
+// ejecución (colas de listos, listas de pendientes, estado de
+// sincronización). Liberar no hace nada; al iniciar la siguiente corrida
+// se llama a reiniciar(), que rebobina la arena sin devolver los bloques
+// al sistema. Después de la primera corrida, las siguientes de tamaño
+// similar no piden memoria al heap.
+//
+// Solo debe respaldar contenedores de elementos triviales (vectores,
+// colas circulares); un contenedor vivo no puede recorrer sus nodos
+// después de un reinicio. Tampoco sirve para contenedores que liberan y
+// vuelven a pedir memoria durante la corrida (std::deque, std::set): la
+// arena crecería con cada operación y no con su tamaño.
+class ArenaSimulacion : public std::pmr::memory_resource {
+public:
+    explicit ArenaSimulacion(size_t bloqueInicial = 64 * 1024)
+        : tamanoBloqueInicial(bloqueInicial), actual(0), usado(0) {}
+
+    ~ArenaSimulacion() override {
+        for (auto& b : bloques) {
+            ::operator delete(b.datos);
+        }
+    }
+
+    ArenaSimulacion(const ArenaSimulacion&) = delete;
+    ArenaSimulacion& operator=(const ArenaSimulacion&) = delete;
+
+    // Rebobinar: toda la memoria entregada queda disponible de nuevo
+    void reiniciar() {
+        actual = 0;
+        usado = 0;
+    }
+
+    // Bytes reservados al sistema (no cambia al reiniciar)
+    size_t capacidad() const {
+        size_t total = 0;
+        for (const auto& b : bloques) total += b.tamano;
+        return total;
+    }
+
+private:
+    struct Bloque {
+        char* datos;
+        size_t tamano;
+    };
+
+    std::vector<Bloque> bloques;
+    size_t tamanoBloqueInicial;
+    size_t actual; // Bloque en uso
+    size_t usado;  // Bytes ocupados del bloque en uso
+
+    void* do_allocate(size_t bytes, size_t alineacion) override {
+        // Buscar espacio en el bloque actual o en los ya reservados
+        while (actual < bloques.size()) {
+            Bloque& b = bloques[actual];
+            uintptr_t base = reinterpret_cast<uintptr_t>(b.datos);
+            uintptr_t inicio = (base + usado + alineacion - 1) & ~(uintptr_t)(alineacion - 1);
+            size_t fin = static_cast<size_t>(inicio - base) + bytes;
+            if (fin <= b.tamano) {
+                usado = fin;
+                return reinterpret_cast<void*>(inicio);
+            }
+            actual++;
+            usado = 0;
+        }
+
+        // Reservar un bloque nuevo, el doble del anterior
+        size_t tamano = bloques.empty() ? tamanoBloqueInicial : bloques.back().tamano * 2;
+        while (tamano < bytes + alineacion) tamano *= 2;
+        bloques.push_back({static_cast<char*>(::operator new(tamano)), tamano});
+        actual = bloques.size() - 1;
+        usado = 0;
+        return do_allocate(bytes, alineacion);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& otra) const noexcept override {
+        return this == &otra;
+    }
+};
+
+#endif
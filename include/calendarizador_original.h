@@ -0,0 +1,442 @@
+#ifndef CALENDARIZADOR_ORIGINAL_H
+#define CALENDARIZADOR_ORIGINAL_H
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include "estructuras.h"
+#include "metricas.h"
+#include "politicas.h"
+#include "simulador_calendarizacion.h"
+
+// ------------------------------------------------------------
+// Calendarizador original
+// ------------------------------------------------------------
+// Los cinco algoritmos de la primera versión de SimuladorCalendarizacion,
+// copiados tal cual: solo cambian los tipos (Tiempo en lugar de int). Es
+// el segundo oráculo de src/comparador.cpp. CalendarizadorReferencia
+// sigue las reglas actuales de los motores; este conserva las originales,
+// así que la comparación con él muestra cuándo un motor se aparta del
+// comportamiento de partida.
+//
+// Solo admite cargas sin E/S y con ráfagas de al menos un ciclo (SRTF no
+// termina con una ráfaga de 0). Las diferencias que los motores tienen a
+// propósito se comprueban con casos fijos en el comparador:
+//  - Priority envejece a todos los listos a la vez, un paso por despacho
+//    cuando pasaron 5 ciclos desde el anterior; los motores cuentan los
+//    pasos de cada proceso desde que está listo.
+//  - Los empates quedan al criterio de std::sort; los motores los
+//    resuelven por llegada y orden de ingreso.
+//
+// Los tramos contiguos del mismo proceso se unen y las métricas se
+// devuelven en el orden de la carga (FIFO reordena los procesos), para
+// compararlos con los de los motores.
+class CalendarizadorOriginal {
+public:
+    CalendarizadorOriginal(const std::vector<Proceso>& cargaProcesos, Tiempo q)
+        : carga(cargaProcesos), tiempoActual(0), quantum(q) {}
+
+    ResultadoSimulacion ejecutar(TipoAlgoritmo tipo) {
+        procesos = carga;
+        eventos.clear();
+        tiempoActual = 0;
+
+        // Resetear valores de los procesos
+        for (auto& p : procesos) {
+            p.remainingTime = p.burstTime;
+            p.waitingTime = 0;
+            p.completionTime = 0;
+            p.startTime = -1;
+            p.responseTime = 0;
+            p.started = false;
+        }
+
+        switch (tipo) {
+            case FIFO:        ejecutarFIFO(); break;
+            case SJF:         ejecutarSJF(); break;
+            case SRTF:        ejecutarSRTF(); break;
+            case ROUND_ROBIN: ejecutarRoundRobin(); break;
+            case PRIORITY:    ejecutarPriority(); break;
+        }
+
+        ResultadoSimulacion r;
+        r.algoritmo = tipo;
+        for (const auto& e : eventos) {
+            if (!r.eventos.empty() && r.eventos.back().pid == e.pid && r.eventos.back().fin == e.inicio) {
+                r.eventos.back().fin = e.fin;
+            } else {
+                r.eventos.push_back(e);
+            }
+        }
+        std::unordered_map<std::string, const Proceso*> porPid;
+        for (const auto& p : procesos) porPid[p.pid] = &p;
+        for (const auto& original : carga) {
+            const Proceso& p = *porPid.at(original.pid);
+            r.espera.push_back(p.waitingTime);
+            r.respuesta.push_back(p.responseTime);
+            r.finalizacion.push_back(p.completionTime);
+            r.inicio.push_back(p.startTime);
+        }
+        r.resumenEspera = resumirColumna(r.espera);
+        r.resumenRespuesta = resumirColumna(r.respuesta);
+        r.resumenFinalizacion = resumirColumna(r.finalizacion);
+        r.avgWaitingTime = r.resumenEspera.media;
+        r.avgCompletionTime = r.resumenFinalizacion.media;
+        r.avgResponseTime = r.resumenRespuesta.media;
+        return r;
+    }
+
+private:
+    std::vector<Proceso> carga;
+    std::vector<Proceso> procesos;
+    std::vector<EventoGantt> eventos;
+    Tiempo tiempoActual;
+    Tiempo quantum;
+
+    // Implementación de FIFO (First In First Out)
+    void ejecutarFIFO() {
+        // Ordenar por tiempo de llegada
+        std::sort(procesos.begin(), procesos.end(), 
+            [](const Proceso& a, const Proceso& b) {
+                return a.arrivalTime < b.arrivalTime;
+            });
+        
+        tiempoActual = 0;
+        
+        for (auto& p : procesos) {
+            // Si el CPU está idle, avanzar al tiempo de llegada
+            if (tiempoActual < p.arrivalTime) {
+                tiempoActual = p.arrivalTime;
+            }
+            
+            // Marcar inicio
+            p.startTime = tiempoActual;
+            p.responseTime = p.startTime - p.arrivalTime;
+            p.waitingTime = tiempoActual - p.arrivalTime;
+            
+            // Ejecutar proceso completo
+            eventos.push_back(EventoGantt(p.pid, tiempoActual, 
+                                         tiempoActual + p.burstTime));
+            
+            tiempoActual += p.burstTime;
+            p.completionTime = tiempoActual;
+            p.remainingTime = 0;
+        }
+    }
+    
+    // Implementación de SJF (Shortest Job First)
+    void ejecutarSJF() {
+        std::vector<Proceso*> listos;
+        std::vector<Proceso*> pendientes;
+        
+        // Crear punteros a los procesos
+        for (auto& p : procesos) {
+            pendientes.push_back(&p);
+        }
+        
+        tiempoActual = 0;
+        
+        while (!pendientes.empty() || !listos.empty()) {
+            // Mover procesos que han llegado a la cola de listos
+            auto it = pendientes.begin();
+            while (it != pendientes.end()) {
+                if ((*it)->arrivalTime <= tiempoActual) {
+                    listos.push_back(*it);
+                    it = pendientes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            
+            if (listos.empty() && !pendientes.empty()) {
+                // CPU idle - avanzar al siguiente arrival
+                tiempoActual = (*std::min_element(pendientes.begin(), 
+                    pendientes.end(), [](Proceso* a, Proceso* b) {
+                        return a->arrivalTime < b->arrivalTime;
+                    }))->arrivalTime;
+                continue;
+            }
+            
+            // Ordenar por burst time (shortest first)
+            std::sort(listos.begin(), listos.end(), 
+                [](Proceso* a, Proceso* b) {
+                    return a->burstTime < b->burstTime;
+                });
+            
+            // Ejecutar el proceso más corto
+            if (!listos.empty()) {
+                Proceso* p = listos.front();
+                listos.erase(listos.begin());
+                
+                p->startTime = tiempoActual;
+                p->responseTime = p->startTime - p->arrivalTime;
+                p->waitingTime = tiempoActual - p->arrivalTime;
+                
+                eventos.push_back(EventoGantt(p->pid, tiempoActual, 
+                                             tiempoActual + p->burstTime));
+                
+                tiempoActual += p->burstTime;
+                p->completionTime = tiempoActual;
+                p->remainingTime = 0;
+            }
+        }
+    }
+    
+    // Implementación de SRTF (Shortest Remaining Time First)
+    void ejecutarSRTF() {
+        std::vector<Proceso*> pendientes;
+        std::vector<Proceso*> listos;
+        Proceso* procesoActual = nullptr;
+        
+        // Crear punteros a los procesos
+        for (auto& p : procesos) {
+            pendientes.push_back(&p);
+        }
+        
+        tiempoActual = 0;
+        
+        while (!pendientes.empty() || !listos.empty() || procesoActual) {
+            // Mover procesos que han llegado a la cola de listos
+            auto it = pendientes.begin();
+            while (it != pendientes.end()) {
+                if ((*it)->arrivalTime <= tiempoActual) {
+                    listos.push_back(*it);
+                    it = pendientes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            
+            // Si hay un proceso en ejecución, verificar si debe ser reemplazado
+            if (procesoActual && procesoActual->remainingTime > 0) {
+                // Buscar si hay un proceso con menor tiempo restante
+                Proceso* menorTiempo = procesoActual;
+                for (auto* p : listos) {
+                    if (p->remainingTime < menorTiempo->remainingTime) {
+                        menorTiempo = p;
+                    }
+                }
+                
+                // Si hay un proceso con menor tiempo, hacer cambio de contexto
+                if (menorTiempo != procesoActual) {
+                    listos.push_back(procesoActual);
+                    procesoActual = menorTiempo;
+                    listos.erase(std::find(listos.begin(), listos.end(), menorTiempo));
+                }
+            }
+            
+            // Si no hay proceso actual, seleccionar el de menor tiempo restante
+            if (!procesoActual && !listos.empty()) {
+                // Ordenar por tiempo restante
+                std::sort(listos.begin(), listos.end(), 
+                    [](Proceso* a, Proceso* b) {
+                        return a->remainingTime < b->remainingTime;
+                    });
+                
+                procesoActual = listos.front();
+                listos.erase(listos.begin());
+            }
+            
+            // Si hay un proceso para ejecutar
+            if (procesoActual) {
+                // Marcar inicio si es la primera vez
+                if (!procesoActual->started) {
+                    procesoActual->startTime = tiempoActual;
+                    procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
+                    procesoActual->started = true;
+                }
+                
+                // Ejecutar por 1 unidad de tiempo
+                Tiempo inicioEvento = tiempoActual;
+                procesoActual->remainingTime--;
+                tiempoActual++;
+                
+                // Registrar evento
+                eventos.push_back(EventoGantt(procesoActual->pid, inicioEvento, tiempoActual));
+                
+                // Si el proceso terminó
+                if (procesoActual->remainingTime == 0) {
+                    procesoActual->completionTime = tiempoActual;
+                    procesoActual->waitingTime = procesoActual->completionTime - 
+                                               procesoActual->arrivalTime - 
+                                               procesoActual->burstTime;
+                    procesoActual = nullptr;
+                }
+            } else if (!pendientes.empty()) {
+                // CPU idle - avanzar al siguiente arrival
+                tiempoActual = (*std::min_element(pendientes.begin(), 
+                    pendientes.end(), [](Proceso* a, Proceso* b) {
+                        return a->arrivalTime < b->arrivalTime;
+                    }))->arrivalTime;
+            }
+        }
+    }
+    
+    // Implementación de Round Robin
+    void ejecutarRoundRobin() {
+        std::queue<Proceso*> colaListos;
+        std::vector<Proceso*> pendientes;
+        Proceso* procesoActual = nullptr;
+        Tiempo tiempoQuantum = 0;
+        
+        // Crear punteros a los procesos
+        for (auto& p : procesos) {
+            pendientes.push_back(&p);
+        }
+        
+        // Ordenar pendientes por tiempo de llegada
+        std::sort(pendientes.begin(), pendientes.end(), 
+            [](Proceso* a, Proceso* b) {
+                return a->arrivalTime < b->arrivalTime;
+            });
+        
+        tiempoActual = 0;
+        
+        while (!pendientes.empty() || !colaListos.empty() || procesoActual) {
+            // Mover procesos que han llegado a la cola de listos
+            auto it = pendientes.begin();
+            while (it != pendientes.end()) {
+                if ((*it)->arrivalTime <= tiempoActual) {
+                    colaListos.push(*it);
+                    it = pendientes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            
+            // Si el proceso actual agotó su quantum o terminó
+            if (procesoActual && (tiempoQuantum >= quantum || procesoActual->remainingTime == 0)) {
+                if (procesoActual->remainingTime > 0) {
+                    // Volver a la cola si no ha terminado
+                    colaListos.push(procesoActual);
+                }
+                procesoActual = nullptr;
+                tiempoQuantum = 0;
+            }
+            
+            // Seleccionar siguiente proceso si no hay uno actual
+            if (!procesoActual && !colaListos.empty()) {
+                procesoActual = colaListos.front();
+                colaListos.pop();
+                tiempoQuantum = 0;
+                
+                // Marcar inicio si es la primera vez
+                if (!procesoActual->started) {
+                    procesoActual->startTime = tiempoActual;
+                    procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
+                    procesoActual->started = true;
+                }
+            }
+            
+            // Ejecutar proceso actual
+            if (procesoActual) {
+                Tiempo inicioEvento = tiempoActual;
+                Tiempo tiempoEjecucion = std::min(quantum - tiempoQuantum, 
+                                              procesoActual->remainingTime);
+                
+                procesoActual->remainingTime -= tiempoEjecucion;
+                tiempoActual += tiempoEjecucion;
+                tiempoQuantum += tiempoEjecucion;
+                
+                // Registrar evento
+                eventos.push_back(EventoGantt(procesoActual->pid, inicioEvento, tiempoActual));
+                
+                // Si el proceso terminó
+                if (procesoActual->remainingTime == 0) {
+                    procesoActual->completionTime = tiempoActual;
+                    procesoActual->waitingTime = procesoActual->completionTime - 
+                                               procesoActual->arrivalTime - 
+                                               procesoActual->burstTime;
+                }
+            } else if (!pendientes.empty()) {
+                // CPU idle - avanzar al siguiente arrival
+                tiempoActual = pendientes.front()->arrivalTime;
+            }
+        }
+    }
+    
+    // Implementación de Priority con envejecimiento
+    void ejecutarPriority() {
+        std::vector<Proceso*> pendientes;
+        std::vector<Proceso*> listos;
+        
+        // Crear punteros a los procesos y agregar edad inicial
+        for (auto& p : procesos) {
+            pendientes.push_back(&p);
+        }
+        
+        tiempoActual = 0;
+        Tiempo tiempoUltimaActualizacion = 0;
+        
+        while (!pendientes.empty() || !listos.empty()) {
+            // Mover procesos que han llegado a la cola de listos
+            auto it = pendientes.begin();
+            while (it != pendientes.end()) {
+                if ((*it)->arrivalTime <= tiempoActual) {
+                    listos.push_back(*it);
+                    it = pendientes.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            
+            // Aplicar envejecimiento cada 5 unidades de tiempo
+            if (tiempoActual - tiempoUltimaActualizacion >= 5) {
+                for (auto* p : listos) {
+                    if (p->priority > 1) {
+                        p->priority--;  // Mejorar prioridad (1 es la más alta)
+                    }
+                }
+                tiempoUltimaActualizacion = tiempoActual;
+            }
+            
+            if (listos.empty() && !pendientes.empty()) {
+                // CPU idle - avanzar al siguiente arrival
+                tiempoActual = (*std::min_element(pendientes.begin(), 
+                    pendientes.end(), [](Proceso* a, Proceso* b) {
+                        return a->arrivalTime < b->arrivalTime;
+                    }))->arrivalTime;
+                continue;
+            }
+            
+            // Ordenar por prioridad (1 = más alta prioridad)
+            // En caso de empate, usar FIFO (arrival time)
+            std::sort(listos.begin(), listos.end(), 
+                [](Proceso* a, Proceso* b) {
+                    if (a->priority == b->priority) {
+                        return a->arrivalTime < b->arrivalTime;
+                    }
+                    return a->priority < b->priority;
+                });
+            
+            // Ejecutar el proceso de mayor prioridad
+            if (!listos.empty()) {
+                Proceso* p = listos.front();
+                listos.erase(listos.begin());
+                
+                p->startTime = tiempoActual;
+                p->responseTime = p->startTime - p->arrivalTime;
+                p->waitingTime = tiempoActual - p->arrivalTime;
+                
+                eventos.push_back(EventoGantt(p->pid, tiempoActual, 
+                                             tiempoActual + p->burstTime));
+                
+                tiempoActual += p->burstTime;
+                p->completionTime = tiempoActual;
+                p->remainingTime = 0;
+                
+                // Restaurar prioridad original para futuras simulaciones
+                for (auto& proc : procesos) {
+                    if (proc.pid == p->pid) {
+                        p->priority = proc.priority;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,408 @@
+#ifndef CALENDARIZADOR_REFERENCIA_H
+#define CALENDARIZADOR_REFERENCIA_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include "estructuras.h"
+#include "metricas.h"
+#include "politicas.h"
+#include "simulador_calendarizacion.h"
+
+// ------------------------------------------------------------
+// Calendarizador de referencia
+// ------------------------------------------------------------
+// Implementación lenta y directa de los cinco algoritmos, en el estilo de
+// las primeras versiones del simulador: avanza de a un ciclo, mantiene los
+// listos en un vector y en cada decisión los recorre completos. No tiene
+// colas de prioridad, tramos largos, envejecimiento perezoso ni puntos de
+// control, así que sirve de oráculo para comprobar que los motores
+// optimizados (SimuladorCalendarizacion, SimuladorEnLinea) producen el
+// mismo calendario; ver src/comparador.cpp. Sigue las reglas actuales de
+// los motores (abajo); las originales se conservan en
+// calendarizador_original.h.
+//
+// Reglas que deben coincidir con los motores:
+//  - Los procesos que llegan a la vez se admiten en el orden de la carga.
+//  - Los empates se resuelven por llegada y después por orden de ingreso
+//    a la cola de listos (un proceso expropiado vuelve a ingresar).
+//  - SRTF solo expropia si otro proceso tiene tiempo restante
+//    estrictamente menor.
+//  - Round Robin devuelve el proceso al final de la cola, detrás de los
+//    que llegaron mientras usaba su quantum.
+//  - Priority no es expropiativo; la prioridad efectiva en el tiempo t es
+//    max(1, priority - (t - listo) / INTERVALO_ENVEJECIMIENTO), en pasos
+//    enteros y con "listo" la llegada o el regreso de E/S. Una prioridad
+//    inicial de 1 o menos no envejece.
+//  - SJF y SRTF miran la ráfaga de CPU en curso, no el total.
+//  - Al terminar una ráfaga de CPU el proceso pide su dispositivo; si no
+//    hay servidor libre espera en la cola FIFO del dispositivo. Los que
+//    vuelven de E/S ingresan a la cola de listos después de las llegadas
+//    del mismo instante, por fin de servicio y en el orden de la carga.
+//  - Los tramos contiguos del mismo proceso forman un solo evento; los
+//    de E/S ("IO") van al final, desde la solicitud hasta el fin.
+class CalendarizadorReferencia {
+public:
+    CalendarizadorReferencia(const std::vector<Proceso>& carga, Tiempo q,
+                             const std::vector<Dispositivo>& declarados = std::vector<Dispositivo>())
+        : procesos(carga), dispositivos(declarados), quantum(q), tiempoActual(0), ingresos(0) {
+        if (quantum <= 0) {
+            throw std::runtime_error("El quantum debe ser positivo");
+        }
+        for (const auto& p : procesos) {
+            for (const auto& r : p.rafagasES) {
+                if (buscarDispositivo(r.dispositivo) >= 0) continue;
+                if (!declarados.empty()) {
+                    throw std::runtime_error("Dispositivo desconocido en " + p.pid + ": " + r.dispositivo);
+                }
+                dispositivos.push_back(Dispositivo(r.dispositivo));
+            }
+        }
+    }
+
+    ResultadoSimulacion ejecutar(TipoAlgoritmo tipo) {
+        reiniciar();
+        switch (tipo) {
+            case FIFO:        ejecutarFIFO(); break;
+            case SJF:         ejecutarSJF(); break;
+            case SRTF:        ejecutarSRTF(); break;
+            case ROUND_ROBIN: ejecutarRoundRobin(); break;
+            case PRIORITY:    ejecutarPriority(); break;
+        }
+
+        ResultadoSimulacion r;
+        r.algoritmo = tipo;
+        r.eventos = eventos;
+        r.eventos.insert(r.eventos.end(), eventosES.begin(), eventosES.end());
+        for (const auto& p : procesos) {
+            r.espera.push_back(p.waitingTime);
+            r.respuesta.push_back(p.responseTime);
+            r.finalizacion.push_back(p.completionTime);
+            r.inicio.push_back(p.startTime);
+        }
+        r.resumenEspera = resumirColumna(r.espera);
+        r.resumenRespuesta = resumirColumna(r.respuesta);
+        r.resumenFinalizacion = resumirColumna(r.finalizacion);
+        r.avgWaitingTime = r.resumenEspera.media;
+        r.avgCompletionTime = r.resumenFinalizacion.media;
+        r.avgResponseTime = r.resumenRespuesta.media;
+        return r;
+    }
+
+private:
+    // Solicitud de E/S en cola o en servicio
+    struct Solicitud {
+        Proceso* proceso;
+        Tiempo solicitud;
+        Tiempo fin;       // Solo en servicio
+    };
+
+    std::vector<Proceso> procesos;
+    std::vector<Dispositivo> dispositivos;
+    std::vector<EventoGantt> eventos;
+    std::vector<EventoGantt> eventosES;
+    Tiempo quantum;
+    Tiempo tiempoActual;
+
+    // Procesos que aún no llegan, en orden de llegada y de carga
+    std::vector<Proceso*> pendientes;
+    std::vector<Proceso*> listos;
+
+    // Orden de ingreso a la cola de listos de cada proceso (por índice) y
+    // desde cuándo está listo
+    std::vector<long long> ingreso;
+    std::vector<Tiempo> listoDesde;
+    long long ingresos;
+
+    // Cola y solicitudes en servicio de cada dispositivo
+    std::vector<std::vector<Solicitud>> colas;
+    std::vector<std::vector<Solicitud>> enServicio;
+
+    void reiniciar() {
+        eventos.clear();
+        eventosES.clear();
+        tiempoActual = 0;
+        ingresos = 0;
+        ingreso.assign(procesos.size(), 0);
+        listoDesde.assign(procesos.size(), 0);
+        colas.assign(dispositivos.size(), std::vector<Solicitud>());
+        enServicio.assign(dispositivos.size(), std::vector<Solicitud>());
+        listos.clear();
+        pendientes.clear();
+        for (auto& p : procesos) {
+            p.remainingTime = p.duracionRafaga(0);
+            p.rafaga = 0;
+            p.tiempoES = 0;
+            p.waitingTime = 0;
+            p.completionTime = 0;
+            p.startTime = -1;
+            p.responseTime = 0;
+            p.started = false;
+            pendientes.push_back(&p);
+        }
+        std::stable_sort(pendientes.begin(), pendientes.end(),
+            [](Proceso* a, Proceso* b) { return a->arrivalTime < b->arrivalTime; });
+    }
+
+    // Mover procesos que han llegado a la cola de listos, y después los
+    // que terminaron su E/S
+    void admitir() {
+        auto it = pendientes.begin();
+        while (it != pendientes.end() && (*it)->arrivalTime <= tiempoActual) {
+            encolar(*it);
+            ++it;
+        }
+        pendientes.erase(pendientes.begin(), it);
+
+        while (true) {
+            // La solicitud en servicio que termina primero
+            int d = -1;
+            size_t k = 0;
+            for (size_t j = 0; j < enServicio.size(); ++j) {
+                for (size_t m = 0; m < enServicio[j].size(); ++m) {
+                    const Solicitud& s = enServicio[j][m];
+                    if (s.fin > tiempoActual) continue;
+                    if (d < 0 || s.fin < enServicio[d][k].fin ||
+                        (s.fin == enServicio[d][k].fin && s.proceso < enServicio[d][k].proceso)) {
+                        d = static_cast<int>(j);
+                        k = m;
+                    }
+                }
+            }
+            if (d < 0) break;
+
+            Solicitud s = enServicio[d][k];
+            enServicio[d].erase(enServicio[d].begin() + static_cast<std::ptrdiff_t>(k));
+            if (!colas[d].empty()) {
+                Solicitud siguiente = colas[d].front();
+                colas[d].erase(colas[d].begin());
+                atender(d, siguiente, s.fin);
+            }
+
+            Proceso* p = s.proceso;
+            p->tiempoES += s.fin - s.solicitud;
+            p->rafaga++;
+            p->remainingTime = p->duracionRafaga(p->rafaga);
+            eventosES.push_back(EventoGantt(p->pid, s.solicitud, s.fin, "IO"));
+            encolar(p);
+        }
+    }
+
+    void encolar(Proceso* p) {
+        ingreso[p - procesos.data()] = ingresos++;
+        listoDesde[p - procesos.data()] = tiempoActual;
+        listos.push_back(p);
+    }
+
+    int buscarDispositivo(const std::string& nombre) const {
+        for (size_t d = 0; d < dispositivos.size(); ++d) {
+            if (dispositivos[d].nombre == nombre) return static_cast<int>(d);
+        }
+        return -1;
+    }
+
+    void atender(int d, Solicitud s, Tiempo t) {
+        s.fin = t + dispositivos[d].latencia + s.proceso->rafagasES[s.proceso->rafaga].duracion;
+        enServicio[d].push_back(s);
+    }
+
+    // El proceso terminó una ráfaga de CPU que no es la última
+    void solicitarES(Proceso* p) {
+        int d = buscarDispositivo(p->rafagasES[p->rafaga].dispositivo);
+        Solicitud s{p, tiempoActual, 0};
+        if (static_cast<int>(enServicio[d].size()) < dispositivos[d].servidores) {
+            atender(d, s, tiempoActual);
+        } else {
+            colas[d].push_back(s);
+        }
+    }
+
+    bool hayES() const {
+        for (const auto& s : enServicio) {
+            if (!s.empty()) return true;
+        }
+        return false;
+    }
+
+    // Si queda algo por simular
+    bool quedaTrabajo(const Proceso* procesoActual) const {
+        return !pendientes.empty() || !listos.empty() || procesoActual || hayES();
+    }
+
+    // Desempate común: llegada y después orden de ingreso
+    bool antes(const Proceso* a, const Proceso* b) const {
+        if (a->arrivalTime != b->arrivalTime) return a->arrivalTime < b->arrivalTime;
+        return ingreso[a - procesos.data()] < ingreso[b - procesos.data()];
+    }
+
+    // Sacar de la cola el primer proceso según "menor"
+    template <class Menor>
+    Proceso* extraer(Menor menor) {
+        auto it = std::min_element(listos.begin(), listos.end(), menor);
+        Proceso* p = *it;
+        listos.erase(it);
+        if (!p->started) {
+            p->startTime = tiempoActual;
+            p->responseTime = p->startTime - p->arrivalTime;
+            p->started = true;
+        }
+        return p;
+    }
+
+    // Ejecutar una unidad de tiempo (ninguna si ya no le queda). Devuelve
+    // true si el proceso dejó la CPU por terminar o por pasar a E/S.
+    bool ejecutarUnidad(Proceso* p) {
+        Tiempo inicio = tiempoActual;
+        if (p->remainingTime > 0) {
+            p->remainingTime--;
+            tiempoActual++;
+        }
+
+        if (!eventos.empty() && eventos.back().fin == inicio && eventos.back().pid == p->pid) {
+            eventos.back().fin = tiempoActual;
+        } else {
+            eventos.push_back(EventoGantt(p->pid, inicio, tiempoActual));
+        }
+
+        if (p->remainingTime == 0 && p->rafaga + 1 < p->numRafagas()) {
+            solicitarES(p);
+            return true;
+        }
+        if (p->remainingTime == 0) {
+            p->completionTime = tiempoActual;
+            p->waitingTime = p->completionTime - p->arrivalTime - p->burstTime - p->tiempoES;
+            return true;
+        }
+        return false;
+    }
+
+    // CPU idle - avanzar al siguiente arrival o fin de E/S
+    void avanzarOcioso() {
+        Tiempo proximo = pendientes.empty() ? TIEMPO_MAXIMO : pendientes.front()->arrivalTime;
+        for (const auto& servicio : enServicio) {
+            for (const auto& s : servicio) proximo = std::min(proximo, s.fin);
+        }
+        tiempoActual = proximo;
+    }
+
+    void ejecutarFIFO() {
+        Proceso* procesoActual = nullptr;
+        while (quedaTrabajo(procesoActual)) {
+            admitir();
+            if (!procesoActual && !listos.empty()) {
+                procesoActual = extraer([this](Proceso* a, Proceso* b) {
+                    return ingreso[a - procesos.data()] < ingreso[b - procesos.data()];
+                });
+            }
+            if (procesoActual) {
+                if (ejecutarUnidad(procesoActual)) procesoActual = nullptr;
+            } else {
+                avanzarOcioso();
+            }
+        }
+    }
+
+    void ejecutarSJF() {
+        Proceso* procesoActual = nullptr;
+        while (quedaTrabajo(procesoActual)) {
+            admitir();
+            if (!procesoActual && !listos.empty()) {
+                procesoActual = extraer([this](Proceso* a, Proceso* b) {
+                    if (a->remainingTime != b->remainingTime) return a->remainingTime < b->remainingTime;
+                    return antes(a, b);
+                });
+            }
+            if (procesoActual) {
+                if (ejecutarUnidad(procesoActual)) procesoActual = nullptr;
+            } else {
+                avanzarOcioso();
+            }
+        }
+    }
+
+    void ejecutarSRTF() {
+        Proceso* procesoActual = nullptr;
+        while (quedaTrabajo(procesoActual)) {
+            admitir();
+
+            // Expropiar si hay un proceso con tiempo restante menor
+            if (procesoActual) {
+                for (Proceso* p : listos) {
+                    if (p->remainingTime < procesoActual->remainingTime) {
+                        encolar(procesoActual);
+                        procesoActual = nullptr;
+                        break;
+                    }
+                }
+            }
+
+            if (!procesoActual && !listos.empty()) {
+                procesoActual = extraer([this](Proceso* a, Proceso* b) {
+                    if (a->remainingTime != b->remainingTime) return a->remainingTime < b->remainingTime;
+                    return antes(a, b);
+                });
+            }
+            if (procesoActual) {
+                if (ejecutarUnidad(procesoActual)) procesoActual = nullptr;
+            } else {
+                avanzarOcioso();
+            }
+        }
+    }
+
+    void ejecutarRoundRobin() {
+        Proceso* procesoActual = nullptr;
+        Tiempo tiempoQuantum = 0;
+        while (quedaTrabajo(procesoActual)) {
+            admitir();
+
+            // Quantum agotado: al final de la cola
+            if (procesoActual && tiempoQuantum == quantum) {
+                encolar(procesoActual);
+                procesoActual = nullptr;
+            }
+
+            if (!procesoActual && !listos.empty()) {
+                procesoActual = extraer([this](Proceso* a, Proceso* b) {
+                    return ingreso[a - procesos.data()] < ingreso[b - procesos.data()];
+                });
+                tiempoQuantum = 0;
+            }
+            if (procesoActual) {
+                tiempoQuantum++;
+                if (ejecutarUnidad(procesoActual)) procesoActual = nullptr;
+            } else {
+                avanzarOcioso();
+            }
+        }
+    }
+
+    void ejecutarPriority() {
+        const Tiempo intervalo = PoliticaPriority::INTERVALO_ENVEJECIMIENTO;
+        Proceso* procesoActual = nullptr;
+        while (quedaTrabajo(procesoActual)) {
+            admitir();
+            if (!procesoActual && !listos.empty()) {
+                auto efectiva = [this, intervalo](const Proceso* p) -> Tiempo {
+                    if (p->priority <= 1) return p->priority;
+                    Tiempo pasos = (tiempoActual - listoDesde[p - procesos.data()]) / intervalo;
+                    return std::max<Tiempo>(1, p->priority - pasos);
+                };
+                procesoActual = extraer([this, &efectiva](Proceso* a, Proceso* b) {
+                    Tiempo ea = efectiva(a);
+                    Tiempo eb = efectiva(b);
+                    if (ea != eb) return ea < eb;
+                    return antes(a, b);
+                });
+            }
+            if (procesoActual) {
+                if (ejecutarUnidad(procesoActual)) procesoActual = nullptr;
+            } else {
+                avanzarOcioso();
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef CLIENTE_EVENTOS_H
+#define CLIENTE_EVENTOS_H
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "estructuras.h"
+#include "protocolo_eventos.h"
+#include "simulador_calendarizacion.h"
+
+// Extremo de la interfaz gráfica del protocolo de protocolo_eventos.h.
+// recibir() no bloquea: lee lo disponible, procesa como máximo los
+// mensajes indicados y devuelve los créditos correspondientes, así que
+// el servidor nunca adelanta más de CREDITOS_INICIALES mensajes a lo que
+// la interfaz alcanzó a procesar.
+class ClienteEventos {
+public:
+    ClienteEventos() : fd(-1), pendientesDeCredito(0), finalizado(false), mensajes(0), cambios(false) {}
+
+    ~ClienteEventos() { desconectar(); }
+
+    ClienteEventos(const ClienteEventos&) = delete;
+    ClienteEventos& operator=(const ClienteEventos&) = delete;
+
+    void conectar(const std::string& ruta) {
+        desconectar();
+        sockaddr_un direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sun_family = AF_UNIX;
+        if (ruta.size() >= sizeof(direccion.sun_path)) {
+            throw std::runtime_error("Ruta de socket demasiado larga: " + ruta);
+        }
+        std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+            std::string error = std::strerror(errno);
+            desconectar();
+            throw std::runtime_error("No se pudo conectar a " + ruta + ": " + error);
+        }
+
+        grupos.clear();
+        procesos.clear();
+        indiceProceso.clear();
+        entrada.clear();
+        inicioEntrada = 0;
+        pendientesDeCredito = 0;
+        finalizado = false;
+        mensajes = 0;
+        cambios = true;
+        enviarCredito(CREDITOS_INICIALES);
+    }
+
+    void desconectar() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    bool conectado() const { return fd >= 0; }
+
+    // Mensajes recibidos que aún no se procesan (quedan aunque el
+    // servidor haya cerrado la conexión)
+    bool quedanMensajes() const { return mensajeCompleto(entrada, inicioEntrada) > 0; }
+
+    // El servidor envió FIN: ya no llegarán más datos
+    bool terminado() const { return finalizado; }
+
+    long long getMensajes() const { return mensajes; }
+
+    // Pedir solo los eventos que toquen [desde, hasta). Aplica a los
+    // eventos que el servidor produzca desde ahora; no reenvía los pasados.
+    void suscribir(Tiempo desde, Tiempo hasta) {
+        std::vector<char> buffer;
+        EscritorMensajes m(buffer);
+        m.iniciar(MENSAJE_VENTANA);
+        m.entero(desde);
+        m.entero(hasta);
+        m.terminar();
+        enviar(buffer);
+    }
+
+    // Leer sin bloquear y procesar hasta "maximo" mensajes. Devuelve
+    // true si llegó algo nuevo.
+    bool recibir(size_t maximo) {
+        char bloque[64 * 1024];
+        while (fd >= 0) {
+            ssize_t n = ::recv(fd, bloque, sizeof(bloque), MSG_DONTWAIT);
+            if (n > 0) {
+                entrada.insert(entrada.end(), bloque, bloque + n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                desconectar();
+            }
+            break;
+        }
+
+        size_t procesados = 0;
+        bool nuevo = false;
+        while (procesados < maximo) {
+            size_t largo = mensajeCompleto(entrada, inicioEntrada);
+            if (largo == 0) break;
+            procesar(static_cast<TipoMensaje>(entrada[inicioEntrada]),
+                     LectorMensaje(entrada.data() + inicioEntrada + TAMANO_CABECERA, largo - TAMANO_CABECERA));
+            inicioEntrada += largo;
+            procesados++;
+            nuevo = true;
+        }
+        // Compactar cuando lo consumido supera a lo pendiente
+        if (inicioEntrada > entrada.size() / 2) {
+            entrada.erase(entrada.begin(), entrada.begin() + static_cast<std::ptrdiff_t>(inicioEntrada));
+            inicioEntrada = 0;
+        }
+
+        mensajes += static_cast<long long>(procesados);
+        pendientesDeCredito += procesados;
+        if (fd >= 0 && pendientesDeCredito >= CREDITOS_INICIALES / 4) {
+            enviarCredito(static_cast<uint32_t>(pendientesDeCredito));
+            pendientesDeCredito = 0;
+        }
+        cambios = cambios || nuevo;
+        return nuevo;
+    }
+
+    // Esperar hasta "milisegundos" a que haya algo que leer. Devuelve
+    // true si hay datos (o mensajes sin procesar) o si la conexión se
+    // cerró, es decir, si vale la pena llamar a recibir()
+    bool esperar(int milisegundos) {
+        if (quedanMensajes()) return true;
+        if (fd < 0) return false;
+        pollfd p{fd, POLLIN, 0};
+        int n;
+        while ((n = ::poll(&p, 1, milisegundos)) < 0 && errno == EINTR) {}
+        return n != 0;
+    }
+
+    // Si llegó algo desde la última llamada a armarResultados()
+    bool hayCambios() const { return cambios; }
+
+    // Resultados con lo recibido hasta ahora, uno por grupo, sobre una
+    // carga con los procesos anunciados. Los resúmenes de métricas solo
+    // cuentan los procesos que ya terminaron.
+    std::vector<ResultadoSimulacion> armarResultados() {
+        cambios = false;
+        CargaCompartida carga = compartirCarga(procesos);
+        std::vector<ResultadoSimulacion> resultados;
+        for (const auto& g : grupos) {
+            ResultadoSimulacion r;
+            r.algoritmo = algoritmoDe(g.nombre);
+            r.carga = carga;
+            r.eventos = g.eventos;
+            r.espera = g.espera;
+            r.respuesta = g.respuesta;
+            r.finalizacion = g.finalizacion;
+            r.espera.resize(procesos.size(), 0);
+            r.respuesta.resize(procesos.size(), 0);
+            r.finalizacion.resize(procesos.size(), 0);
+            r.inicio.assign(procesos.size(), -1);
+
+            std::vector<Tiempo> espera, respuesta, finalizacion;
+            for (size_t i = 0; i < g.terminado.size(); ++i) {
+                if (!g.terminado[i]) continue;
+                espera.push_back(r.espera[i]);
+                respuesta.push_back(r.respuesta[i]);
+                finalizacion.push_back(r.finalizacion[i]);
+            }
+            r.resumenEspera = resumirColumna(espera);
+            r.resumenRespuesta = resumirColumna(respuesta);
+            r.resumenFinalizacion = resumirColumna(finalizacion);
+            r.avgWaitingTime = r.resumenEspera.media;
+            r.avgCompletionTime = r.resumenFinalizacion.media;
+            r.avgResponseTime = r.resumenRespuesta.media;
+            resultados.push_back(std::move(r));
+        }
+        return resultados;
+    }
+
+private:
+    struct Grupo {
+        std::string nombre;
+        std::vector<EventoGantt> eventos;
+        std::vector<Tiempo> espera;
+        std::vector<Tiempo> respuesta;
+        std::vector<Tiempo> finalizacion;
+        std::vector<bool> terminado;
+    };
+
+    int fd;
+    std::vector<char> entrada;
+    size_t inicioEntrada = 0;
+    size_t pendientesDeCredito;
+    bool finalizado;
+    long long mensajes;
+    bool cambios;
+
+    std::vector<Grupo> grupos;
+    std::vector<Proceso> procesos;
+    std::unordered_map<std::string, size_t> indiceProceso;
+
+    static TipoAlgoritmo algoritmoDe(const std::string& nombre) {
+        const TipoAlgoritmo tipos[] = {FIFO, SJF, SRTF, ROUND_ROBIN, PRIORITY};
+        for (TipoAlgoritmo t : tipos) {
+            if (nombre == nombreAlgoritmo(t)) return t;
+        }
+        return FIFO;
+    }
+
+    Grupo* grupoDe(int64_t indice) {
+        if (indice < 0 || static_cast<size_t>(indice) >= grupos.size()) return nullptr;
+        return &grupos[static_cast<size_t>(indice)];
+    }
+
+    void procesar(TipoMensaje tipo, LectorMensaje m) {
+        switch (tipo) {
+            case MENSAJE_GRUPO: {
+                int64_t indice = m.entero();
+                if (static_cast<size_t>(indice) >= grupos.size()) grupos.resize(static_cast<size_t>(indice) + 1);
+                grupos[static_cast<size_t>(indice)].nombre = m.texto();
+                break;
+            }
+            case MENSAJE_PROCESO: {
+                std::string pid = m.texto();
+                Tiempo bt = m.entero();
+                Tiempo at = m.entero();
+                int pr = static_cast<int>(m.entero());
+                indiceProceso[pid] = procesos.size();
+                procesos.push_back(Proceso(pid, bt, at, pr));
+                break;
+            }
+            case MENSAJE_EVENTO: {
+                Grupo* g = grupoDe(m.entero());
+                std::string pid = m.texto();
+                Tiempo inicio = m.entero();
+                Tiempo fin = m.entero();
+                std::string estado = m.texto();
+                if (g) g->eventos.push_back(EventoGantt(pid, inicio, fin, estado));
+                break;
+            }
+            case MENSAJE_TERMINADO: {
+                Grupo* g = grupoDe(m.entero());
+                auto it = indiceProceso.find(m.texto());
+                if (!g || it == indiceProceso.end()) break;
+                size_t i = it->second;
+                if (g->terminado.size() <= i) {
+                    g->espera.resize(i + 1, 0);
+                    g->respuesta.resize(i + 1, 0);
+                    g->finalizacion.resize(i + 1, 0);
+                    g->terminado.resize(i + 1, false);
+                }
+                g->espera[i] = m.entero();
+                g->respuesta[i] = m.entero();
+                g->finalizacion[i] = m.entero();
+                g->terminado[i] = true;
+                break;
+            }
+            case MENSAJE_FIN:
+                finalizado = true;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void enviarCredito(uint32_t n) {
+        std::vector<char> buffer;
+        EscritorMensajes m(buffer);
+        m.iniciar(MENSAJE_CREDITO);
+        m.entero32(n);
+        m.terminar();
+        enviar(buffer);
+    }
+
+    void enviar(const std::vector<char>& buffer) {
+        size_t enviado = 0;
+        while (fd >= 0 && enviado < buffer.size()) {
+            ssize_t n = ::send(fd, buffer.data() + enviado, buffer.size() - enviado, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                desconectar();
+                return;
+            }
+            enviado += static_cast<size_t>(n);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef DISPOSITIVOS_ES_H
+#define DISPOSITIVOS_ES_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include "estructuras.h"
+
+// Uso de un dispositivo durante una corrida
+struct UsoDispositivo {
+    std::string nombre;
+    int servidores = 1;
+    long long solicitudes = 0;
+    long long demoradas = 0;    // Las que esperaron en la cola
+    Tiempo ocupado = 0;         // Tiempo de servicio sumado entre servidores
+    Tiempo espera = 0;          // Tiempo en cola antes de ser atendidas
+    double utilizacion = 0.0;   // ocupado / (servidores * duración de la corrida)
+};
+
+// ------------------------------------------------------------
+// Banco de dispositivos de E/S
+// ------------------------------------------------------------
+// Lleva las solicitudes en curso y en cola de todos los dispositivos. El
+// ciclo de simulación pide proximaFinalizacion() para cortar los tramos
+// y recoge con terminar() las solicitudes atendidas, en orden de tiempo
+// (los empates, en el orden de la carga). Al terminar una, el primero de
+// la cola de ese dispositivo empieza en ese instante.
+//
+// El ciclo puede recoger las finalizaciones tarde (un tramo no
+// expropiable no se corta en ellas), así que una solicitud puede entrar
+// a la cola aunque un servidor ya se hubiera liberado. Con servidores
+// iguales y cola FIFO basta con que empiece en max(liberación, solicitud)
+// para obtener los mismos tiempos que al recogerlas a tiempo.
+class BancoDispositivos {
+public:
+    struct Terminada {
+        int proceso;
+        Tiempo solicitud;
+        Tiempo fin;
+    };
+
+    // Resolver el dispositivo de cada ráfaga de E/S. Sin dispositivos
+    // declarados se crea uno implícito (un servidor, sin latencia) por
+    // cada nombre usado en la carga.
+    void configurar(const std::vector<Dispositivo>& declarados, const std::vector<Proceso>& procesos) {
+        dispositivos = declarados;
+        std::unordered_map<std::string, int> indice;
+        for (size_t d = 0; d < dispositivos.size(); ++d) {
+            indice[dispositivos[d].nombre] = static_cast<int>(d);
+        }
+
+        inicioRafagas.assign(procesos.size() + 1, 0);
+        dispositivoDe.clear();
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            for (const RafagaES& r : procesos[i].rafagasES) {
+                auto it = indice.find(r.dispositivo);
+                if (it == indice.end()) {
+                    if (!declarados.empty()) {
+                        throw std::runtime_error("Dispositivo desconocido en " + procesos[i].pid + ": " +
+                                                 r.dispositivo);
+                    }
+                    it = indice.emplace(r.dispositivo, static_cast<int>(dispositivos.size())).first;
+                    dispositivos.push_back(Dispositivo(r.dispositivo));
+                }
+                dispositivoDe.push_back(it->second);
+            }
+            inicioRafagas[i + 1] = static_cast<int>(dispositivoDe.size());
+        }
+        estado.assign(dispositivos.size(), Estado());
+    }
+
+    void reiniciar() {
+        for (Estado& e : estado) {
+            e.cola.clear();
+            e.enServicio = 0;
+            e.uso = UsoDispositivo();
+        }
+        enCurso.clear();
+    }
+
+    // El proceso i pide la ráfaga de E/S k en el instante t
+    void solicitar(int i, size_t k, const Proceso& p, Tiempo t) {
+        int d = dispositivoDe[inicioRafagas[i] + k];
+        Estado& e = estado[d];
+        e.uso.solicitudes++;
+        Pedido pedido{i, t, p.rafagasES[k].duracion};
+        if (e.enServicio < dispositivos[d].servidores) {
+            atender(d, pedido, t);
+        } else {
+            e.cola.push_back(pedido);
+        }
+    }
+
+    bool activo() const { return !enCurso.empty(); }
+
+    Tiempo proximaFinalizacion() const {
+        return enCurso.empty() ? TIEMPO_MAXIMO : enCurso.front().fin;
+    }
+
+    // Sacar la próxima solicitud atendida y pasar el servidor al
+    // siguiente de la cola
+    Terminada terminar() {
+        std::pop_heap(enCurso.begin(), enCurso.end(), despues);
+        Servicio s = enCurso.back();
+        enCurso.pop_back();
+
+        Estado& e = estado[s.dispositivo];
+        e.enServicio--;
+        if (!e.cola.empty()) {
+            Pedido siguiente = e.cola.front();
+            e.cola.pop_front();
+            atender(s.dispositivo, siguiente, s.fin);
+        }
+        return {s.proceso, s.solicitud, s.fin};
+    }
+
+    // Uso de cada dispositivo en una corrida de "duracion" ciclos
+    std::vector<UsoDispositivo> resumir(Tiempo duracion) const {
+        std::vector<UsoDispositivo> usos;
+        for (size_t d = 0; d < dispositivos.size(); ++d) {
+            UsoDispositivo u = estado[d].uso;
+            u.nombre = dispositivos[d].nombre;
+            u.servidores = dispositivos[d].servidores;
+            if (duracion > 0) {
+                u.utilizacion = static_cast<double>(u.ocupado) / (static_cast<double>(duracion) * u.servidores);
+            }
+            usos.push_back(u);
+        }
+        return usos;
+    }
+
+private:
+    struct Pedido {
+        int proceso;
+        Tiempo solicitud;
+        Tiempo duracion;
+    };
+
+    struct Servicio {
+        Tiempo fin;
+        int proceso;
+        int dispositivo;
+        Tiempo solicitud;
+    };
+
+    struct Estado {
+        std::deque<Pedido> cola;
+        int enServicio = 0;
+        UsoDispositivo uso;
+    };
+
+    // Comparador invertido: std::*_heap deja en la cima el menor fin
+    static bool despues(const Servicio& a, const Servicio& b) {
+        if (a.fin != b.fin) return a.fin > b.fin;
+        return a.proceso > b.proceso;
+    }
+
+    // Empezar a atender un pedido con un servidor libre desde "libre"
+    void atender(int d, const Pedido& pedido, Tiempo libre) {
+        Estado& e = estado[d];
+        Tiempo inicio = std::max(libre, pedido.solicitud);
+        Tiempo servicio = dispositivos[d].latencia + pedido.duracion;
+        e.enServicio++;
+        e.uso.ocupado += servicio;
+        e.uso.espera += inicio - pedido.solicitud;
+        if (inicio > pedido.solicitud) e.uso.demoradas++;
+        enCurso.push_back({inicio + servicio, pedido.proceso, d, pedido.solicitud});
+        std::push_heap(enCurso.begin(), enCurso.end(), despues);
+    }
+
+    std::vector<Dispositivo> dispositivos;
+    std::vector<Estado> estado;
+
+    // Dispositivo de cada ráfaga de E/S en formato CSR por proceso
+    std::vector<int> inicioRafagas;
+    std::vector<int> dispositivoDe;
+
+    std::vector<Servicio> enCurso;
+};
+
+#endif
@@ -0,0 +1,287 @@
+#ifndef ENERGIA_DVFS_H
+#define ENERGIA_DVFS_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <cmath>
+#include <climits>
+#include <algorithm>
+#include <stdexcept>
+#include "estructuras.h"
+
+// Energía de una corrida con DVFS, entre la primera llegada y el último
+// fin (como Rendimiento::duracion)
+struct ConsumoEnergia {
+    std::string gobernador;         // Vacío: corrida sin DVFS
+    double total = 0.0;
+    double activa = 0.0;            // Ejecutando procesos
+    double ociosa = 0.0;            // Sin procesos listos
+    double cambios = 0.0;           // De los cambios de nivel
+    long long numCambios = 0;
+    Tiempo ciclosCambio = 0;        // Sin ejecutar por la latencia de los cambios
+    double frecuenciaMedia = 0.0;   // Ponderada por los ciclos ejecutando
+    std::vector<Tiempo> ciclosPorNivel;
+};
+
+// Modelo por defecto: cuatro niveles con potencia activa estática más
+// una dinámica cúbica en la frecuencia (el voltaje baja con ella), así
+// que a menor frecuencia cada ciclo de trabajo cuesta menos energía
+// aunque tarde más
+inline ModeloDVFS modeloDVFSPorDefecto() {
+    ModeloDVFS m;
+    const long long frecuencias[] = {800, 1600, 2400, 3200};
+    for (long long f : frecuencias) {
+        double r = static_cast<double>(f) / 3200.0;
+        m.niveles.push_back(NivelFrecuencia(f, 0.3 + 4.0 * r * r * r, 0.1 + 0.1 * r));
+    }
+    m.latenciaCambio = 1;
+    m.energiaCambio = 0.5;
+    return m;
+}
+
+// Ordenar los niveles de menor a mayor frecuencia y validar el modelo
+inline void normalizarModelo(ModeloDVFS& m) {
+    if (m.niveles.empty()) {
+        throw std::runtime_error("El modelo DVFS no tiene niveles de frecuencia");
+    }
+    std::sort(m.niveles.begin(), m.niveles.end(),
+              [](const NivelFrecuencia& a, const NivelFrecuencia& b) { return a.frecuencia < b.frecuencia; });
+    for (size_t k = 0; k < m.niveles.size(); ++k) {
+        const NivelFrecuencia& n = m.niveles[k];
+        if (n.frecuencia <= 0 || n.potenciaActiva < 0 || n.potenciaOciosa < 0) {
+            throw std::runtime_error("Nivel de frecuencia inválido: " + std::to_string(n.frecuencia));
+        }
+        if (k > 0 && n.frecuencia == m.niveles[k - 1].frecuencia) {
+            throw std::runtime_error("Nivel de frecuencia repetido: " + std::to_string(n.frecuencia));
+        }
+    }
+    if (m.latenciaCambio < 0 || m.energiaCambio < 0) {
+        throw std::runtime_error("El costo de un cambio de frecuencia no puede ser negativo");
+    }
+}
+
+// ------------------------------------------------------------
+// Gobernadores
+// ------------------------------------------------------------
+// Eligen el nivel de frecuencia antes de cada tramo de CPU. Los niveles
+// del modelo van de menor a mayor frecuencia; la corrida empieza en el
+// más alto.
+class Gobernador {
+public:
+    virtual ~Gobernador() {}
+
+    virtual const char* nombre() const = 0;
+
+    // Al iniciar una corrida que empieza a medirse en "inicio"
+    virtual void reiniciar(const ModeloDVFS&, Tiempo) {}
+
+    // Nivel para el tramo que empieza en "t". "ocupado" son los ciclos
+    // con la CPU ocupada desde el inicio de la corrida.
+    virtual size_t elegirNivel(const ModeloDVFS& modelo, size_t actual, Tiempo t, Tiempo ocupado) = 0;
+};
+
+// performance: siempre la frecuencia más alta
+class GobernadorRendimiento : public Gobernador {
+public:
+    const char* nombre() const override { return "performance"; }
+
+    size_t elegirNivel(const ModeloDVFS& modelo, size_t, Tiempo, Tiempo) override {
+        return modelo.niveles.size() - 1;
+    }
+};
+
+// powersave: siempre la frecuencia más baja
+class GobernadorAhorro : public Gobernador {
+public:
+    const char* nombre() const override { return "powersave"; }
+
+    size_t elegirNivel(const ModeloDVFS&, size_t, Tiempo, Tiempo) override {
+        return 0;
+    }
+};
+
+// ondemand: mide la utilización de la CPU en ventanas de "periodo"
+// ciclos. Por encima del umbral sube a la frecuencia más alta; por
+// debajo baja al menor nivel que la mantendría en el umbral. Entre
+// muestras conserva el nivel.
+class GobernadorBajoDemanda : public Gobernador {
+public:
+    explicit GobernadorBajoDemanda(Tiempo p = 10, double u = 0.8)
+        : periodo(std::max<Tiempo>(1, p)), umbral(u), inicioMuestra(0), ocupadoMuestra(0) {}
+
+    const char* nombre() const override { return "ondemand"; }
+
+    void reiniciar(const ModeloDVFS&, Tiempo inicio) override {
+        inicioMuestra = inicio;
+        ocupadoMuestra = 0;
+    }
+
+    size_t elegirNivel(const ModeloDVFS& modelo, size_t actual, Tiempo t, Tiempo ocupado) override {
+        if (t - inicioMuestra < periodo) {
+            return actual;
+        }
+        double carga = static_cast<double>(ocupado - ocupadoMuestra) / static_cast<double>(t - inicioMuestra);
+        inicioMuestra = t;
+        ocupadoMuestra = ocupado;
+
+        const size_t maximo = modelo.niveles.size() - 1;
+        if (carga >= umbral) {
+            return maximo;
+        }
+        double objetivo = static_cast<double>(modelo.niveles[maximo].frecuencia) * carga / umbral;
+        for (size_t k = 0; k < maximo; ++k) {
+            if (static_cast<double>(modelo.niveles[k].frecuencia) >= objetivo) return k;
+        }
+        return maximo;
+    }
+
+private:
+    Tiempo periodo;
+    double umbral;
+    Tiempo inicioMuestra;
+    Tiempo ocupadoMuestra;
+};
+
+enum TipoGobernador {
+    GOBERNADOR_RENDIMIENTO,
+    GOBERNADOR_AHORRO,
+    GOBERNADOR_BAJO_DEMANDA
+};
+
+inline const char* nombreGobernador(TipoGobernador tipo) {
+    switch (tipo) {
+        case GOBERNADOR_RENDIMIENTO:  return "performance";
+        case GOBERNADOR_AHORRO:       return "powersave";
+        case GOBERNADOR_BAJO_DEMANDA: return "ondemand";
+    }
+    return "?";
+}
+
+inline std::unique_ptr<Gobernador> crearGobernador(TipoGobernador tipo) {
+    switch (tipo) {
+        case GOBERNADOR_RENDIMIENTO:  return std::unique_ptr<Gobernador>(new GobernadorRendimiento());
+        case GOBERNADOR_AHORRO:       return std::unique_ptr<Gobernador>(new GobernadorAhorro());
+        case GOBERNADOR_BAJO_DEMANDA: return std::unique_ptr<Gobernador>(new GobernadorBajoDemanda());
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------
+// Control DVFS de una corrida
+// ------------------------------------------------------------
+// Los BT de la carga son trabajo a la frecuencia más alta. A frecuencia
+// f, w ciclos de trabajo tardan ceil(w * fmax / f) ciclos de reloj, y en
+// d ciclos de reloj caben floor(d * f / fmax) de trabajo (al menos 1,
+// para que todo tramo avance). Con la frecuencia más alta ambos son la
+// identidad, así que el gobernador performance sin costo de cambio
+// reproduce exactamente la corrida sin DVFS.
+class ControlDVFS {
+public:
+    ControlDVFS() : nivel(0), ocupado(0), inicioMedicion(0) {}
+
+    // Sin gobernador se desactiva
+    void configurar(ModeloDVFS m, std::unique_ptr<Gobernador> g) {
+        if (g) {
+            normalizarModelo(m);
+        }
+        modelo = std::move(m);
+        gobernador = std::move(g);
+    }
+
+    bool activo() const { return gobernador != nullptr; }
+
+    const ModeloDVFS& getModelo() const { return modelo; }
+
+    void reiniciar(Tiempo inicio) {
+        nivel = modelo.niveles.size() - 1;
+        ocupado = 0;
+        inicioMedicion = inicio;
+        consumo = ConsumoEnergia();
+        consumo.gobernador = gobernador->nombre();
+        consumo.ciclosPorNivel.assign(modelo.niveles.size(), 0);
+        gobernador->reiniciar(modelo, inicio);
+    }
+
+    // Antes de un tramo que empieza en "t": el gobernador elige el nivel.
+    // Devuelve los ciclos que la CPU queda sin ejecutar por el cambio (0
+    // si el nivel no cambia).
+    Tiempo antesDeTramo(Tiempo t) {
+        size_t nuevo = std::min(gobernador->elegirNivel(modelo, nivel, t, ocupado), modelo.niveles.size() - 1);
+        if (nuevo == nivel) {
+            return 0;
+        }
+        nivel = nuevo;
+        consumo.numCambios++;
+        consumo.cambios += modelo.energiaCambio;
+        consumo.ciclosCambio += modelo.latenciaCambio;
+        ocupado += modelo.latenciaCambio;
+        return modelo.latenciaCambio;
+    }
+
+    // Trabajo que cabe en "duracion" ciclos al nivel actual
+    Tiempo trabajoEn(Tiempo duracion) const {
+        const long long f = modelo.niveles[nivel].frecuencia;
+        const long long maxima = modelo.niveles.back().frecuencia;
+        Tiempo trabajo;
+        if (f == maxima) {
+            trabajo = duracion;
+        } else if (duracion <= LLONG_MAX / f) {
+            trabajo = duracion * f / maxima;
+        } else {
+            trabajo = static_cast<Tiempo>(static_cast<long double>(duracion) * f / maxima);
+        }
+        return std::max<Tiempo>(1, trabajo);
+    }
+
+    // Ciclos que tarda "trabajo" al nivel actual
+    Tiempo duracionDe(Tiempo trabajo) const {
+        const long long f = modelo.niveles[nivel].frecuencia;
+        const long long maxima = modelo.niveles.back().frecuencia;
+        if (f == maxima) {
+            return trabajo;
+        }
+        if (trabajo <= (LLONG_MAX - f) / maxima) {
+            return (trabajo * maxima + f - 1) / f;
+        }
+        return static_cast<Tiempo>(std::ceil(static_cast<long double>(trabajo) * maxima / f));
+    }
+
+    // La CPU ejecutó un tramo de "duracion" ciclos al nivel actual
+    void alEjecutar(Tiempo duracion) {
+        consumo.activa += modelo.niveles[nivel].potenciaActiva * static_cast<double>(duracion);
+        consumo.ciclosPorNivel[nivel] += duracion;
+        ocupado += duracion;
+    }
+
+    // La CPU estuvo ociosa en [desde, hasta); no cuenta antes del inicio
+    void alOcioso(Tiempo desde, Tiempo hasta) {
+        Tiempo d = hasta - std::max(desde, inicioMedicion);
+        if (d > 0) {
+            consumo.ociosa += modelo.niveles[nivel].potenciaOciosa * static_cast<double>(d);
+        }
+    }
+
+    ConsumoEnergia resumir() const {
+        ConsumoEnergia c = consumo;
+        c.total = c.activa + c.ociosa + c.cambios;
+        double ciclos = 0.0;
+        double ponderada = 0.0;
+        for (size_t k = 0; k < c.ciclosPorNivel.size(); ++k) {
+            ciclos += static_cast<double>(c.ciclosPorNivel[k]);
+            ponderada += static_cast<double>(c.ciclosPorNivel[k]) * static_cast<double>(modelo.niveles[k].frecuencia);
+        }
+        c.frecuenciaMedia = ciclos > 0 ? ponderada / ciclos : 0.0;
+        return c;
+    }
+
+private:
+    ModeloDVFS modelo;
+    std::unique_ptr<Gobernador> gobernador;
+    size_t nivel;
+    Tiempo ocupado;
+    Tiempo inicioMedicion;
+    ConsumoEnergia consumo;
+};
+
+#endif
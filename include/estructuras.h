@@ -3,38 +3,150 @@
 
 #include <string>
 #include <vector>
+#include <climits>
+
+// Tiempo en ciclos. Es de 64 bits para trazas largas (p. ej. microsegundos
+// durante días), que no caben en un int.
+typedef long long Tiempo;
+
+// Instante que nunca llega (p. ej. "no hay más llegadas")
+const Tiempo TIEMPO_MAXIMO = LLONG_MAX;
+
+// Ráfaga de E/S entre dos ráfagas de CPU de un proceso
+struct RafagaES {
+    std::string dispositivo;
+    Tiempo duracion;
+};
 
 // Estructura para un Proceso
 struct Proceso {
     std::string pid;
-    int burstTime;      // BT - Tiempo de ejecución
-    int arrivalTime;    // AT - Tiempo de llegada
-    int priority;       // Prioridad (1 = más alta)
+    Tiempo burstTime;      // BT - Tiempo de ejecución (total de CPU)
+    Tiempo arrivalTime;    // AT - Tiempo de llegada
+    int priority;          // Prioridad (1 = más alta)
+    
+    // Ráfagas alternadas CPU, E/S, CPU, ..., CPU (rafagasES[k] va entre
+    // rafagasCPU[k] y rafagasCPU[k + 1]). Vacías: una sola ráfaga de CPU
+    // de burstTime.
+    std::vector<Tiempo> rafagasCPU;
+    std::vector<RafagaES> rafagasES;
+    
+    // Grupo del reparto justo, p. ej. "inquilinoA/web" (vacío: ninguno)
+    std::string grupo;
     
     // Variables para el algoritmo
-    int remainingTime;  // Para SRTF y Round Robin
-    int waitingTime;    // Tiempo de espera
-    int completionTime; // Tiempo de finalización
-    int startTime;      // Primera vez que se ejecuta
-    int responseTime;   // Tiempo de respuesta (startTime - arrivalTime)
-    bool started;       // Si ya empezó a ejecutarse
+    Tiempo remainingTime;  // De la ráfaga de CPU en curso
+    Tiempo waitingTime;    // Tiempo de espera (en la cola de listos)
+    Tiempo completionTime; // Tiempo de finalización
+    Tiempo startTime;      // Primera vez que se ejecuta
+    Tiempo responseTime;   // Tiempo de respuesta (startTime - arrivalTime)
+    bool started;          // Si ya empezó a ejecutarse
+    size_t rafaga;         // Ráfaga de CPU en curso
+    Tiempo tiempoES;       // En E/S (cola del dispositivo y servicio)
+    Tiempo tiempoCPU;      // Ciclos en CPU (más que BT a menor frecuencia, ver DVFS)
     
     // Constructor
-    Proceso(std::string p, int bt, int at, int pr) 
+    Proceso(std::string p, Tiempo bt, Tiempo at, int pr) 
         : pid(p), burstTime(bt), arrivalTime(at), priority(pr),
           remainingTime(bt), waitingTime(0), completionTime(0), 
-          startTime(-1), responseTime(0), started(false) {}
+          startTime(-1), responseTime(0), started(false), rafaga(0), tiempoES(0), tiempoCPU(0) {}
+    
+    bool tieneES() const { return !rafagasES.empty(); }
+    
+    Tiempo duracionRafaga(size_t k) const {
+        return rafagasCPU.empty() ? burstTime : rafagasCPU[k];
+    }
+    
+    size_t numRafagas() const {
+        return rafagasCPU.empty() ? 1 : rafagasCPU.size();
+    }
+};
+
+// Dispositivo de E/S: atiende hasta "servidores" solicitudes a la vez y
+// las demás esperan en su cola por orden de llegada. Cada solicitud
+// cuesta latencia + la duración de la ráfaga.
+struct Dispositivo {
+    std::string nombre;
+    int servidores;
+    Tiempo latencia;
+    
+    Dispositivo(std::string n, int s = 1, Tiempo l = 0)
+        : nombre(n), servidores(s), latencia(l) {}
 };
 
+// Nivel de frecuencia (P-state) de la CPU. La frecuencia puede darse en
+// cualquier unidad (p. ej. MHz): solo importa su razón con la más alta,
+// que es la velocidad a la que se midieron los BT de la carga. Las
+// potencias son energía por ciclo de la simulación.
+struct NivelFrecuencia {
+    long long frecuencia;
+    double potenciaActiva;  // Ejecutando un proceso
+    double potenciaOciosa;  // Sin procesos listos
+    
+    NivelFrecuencia(long long f, double activa, double ociosa = 0.0)
+        : frecuencia(f), potenciaActiva(activa), potenciaOciosa(ociosa) {}
+};
+
+// Modelo DVFS de la CPU: sus niveles y lo que cuesta cambiar de uno a
+// otro (ciclos sin ejecutar y energía de cada cambio)
+struct ModeloDVFS {
+    std::vector<NivelFrecuencia> niveles;
+    Tiempo latenciaCambio = 0;
+    double energiaCambio = 0.0;
+};
+
+// Grupo del reparto justo jerárquico. Los subgrupos se anidan con "/"
+// ("inquilinoA/web"). Cada grupo recibe una parte de la CPU proporcional
+// a su peso frente a sus hermanos con trabajo, y sus procesos se
+// calendarizan con "algoritmo" (vacío: el de la corrida).
+struct Grupo {
+    std::string nombre;
+    int peso;
+    std::string algoritmo;
+    Tiempo respuestaObjetivo;   // Respuesta promedio esperada (0: sin objetivo)
+    
+    Grupo(std::string n, int p = 1, std::string a = "", Tiempo r = 0)
+        : nombre(n), peso(p), algoritmo(a), respuestaObjetivo(r) {}
+};
+
+// Cómo pasa un recurso liberado a los procesos que lo esperan
+//   irrumpir  se despierta a todos; lo toma el primero que reintenta,
+//             aunque no estuviera esperando
+//   fifo      se entrega directamente al primero de la cola
+//   girar:N   como irrumpir, pero quien lo encuentra ocupado reintenta
+//             en CPU durante N ciclos antes de dormirse
+//   lote:N    las unidades liberadas se acumulan y se entregan de a N
+//             (semáforos), con un solo despertar por lote
+enum PoliticaEntrega {
+    ENTREGA_POR_DEFECTO,
+    ENTREGA_IRRUMPIR,
+    ENTREGA_FIFO,
+    ENTREGA_GIRAR,
+    ENTREGA_LOTE
+};
+
+inline const char* nombreEntrega(PoliticaEntrega politica) {
+    switch (politica) {
+        case ENTREGA_POR_DEFECTO: return "por defecto";
+        case ENTREGA_IRRUMPIR:    return "irrumpir";
+        case ENTREGA_FIFO:        return "fifo";
+        case ENTREGA_GIRAR:       return "girar";
+        case ENTREGA_LOTE:        return "lote";
+    }
+    return "?";
+}
+
 // Estructura para un Recurso (para sincronización)
 struct Recurso {
     std::string nombre;
     int contador;       // 1 para mutex, >1 para semáforo
     int contadorOriginal;
     std::vector<std::string> colaEspera; // PIDs esperando
+    PoliticaEntrega entrega;
+    int parametroEntrega;   // Ciclos de giro o tamaño del lote
     
-    Recurso(std::string n, int c) 
-        : nombre(n), contador(c), contadorOriginal(c) {}
+    Recurso(std::string n, int c, PoliticaEntrega e = ENTREGA_POR_DEFECTO, int parametro = 0)
+        : nombre(n), contador(c), contadorOriginal(c), entrega(e), parametroEntrega(parametro) {}
 };
 
 // Estructura para una Acción (para sincronización)
@@ -42,20 +154,20 @@ struct Accion {
     std::string pid;
     std::string tipo;   // READ o WRITE
     std::string recurso;
-    int ciclo;
+    Tiempo ciclo;
     
-    Accion(std::string p, std::string t, std::string r, int c)
+    Accion(std::string p, std::string t, std::string r, Tiempo c)
         : pid(p), tipo(t), recurso(r), ciclo(c) {}
 };
 
 // Estructura para un evento en el diagrama de Gantt
 struct EventoGantt {
     std::string pid;
-    int inicio;
-    int fin;
-    std::string estado; // "RUNNING", "WAITING", "ACCESSED"
+    Tiempo inicio;
+    Tiempo fin;
+    std::string estado; // "RUNNING", "WAITING", "ACCESSED", "OVERHEAD", "IO"
     
-    EventoGantt(std::string p, int i, int f, std::string e = "RUNNING")
+    EventoGantt(std::string p, Tiempo i, Tiempo f, std::string e = "RUNNING")
         : pid(p), inicio(i), fin(f), estado(e) {}
 };
 
@@ -0,0 +1,147 @@
+#ifndef EXPERIMENTOS_H
+#define EXPERIMENTOS_H
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "generador_cargas.h"
+#include "simulador_calendarizacion.h"
+
+// ------------------------------------------------------------
+// Experimentos de Monte Carlo
+// ------------------------------------------------------------
+// Cada réplica genera una carga aleatoria a partir de (semilla, réplica)
+// y la ejecuta con todos los algoritmos seleccionados. Las réplicas se
+// reparten entre hilos, pero los resultados se guardan por índice de
+// réplica y se agregan en orden, así que el informe es idéntico con
+// cualquier número de hilos.
+
+struct ConfiguracionExperimento {
+    EspecificacionCarga carga;          // carga.procesos = procesos por réplica
+    long long replicas = 1000;
+    uint64_t semilla = 1;
+    std::vector<TipoAlgoritmo> algoritmos = {FIFO, SJF, SRTF, ROUND_ROBIN, PRIORITY};
+    Tiempo quantum = 2;
+    unsigned hilos = 1;
+    double confianza = 0.95;            // Nivel del intervalo, en (0, 1)
+};
+
+// Media con intervalo de confianza [media - margen, media + margen]
+struct Resumen {
+    double media = 0;
+    double desviacion = 0;
+    double margen = 0;
+};
+
+struct ResultadoExperimento {
+    TipoAlgoritmo algoritmo;
+    Resumen espera;
+    Resumen respuesta;
+    Resumen finalizacion;
+};
+
+// Cuantil de la normal estándar para 0 < p < 1 (aproximación racional de
+// Acklam, error relativo < 1.2e-9)
+inline double cuantilNormal(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    const double bajo = 0.02425;
+    if (p < bajo) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - bajo) {
+        return -cuantilNormal(1 - p);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+// Valor crítico bilateral de la t de Student para el nivel "confianza"
+// (aproximación de Cornish-Fisher sobre el cuantil normal); con miles de
+// réplicas coincide con la normal
+inline double valorCritico(double confianza, long long gradosLibertad) {
+    if (!(confianza > 0 && confianza < 1)) {
+        throw std::runtime_error("El nivel de confianza debe estar entre 0 y 1: " + std::to_string(confianza));
+    }
+    double z = cuantilNormal(1 - (1 - confianza) / 2);
+    if (gradosLibertad <= 0) return 0;
+    double g = static_cast<double>(gradosLibertad);
+    double z3 = z * z * z, z5 = z3 * z * z;
+    return z + (z3 + z) / (4 * g) + (5 * z5 + 16 * z3 + 3 * z) / (96 * g * g);
+}
+
+// Resumen de una columna de muestras (una por réplica), en orden fijo
+inline Resumen resumir(const std::vector<double>& muestras, double confianza) {
+    Resumen r;
+    long long n = static_cast<long long>(muestras.size());
+    if (n == 0) return r;
+    double suma = 0;
+    for (double x : muestras) suma += x;
+    r.media = suma / n;
+    double cuadrados = 0;
+    for (double x : muestras) cuadrados += (x - r.media) * (x - r.media);
+    r.desviacion = n > 1 ? std::sqrt(cuadrados / (n - 1)) : 0;
+    r.margen = valorCritico(confianza, n - 1) * r.desviacion / std::sqrt(static_cast<double>(n));
+    return r;
+}
+
+inline std::vector<ResultadoExperimento> ejecutarExperimento(const ConfiguracionExperimento& config) {
+    const size_t numAlgoritmos = config.algoritmos.size();
+    const size_t replicas = static_cast<size_t>(std::max(0LL, config.replicas));
+
+    // muestras[algoritmo][métrica][réplica]
+    std::vector<std::vector<std::vector<double>>> muestras(
+        numAlgoritmos, std::vector<std::vector<double>>(3, std::vector<double>(replicas)));
+
+    std::atomic<size_t> siguiente(0);
+    auto trabajador = [&]() {
+        SimuladorCalendarizacion simulador;
+        simulador.setQuantum(config.quantum);
+        simulador.setRetenerEventos(false);
+
+        for (size_t r = siguiente++; r < replicas; r = siguiente++) {
+            uint64_t semillaReplica = GeneradorAleatorio::derivar(config.semilla, r).siguiente();
+            simulador.cargarCarga(compartirCarga(generarProcesos(config.carga, semillaReplica)));
+
+            for (size_t a = 0; a < numAlgoritmos; ++a) {
+                simulador.ejecutar(config.algoritmos[a]);
+                muestras[a][0][r] = simulador.getAvgWaitingTime();
+                muestras[a][1][r] = simulador.getAvgResponseTime();
+                muestras[a][2][r] = simulador.getAvgCompletionTime();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned h = 1; h < config.hilos && h < replicas; ++h) {
+        pool.emplace_back(trabajador);
+    }
+    trabajador();
+    for (auto& t : pool) t.join();
+
+    std::vector<ResultadoExperimento> resultados;
+    for (size_t a = 0; a < numAlgoritmos; ++a) {
+        ResultadoExperimento res;
+        res.algoritmo = config.algoritmos[a];
+        res.espera = resumir(muestras[a][0], config.confianza);
+        res.respuesta = resumir(muestras[a][1], config.confianza);
+        res.finalizacion = resumir(muestras[a][2], config.confianza);
+        resultados.push_back(res);
+    }
+    return resultados;
+}
+
+#endif
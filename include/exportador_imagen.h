@@ -0,0 +1,650 @@
+#ifndef EXPORTADOR_IMAGEN_H
+#define EXPORTADOR_IMAGEN_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "estructuras.h"
+#include "receptor_eventos.h"
+#include "simulador_calendarizacion.h"
+
+// ------------------------------------------------------------
+// PNG sin dependencias
+// ------------------------------------------------------------
+// Solo lo necesario para diagramas de barras: RGB de 8 bits, filtro Up si
+// la fila repite la anterior y Sub si no, y deflate con el código Huffman
+// fijo codificando cada repetición del byte anterior como una copia a
+// distancia 1. Las franjas de color liso quedan en casi nada.
+namespace png {
+
+inline const uint32_t* tablaCrc() {
+    static const std::vector<uint32_t> tabla = [] {
+        std::vector<uint32_t> t(256);
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            t[n] = c;
+        }
+        return t;
+    }();
+    return tabla.data();
+}
+
+inline uint32_t crc32(const uint8_t* datos, size_t n, uint32_t crc = 0) {
+    const uint32_t* t = tablaCrc();
+    crc = ~crc;
+    for (size_t i = 0; i < n; ++i) {
+        crc = t[(crc ^ datos[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// Escribe bits del menos al más significativo, como pide deflate
+class Bits {
+public:
+    explicit Bits(std::vector<uint8_t>& destino) : salida(destino), acumulado(0), cuenta(0) {}
+
+    void poner(uint32_t valor, int n) {
+        acumulado |= static_cast<uint64_t>(valor) << cuenta;
+        cuenta += n;
+        while (cuenta >= 8) {
+            salida.push_back(static_cast<uint8_t>(acumulado));
+            acumulado >>= 8;
+            cuenta -= 8;
+        }
+    }
+
+    void terminar() {
+        if (cuenta > 0) salida.push_back(static_cast<uint8_t>(acumulado));
+        acumulado = 0;
+        cuenta = 0;
+    }
+
+private:
+    std::vector<uint8_t>& salida;
+    uint64_t acumulado;
+    int cuenta;
+};
+
+// Código Huffman fijo de cada símbolo, ya invertido para Bits::poner
+struct CodigoFijo {
+    uint32_t bits;
+    int largo;
+};
+
+inline const CodigoFijo* tablaFija() {
+    static const std::vector<CodigoFijo> tabla = [] {
+        std::vector<CodigoFijo> t(288);
+        for (int s = 0; s < 288; ++s) {
+            uint32_t codigo;
+            int largo;
+            if (s < 144)      { codigo = 0x30 + s; largo = 8; }
+            else if (s < 256) { codigo = 0x190 + (s - 144); largo = 9; }
+            else if (s < 280) { codigo = s - 256; largo = 7; }
+            else              { codigo = 0xC0 + (s - 280); largo = 8; }
+            uint32_t invertido = 0;
+            for (int i = 0; i < largo; ++i) {
+                invertido = (invertido << 1) | ((codigo >> i) & 1);
+            }
+            t[s] = {invertido, largo};
+        }
+        return t;
+    }();
+    return tabla.data();
+}
+
+inline void simbolo(Bits& b, int s) {
+    const CodigoFijo& c = tablaFija()[s];
+    b.poner(c.bits, c.largo);
+}
+
+// Copia de "largo" bytes (3..258) a distancia 1
+inline void copia(Bits& b, int largo) {
+    static const int base[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                               35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static const int extra[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    int k = 28;
+    while (base[k] > largo) k--;
+    simbolo(b, 257 + k);
+    if (extra[k] > 0) b.poner(static_cast<uint32_t>(largo - base[k]), extra[k]);
+    b.poner(0, 5); // Distancia 1
+}
+
+// Flujo zlib con un solo bloque de Huffman fijo; los datos se agregan
+// por partes y cada racha del mismo byte se codifica como copias
+class Deflate {
+public:
+    explicit Deflate(std::vector<uint8_t>& destino)
+        : salida(destino), bits(destino), ultimo(-1), racha(0), s1(1), s2(0) {
+        salida.push_back(0x78);
+        salida.push_back(0x01);
+        bits.poner(1, 1); // Último bloque
+        bits.poner(1, 2); // Huffman fijo
+    }
+
+    void agregar(const uint8_t* datos, size_t n) {
+        size_t i = 0;
+        while (i < n) {
+            int c = datos[i];
+            if (c == ultimo) {
+                size_t j = i + 1;
+                while (j < n && datos[j] == c) j++;
+                racha += j - i;
+                i = j;
+            } else {
+                cerrarRacha();
+                simbolo(bits, c);
+                ultimo = c;
+                i++;
+            }
+        }
+        for (size_t k = 0; k < n;) {
+            size_t fin = std::min(n, k + 5552);
+            for (; k < fin; ++k) {
+                s1 += datos[k];
+                s2 += s1;
+            }
+            s1 %= 65521;
+            s2 %= 65521;
+        }
+    }
+
+    // Agregar n veces el byte c sin recorrerlas
+    void repetir(uint8_t c, size_t n) {
+        if (n == 0) return;
+        if (c != ultimo) {
+            agregar(&c, 1);
+            n--;
+        }
+        racha += n;
+        uint64_t m = n % 65521;
+        s2 = static_cast<uint32_t>((s2 + m * s1 + c * (m * (m + 1) / 2 % 65521)) % 65521);
+        s1 = static_cast<uint32_t>((s1 + m * c) % 65521);
+    }
+
+    void terminar() {
+        cerrarRacha();
+        simbolo(bits, 256);
+        bits.terminar();
+        uint32_t adler = (s2 << 16) | s1;
+        for (int d = 24; d >= 0; d -= 8) salida.push_back(static_cast<uint8_t>(adler >> d));
+    }
+
+private:
+    std::vector<uint8_t>& salida;
+    Bits bits;
+    int ultimo;       // Último byte emitido (-1 al principio)
+    size_t racha;     // Repeticiones de "ultimo" aún sin emitir
+    uint32_t s1, s2;  // Sumas de Adler-32
+
+    void cerrarRacha() {
+        while (racha > 258) {
+            copia(bits, 258);
+            racha -= 258;
+        }
+        if (racha >= 3) {
+            copia(bits, static_cast<int>(racha));
+        } else {
+            for (size_t k = 0; k < racha; ++k) simbolo(bits, ultimo);
+        }
+        racha = 0;
+    }
+};
+
+inline void bloque(std::ofstream& archivo, const char* tipo, const std::vector<uint8_t>& datos) {
+    uint8_t cabecera[8];
+    uint32_t largo = static_cast<uint32_t>(datos.size());
+    for (int d = 0; d < 4; ++d) cabecera[d] = static_cast<uint8_t>(largo >> (24 - 8 * d));
+    std::copy(tipo, tipo + 4, cabecera + 4);
+    uint32_t crc = crc32(cabecera + 4, 4);
+    crc = crc32(datos.data(), datos.size(), crc);
+    uint8_t cola[4];
+    for (int d = 0; d < 4; ++d) cola[d] = static_cast<uint8_t>(crc >> (24 - 8 * d));
+    archivo.write(reinterpret_cast<const char*>(cabecera), 8);
+    archivo.write(reinterpret_cast<const char*>(datos.data()), static_cast<std::streamsize>(datos.size()));
+    archivo.write(reinterpret_cast<const char*>(cola), 4);
+}
+
+// Guarda imágenes RGB (3 bytes por pixel, fila por fila). Conserva sus
+// buffers entre imágenes para no pedir memoria en cada tesela.
+class CodificadorPNG {
+public:
+    void escribir(const std::string& ruta, int ancho, int alto, const std::vector<uint8_t>& rgb) {
+        std::ofstream archivo(ruta, std::ios::binary);
+        if (!archivo.is_open()) {
+            throw std::runtime_error("No se pudo crear el archivo: " + ruta);
+        }
+        static const uint8_t firma[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        archivo.write(reinterpret_cast<const char*>(firma), sizeof(firma));
+
+        std::vector<uint8_t> ihdr(13, 0);
+        for (int d = 0; d < 4; ++d) {
+            ihdr[d] = static_cast<uint8_t>(ancho >> (24 - 8 * d));
+            ihdr[4 + d] = static_cast<uint8_t>(alto >> (24 - 8 * d));
+        }
+        ihdr[8] = 8; // Bits por canal
+        ihdr[9] = 2; // RGB
+        bloque(archivo, "IHDR", ihdr);
+
+        // Filtrar cada fila: Up (2) si es igual a la anterior, Sub (1) si no
+        size_t paso = static_cast<size_t>(ancho) * 3;
+        fila.resize(paso + 1);
+        comprimido.clear();
+        Deflate deflate(comprimido);
+        for (int y = 0; y < alto; ++y) {
+            const uint8_t* actual = rgb.data() + y * paso;
+            if (y > 0 && std::memcmp(actual, actual - paso, paso) == 0) {
+                const uint8_t up = 2;
+                deflate.agregar(&up, 1);
+                deflate.repetir(0, paso);
+                continue;
+            }
+            fila[0] = 1;
+            for (size_t i = 0; i < paso; ++i) {
+                fila[1 + i] = static_cast<uint8_t>(actual[i] - (i >= 3 ? actual[i - 3] : 0));
+            }
+            deflate.agregar(fila.data(), fila.size());
+        }
+        deflate.terminar();
+        bloque(archivo, "IDAT", comprimido);
+        bloque(archivo, "IEND", std::vector<uint8_t>());
+        if (!archivo) {
+            throw std::runtime_error("Error al escribir el archivo: " + ruta);
+        }
+    }
+
+private:
+    std::vector<uint8_t> fila;
+    std::vector<uint8_t> comprimido;
+};
+
+} // namespace png
+
+// ------------------------------------------------------------
+// Exportador del diagrama de Gantt a imagen
+// ------------------------------------------------------------
+
+struct OpcionesImagen {
+    double pixelesPorCiclo = 1.0;
+    int altoFila = 16;
+    int tesela = 2048;      // Lado máximo de cada tesela PNG, en pixeles
+    unsigned hilos = 1;
+};
+
+// Dibuja el diagrama de Gantt sin la interfaz gráfica, como SVG o como
+// teselas PNG, con las mismas filas (una por algoritmo y proceso) y
+// colores que la interfaz. Recibe los eventos durante la simulación y los
+// guarda en formato compacto, repartidos por bandas de filas (la altura
+// de una tesela) en un archivo temporal. Al exportar, cada banda se carga
+// sola, así que la memoria depende de la banda más densa y no del
+// diagrama completo; las teselas se dibujan en paralelo.
+class ExportadorImagen : public ReceptorEventos {
+public:
+    ExportadorImagen(CargaCompartida cargaProcesos, const OpcionesImagen& op)
+        : carga(std::move(cargaProcesos)), opciones(op), grupoActual(-1), maxFin(0),
+          enMemoria(0), temporal(std::tmpfile(), &std::fclose) {
+        if (!temporal) {
+            throw std::runtime_error("No se pudo crear el archivo temporal de la imagen");
+        }
+        if (opciones.pixelesPorCiclo <= 0 || opciones.altoFila < 4 || opciones.tesela < 16) {
+            throw std::runtime_error("Opciones de imagen inválidas");
+        }
+        for (size_t i = 0; i < carga->size(); ++i) {
+            indiceProceso[(*carga)[i].pid] = static_cast<int>(i);
+        }
+    }
+
+    ExportadorImagen(const ExportadorImagen&) = delete;
+    ExportadorImagen& operator=(const ExportadorImagen&) = delete;
+
+    // Nuevo grupo de filas (p. ej. un algoritmo)
+    void iniciarGrupo(const std::string& nombre) {
+        grupos.push_back(nombre);
+        grupoActual = static_cast<int>(grupos.size()) - 1;
+    }
+
+    void alEvento(const EventoGantt& e) override {
+        if (grupoActual < 0) iniciarGrupo("Simulación");
+        auto it = indiceProceso.find(e.pid);
+        if (it == indiceProceso.end()) return;
+
+        Tramo t;
+        t.inicio = e.inicio;
+        t.fin = e.fin;
+        t.fila = static_cast<int32_t>(grupoActual * static_cast<int>(carga->size()) + it->second);
+        t.estado = e.estado == "WAITING" ? ESPERA : e.estado == "ACCESSED" ? ACCESO :
+                   e.estado == "OVERHEAD" ? SOBRECARGA : e.estado == "IO" ? ENTRADA_SALIDA : EJECUCION;
+        maxFin = std::max(maxFin, e.fin);
+
+        size_t banda = static_cast<size_t>(t.fila / filasPorBanda());
+        if (banda >= pendientes.size()) pendientes.resize(banda + 1);
+        pendientes[banda].push_back(t);
+        if (++enMemoria >= LIMITE_EN_MEMORIA) volcar();
+    }
+
+    // Escribe las teselas como prefijo-<banda>-<columna>.png y devuelve
+    // cuántas escribió
+    size_t escribirPNG(const std::string& prefijo) {
+        volcar();
+        const int anchoTotal = anchoImagen();
+        const int columnas = (anchoTotal + opciones.tesela - 1) / opciones.tesela;
+        const size_t bandas = numBandas();
+        const size_t total = bandas * static_cast<size_t>(columnas);
+
+        std::mutex mutex;
+        std::map<size_t, std::shared_ptr<Banda>> cargadas;
+        std::atomic<size_t> siguiente(0);
+        std::exception_ptr error;
+
+        auto trabajador = [&]() {
+            Lienzo lienzo;
+            for (size_t k = siguiente++; k < total; k = siguiente++) {
+                size_t b = k / columnas;
+                int c = static_cast<int>(k % columnas);
+                try {
+                    std::shared_ptr<Banda> banda;
+                    {
+                        // La primera tesela de cada banda la carga; la
+                        // última la libera
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (error) return;
+                        auto it = cargadas.find(b);
+                        if (it == cargadas.end()) {
+                            it = cargadas.emplace(b, cargarBanda(b)).first;
+                            it->second->teselasPendientes = columnas;
+                        }
+                        banda = it->second;
+                    }
+                    dibujarTesela(*banda, b, c, anchoTotal, prefijo, lienzo);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (--banda->teselasPendientes == 0) cargadas.erase(b);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error) error = std::current_exception();
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned h = 1; h < opciones.hilos && h < total; ++h) {
+            pool.emplace_back(trabajador);
+        }
+        trabajador();
+        for (auto& t : pool) t.join();
+        if (error) std::rethrow_exception(error);
+        return total;
+    }
+
+    // Escribe un SVG con una etiqueta por fila; se genera banda por banda
+    void escribirSVG(const std::string& ruta) {
+        volcar();
+        std::vector<char> buffer(1 << 20);
+        std::ofstream archivo;
+        archivo.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        archivo.open(ruta);
+        if (!archivo.is_open()) {
+            throw std::runtime_error("No se pudo crear el archivo: " + ruta);
+        }
+
+        const size_t n = carga->size();
+        const int filas = static_cast<int>(grupos.size() * n);
+        const int alto = filas * opciones.altoFila;
+        archivo << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << ANCHO_ETIQUETA + anchoImagen()
+                << "\" height=\"" << alto << "\" font-family=\"monospace\" font-size=\""
+                << std::max(8, opciones.altoFila - 6) << "\">\n"
+                << "<style>line{stroke:#464646}text{fill:#c8c8c8}.W{fill:#c83232;fill-opacity:.8}"
+                << ".A{fill:#32c832;fill-opacity:.8}.O{fill:#e69628;fill-opacity:.8}"
+                << ".E{fill:#5a8cdc;fill-opacity:.8}";
+        for (size_t i = 0; i < n; ++i) {
+            archivo << ".p" << i << "{fill:" << hex(colorDe(static_cast<int>(i))) << "}";
+        }
+        archivo << "</style>\n<rect width=\"100%\" height=\"100%\" fill=\"#1e1e1e\"/>\n";
+
+        for (int f = 0; f < filas; ++f) {
+            double y = (f + 0.5) * opciones.altoFila;
+            archivo << "<line x1=\"" << ANCHO_ETIQUETA << "\" y1=\"" << y << "\" x2=\""
+                    << ANCHO_ETIQUETA + anchoImagen() << "\" y2=\"" << y << "\"/>"
+                    << "<text x=\"2\" y=\"" << y + opciones.altoFila / 2 - 4 << "\">"
+                    << escapar((*carga)[f % n].pid + "|" + grupos[f / n]) << "</text>\n";
+        }
+
+        const double margen = 3;
+        for (size_t b = 0; b < numBandas(); ++b) {
+            std::shared_ptr<Banda> banda = cargarBanda(b);
+            for (int pasada = 0; pasada < 2; ++pasada) {
+                for (const Tramo& t : banda->tramos) {
+                    if (!enPasada(t, pasada)) continue;
+                    double x = ANCHO_ETIQUETA + t.inicio * opciones.pixelesPorCiclo;
+                    double ancho = (t.fin - t.inicio) * opciones.pixelesPorCiclo;
+                    archivo << "<rect class=\"" << clase(t) << "\" x=\"" << x << "\" y=\""
+                            << t.fila * opciones.altoFila + margen << "\" width=\"" << ancho
+                            << "\" height=\"" << opciones.altoFila - 2 * margen << "\"/>\n";
+                }
+            }
+        }
+        archivo << "</svg>\n";
+        archivo.close();
+        if (!archivo) {
+            throw std::runtime_error("Error al escribir el archivo: " + ruta);
+        }
+    }
+
+private:
+    enum EstadoTramo : uint8_t { EJECUCION, ESPERA, ACCESO, SOBRECARGA, ENTRADA_SALIDA };
+
+    struct Tramo {
+        Tiempo inicio;
+        Tiempo fin;
+        int32_t fila;
+        EstadoTramo estado;
+    };
+
+    // Tramos de una banda ordenados por inicio, con el máximo acumulado
+    // de fin (como en LineaTiempo) para encontrar los de cada tesela
+    struct Banda {
+        std::vector<Tramo> tramos;
+        std::vector<Tiempo> maxFin;
+        int teselasPendientes = 0;
+    };
+
+    // Memoria de trabajo de un hilo, reutilizada entre teselas
+    struct Lienzo {
+        std::vector<uint8_t> rgb;
+        png::CodificadorPNG codificador;
+    };
+
+    // Segmento de una banda en el archivo temporal
+    struct Segmento {
+        size_t banda;
+        long desplazamiento;
+        size_t cantidad;
+    };
+
+    static constexpr size_t LIMITE_EN_MEMORIA = 1 << 20; // Tramos antes de volcar
+    static constexpr int ANCHO_ETIQUETA = 80;            // Columna de etiquetas del SVG
+
+    CargaCompartida carga;
+    OpcionesImagen opciones;
+    std::unordered_map<std::string, int> indiceProceso;
+    std::vector<std::string> grupos;
+    int grupoActual;
+    Tiempo maxFin;
+
+    std::vector<std::vector<Tramo>> pendientes; // Por banda, aún sin volcar
+    size_t enMemoria;
+    std::unique_ptr<FILE, int (*)(FILE*)> temporal;
+    std::vector<Segmento> segmentos;
+
+    int filasPorBanda() const { return std::max(1, opciones.tesela / opciones.altoFila); }
+
+    size_t numBandas() const {
+        size_t filas = grupos.size() * carga->size();
+        return (filas + filasPorBanda() - 1) / filasPorBanda();
+    }
+
+    int anchoImagen() const {
+        double ancho = std::ceil(static_cast<double>(maxFin) * opciones.pixelesPorCiclo) + 1;
+        if (ancho > INT32_MAX / 4) {
+            throw std::runtime_error("La imagen es demasiado ancha; reduzca la escala");
+        }
+        return static_cast<int>(ancho);
+    }
+
+    void volcar() {
+        for (size_t b = 0; b < pendientes.size(); ++b) {
+            std::vector<Tramo>& tramos = pendientes[b];
+            if (tramos.empty()) continue;
+            std::fseek(temporal.get(), 0, SEEK_END);
+            segmentos.push_back({b, std::ftell(temporal.get()), tramos.size()});
+            if (std::fwrite(tramos.data(), sizeof(Tramo), tramos.size(), temporal.get()) != tramos.size()) {
+                throw std::runtime_error("Error al escribir el archivo temporal de la imagen");
+            }
+            tramos.clear();
+            tramos.shrink_to_fit();
+        }
+        enMemoria = 0;
+    }
+
+    std::shared_ptr<Banda> cargarBanda(size_t b) {
+        std::shared_ptr<Banda> banda(new Banda());
+        for (const Segmento& s : segmentos) {
+            if (s.banda != b) continue;
+            size_t inicio = banda->tramos.size();
+            banda->tramos.resize(inicio + s.cantidad);
+            std::fseek(temporal.get(), s.desplazamiento, SEEK_SET);
+            if (std::fread(banda->tramos.data() + inicio, sizeof(Tramo), s.cantidad, temporal.get()) != s.cantidad) {
+                throw std::runtime_error("Error al leer el archivo temporal de la imagen");
+            }
+        }
+        // Orden estable: los tramos de un mismo inicio se dibujan en el
+        // orden en que llegaron, igual que en la interfaz
+        std::stable_sort(banda->tramos.begin(), banda->tramos.end(),
+            [](const Tramo& a, const Tramo& c) { return a.inicio < c.inicio; });
+        banda->maxFin.resize(banda->tramos.size());
+        Tiempo maximo = 0;
+        for (size_t k = 0; k < banda->tramos.size(); ++k) {
+            maximo = std::max(maximo, banda->tramos[k].fin);
+            banda->maxFin[k] = maximo;
+        }
+        return banda;
+    }
+
+    void dibujarTesela(const Banda& banda, size_t b, int columna, int anchoTotal, const std::string& prefijo,
+                       Lienzo& lienzo) const {
+        const int primeraFila = static_cast<int>(b) * filasPorBanda();
+        const int filas = std::min(filasPorBanda(), static_cast<int>(grupos.size() * carga->size()) - primeraFila);
+        const int x0 = columna * opciones.tesela;
+        const int ancho = std::min(opciones.tesela, anchoTotal - x0);
+        const int alto = filas * opciones.altoFila;
+        const double ppc = opciones.pixelesPorCiclo;
+
+        std::vector<uint8_t>& rgb = lienzo.rgb;
+        rgb.assign(static_cast<size_t>(ancho) * alto * 3, 30);
+        auto rellenar = [&](int xa, int xb, int ya, int yb, uint32_t color) {
+            xa = std::max(xa, 0);
+            xb = std::min(xb, ancho);
+            for (int y = ya; y < yb; ++y) {
+                uint8_t* p = rgb.data() + (static_cast<size_t>(y) * ancho + xa) * 3;
+                for (int x = xa; x < xb; ++x, p += 3) {
+                    p[0] = static_cast<uint8_t>(color >> 16);
+                    p[1] = static_cast<uint8_t>(color >> 8);
+                    p[2] = static_cast<uint8_t>(color);
+                }
+            }
+        };
+
+        // Línea de cada fila
+        for (int f = 0; f < filas; ++f) {
+            int y = f * opciones.altoFila + opciones.altoFila / 2;
+            rellenar(0, ancho, y, y + 1, 0x464646);
+        }
+
+        // Tramos que tocan los ciclos de la tesela; cada uno mide al menos
+        // un pixel para que los cortos no desaparezcan
+        Tiempo desde = static_cast<Tiempo>(std::floor(x0 / ppc));
+        Tiempo hasta = static_cast<Tiempo>(std::ceil((x0 + ancho) / ppc)) + 1;
+        size_t primero = std::upper_bound(banda.maxFin.begin(), banda.maxFin.end(), desde) - banda.maxFin.begin();
+        const int margen = std::max(1, opciones.altoFila / 5);
+        for (int pasada = 0; pasada < 2; ++pasada) {
+            for (size_t k = primero; k < banda.tramos.size(); ++k) {
+                const Tramo& t = banda.tramos[k];
+                if (t.inicio >= hasta) break;
+                if (!enPasada(t, pasada)) continue;
+                long long xa = static_cast<long long>(std::floor(t.inicio * ppc)) - x0;
+                long long xb = std::max(xa + 1, static_cast<long long>(std::floor(t.fin * ppc)) - x0);
+                if (xb <= 0 || xa >= ancho) continue;
+                int y = (t.fila - primeraFila) * opciones.altoFila;
+                rellenar(static_cast<int>(std::max(xa, -1LL)), static_cast<int>(std::min<long long>(xb, ancho)),
+                         y + margen, y + opciones.altoFila - margen, colorTramo(t));
+            }
+        }
+
+        lienzo.codificador.escribir(prefijo + "-" + std::to_string(b) + "-" + std::to_string(columna) + ".png", ancho, alto, rgb);
+    }
+
+    // La ejecución se dibuja primero y la espera y los accesos encima,
+    // porque un acceso comparte sus ciclos con un tramo de ejecución
+    static bool enPasada(const Tramo& t, int pasada) {
+        return (t.estado == EJECUCION) == (pasada == 0);
+    }
+
+    // Mismo color por PID que la interfaz (ColorFromPID en main.cpp)
+    uint32_t colorDe(int proceso) const {
+        size_t h = std::hash<std::string>()((*carga)[proceso].pid);
+        return static_cast<uint32_t>(h & 0xFFFFFF);
+    }
+
+    uint32_t colorTramo(const Tramo& t) const {
+        // Espera y acceso se mezclan con el fondo como en la interfaz (alfa 200)
+        if (t.estado == ESPERA) return 0xA32E2E;
+        if (t.estado == ACCESO) return 0x2EA32E;
+        if (t.estado == SOBRECARGA) return 0xBB7C26;
+        if (t.estado == ENTRADA_SALIDA) return 0x4D74B3;
+        return colorDe(t.fila % static_cast<int>(carga->size()));
+    }
+
+    std::string clase(const Tramo& t) const {
+        if (t.estado == ESPERA) return "W";
+        if (t.estado == ACCESO) return "A";
+        if (t.estado == SOBRECARGA) return "O";
+        if (t.estado == ENTRADA_SALIDA) return "E";
+        return "p" + std::to_string(t.fila % static_cast<int>(carga->size()));
+    }
+
+    static std::string hex(uint32_t color) {
+        char texto[8];
+        std::snprintf(texto, sizeof(texto), "#%06x", color & 0xFFFFFF);
+        return texto;
+    }
+
+    static std::string escapar(const std::string& texto) {
+        std::string salida;
+        for (char c : texto) {
+            if (c == '<') salida += "&lt;";
+            else if (c == '>') salida += "&gt;";
+            else if (c == '&') salida += "&amp;";
+            else salida += c;
+        }
+        return salida;
+    }
+};
+
+#endif
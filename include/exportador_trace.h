@@ -0,0 +1,158 @@
+#ifndef EXPORTADOR_TRACE_H
+#define EXPORTADOR_TRACE_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <stdexcept>
+#include "receptor_eventos.h"
+
+// Exporta la simulación en formato Chrome Trace Event (JSON), legible por
+// chrome://tracing y Perfetto. Escribe a medida que recibe los eventos,
+// de modo que la memoria depende del número de procesos y recursos, no
+// del tamaño del diagrama. 1 ciclo se representa como 1 microsegundo.
+//
+// Cada llamada a iniciarGrupo abre un "proceso" del trace (por ejemplo,
+// uno por algoritmo) con un hilo por PID. Los recursos van en un grupo
+// propio con un contador de permisos disponibles por recurso.
+class ExportadorTrace : public ReceptorEventos {
+public:
+    explicit ExportadorTrace(const std::string& ruta)
+        : buffer(1 << 20) {
+        archivo.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        archivo.open(ruta);
+        if (!archivo.is_open()) {
+            throw std::runtime_error("No se pudo crear el archivo: " + ruta);
+        }
+        archivo << "{\"traceEvents\":[\n";
+    }
+
+    ~ExportadorTrace() override { cerrar(); }
+
+    // Abrir un nuevo grupo de hilos (p. ej. "FIFO", "RR")
+    void iniciarGrupo(const std::string& nombre) {
+        volcarPendientes();
+        grupoActual = ++ultimoGrupo;
+        hilos.clear();
+        escribirMetadato("process_name", grupoActual, 0, nombre);
+    }
+
+    void alEvento(const EventoGantt& evento) override {
+        if (grupoActual == 0) iniciarGrupo("Simulación");
+
+        // Fusionar tramos contiguos del mismo PID y estado
+        auto clave = std::make_pair(evento.pid, evento.estado);
+        auto it = pendientes.find(clave);
+        if (it != pendientes.end()) {
+            if (it->second.fin == evento.inicio) {
+                it->second.fin = evento.fin;
+                return;
+            }
+            escribirTramo(it->second);
+            it->second = evento;
+            return;
+        }
+        pendientes.emplace(clave, evento);
+    }
+
+    void alRecurso(const std::string& recurso, const std::string& pid,
+                   Tiempo ciclo, int disponibles, bool adquirido) override {
+        if (grupoRecursos == 0) {
+            grupoRecursos = ++ultimoGrupo;
+            escribirMetadato("process_name", grupoRecursos, 0, "Recursos");
+        }
+        int tid = hiloRecurso(recurso);
+        separar();
+        archivo << "{\"name\":\"" << escapar(recurso) << "\",\"ph\":\"C\",\"ts\":" << ciclo
+                << ",\"pid\":" << grupoRecursos << ",\"args\":{\"disponibles\":" << disponibles << "}}";
+        separar();
+        archivo << "{\"name\":\"" << (adquirido ? "adquirir " : "liberar ") << escapar(pid)
+                << "\",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << ciclo
+                << ",\"pid\":" << grupoRecursos << ",\"tid\":" << tid << "}";
+    }
+
+    // Cerrar el documento JSON; se llama también desde el destructor
+    void cerrar() {
+        if (!archivo.is_open()) return;
+        volcarPendientes();
+        archivo << "\n]}\n";
+        archivo.close();
+    }
+
+private:
+    std::vector<char> buffer;
+    std::ofstream archivo;
+    bool primero = true;
+
+    int ultimoGrupo = 0;
+    int grupoActual = 0;
+    int grupoRecursos = 0;
+    std::unordered_map<std::string, int> hilos;
+    std::unordered_map<std::string, int> hilosRecurso;
+
+    // Último tramo abierto por (PID, estado)
+    std::map<std::pair<std::string, std::string>, EventoGantt> pendientes;
+
+    void separar() {
+        if (!primero) archivo << ",\n";
+        primero = false;
+    }
+
+    int hiloProceso(const std::string& pid) {
+        auto it = hilos.find(pid);
+        if (it != hilos.end()) return it->second;
+        int tid = static_cast<int>(hilos.size()) + 1;
+        hilos[pid] = tid;
+        escribirMetadato("thread_name", grupoActual, tid, pid);
+        return tid;
+    }
+
+    int hiloRecurso(const std::string& recurso) {
+        auto it = hilosRecurso.find(recurso);
+        if (it != hilosRecurso.end()) return it->second;
+        int tid = static_cast<int>(hilosRecurso.size()) + 1;
+        hilosRecurso[recurso] = tid;
+        escribirMetadato("thread_name", grupoRecursos, tid, recurso);
+        return tid;
+    }
+
+    void escribirTramo(const EventoGantt& e) {
+        int tid = hiloProceso(e.pid);
+        separar();
+        archivo << "{\"name\":\"" << escapar(e.pid) << "\",\"cat\":\"" << escapar(e.estado)
+                << "\",\"ph\":\"X\",\"ts\":" << e.inicio << ",\"dur\":" << (e.fin - e.inicio)
+                << ",\"pid\":" << grupoActual << ",\"tid\":" << tid << "}";
+    }
+
+    void escribirMetadato(const char* tipo, int pid, int tid, const std::string& nombre) {
+        separar();
+        archivo << "{\"name\":\"" << tipo << "\",\"ph\":\"M\",\"pid\":" << pid
+                << ",\"tid\":" << tid << ",\"args\":{\"name\":\"" << escapar(nombre) << "\"}}";
+    }
+
+    void volcarPendientes() {
+        for (const auto& par : pendientes) {
+            escribirTramo(par.second);
+        }
+        pendientes.clear();
+    }
+
+    static std::string escapar(const std::string& texto) {
+        std::string salida;
+        for (char c : texto) {
+            if (c == '"' || c == '\\') {
+                salida += '\\';
+                salida += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                salida += ' ';
+            } else {
+                salida += c;
+            }
+        }
+        return salida;
+    }
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef GENERADOR_CARGAS_H
+#define GENERADOR_CARGAS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <stdexcept>
+#include "estructuras.h"
+
+// ------------------------------------------------------------
+// Generación de cargas de trabajo sintéticas
+// ------------------------------------------------------------
+// Las cargas se generan por bloques de tamaño fijo. Cada bloque usa su
+// propio generador derivado de (semilla, índice de bloque), así que el
+// resultado depende solo de la semilla y de la especificación, nunca del
+// número de hilos ni del orden en que se procesan los bloques.
+
+// SplitMix64: rápido, con estado de 64 bits y fácil de derivar por bloque.
+// Se implementa aquí (en lugar de usar <random>) para que la secuencia sea
+// idéntica con cualquier biblioteca estándar.
+class GeneradorAleatorio {
+public:
+    explicit GeneradorAleatorio(uint64_t semilla) : estado(semilla) {}
+
+    // Generador independiente para el bloque/réplica "indice"
+    static GeneradorAleatorio derivar(uint64_t semilla, uint64_t indice) {
+        GeneradorAleatorio base(semilla ^ (indice * 0xD1B54A32D192ED03ULL));
+        return GeneradorAleatorio(base.siguiente());
+    }
+
+    uint64_t siguiente() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Real uniforme en [0, 1)
+    double uniforme01() {
+        return static_cast<double>(siguiente() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Entero uniforme en [a, b]
+    long long entero(long long a, long long b) {
+        if (b <= a) return a;
+        uint64_t rango = static_cast<uint64_t>(b - a) + 1;
+        return a + static_cast<long long>(siguiente() % rango);
+    }
+
+private:
+    uint64_t estado;
+};
+
+// Distribución discreta de enteros no negativos, descrita como texto:
+//   fija:v                 siempre v
+//   uniforme:a:b           uniforme en [a, b]
+//   exponencial:m          exponencial de media m (llegadas de Poisson)
+//   bimodal:a:b:p          a con probabilidad p, b en otro caso (ráfagas)
+struct Distribucion {
+    enum Tipo { FIJA, UNIFORME, EXPONENCIAL, BIMODAL };
+
+    Tipo tipo = FIJA;
+    double a = 0, b = 0, p = 0;
+
+    long long muestrear(GeneradorAleatorio& rng) const {
+        switch (tipo) {
+            case FIJA:
+                return static_cast<long long>(a);
+            case UNIFORME:
+                return rng.entero(static_cast<long long>(a), static_cast<long long>(b));
+            case EXPONENCIAL:
+                return static_cast<long long>(-a * std::log(1.0 - rng.uniforme01()));
+            case BIMODAL:
+                return static_cast<long long>(rng.uniforme01() < p ? a : b);
+        }
+        return 0;
+    }
+
+    static Distribucion parsear(const std::string& texto) {
+        std::vector<std::string> partes = separar(texto, ':');
+        Distribucion d;
+        try {
+            if (partes[0] == "fija" && partes.size() == 2) {
+                d.tipo = FIJA;
+                d.a = std::stod(partes[1]);
+            } else if (partes[0] == "uniforme" && partes.size() == 3) {
+                d.tipo = UNIFORME;
+                d.a = std::stod(partes[1]);
+                d.b = std::stod(partes[2]);
+            } else if (partes[0] == "exponencial" && partes.size() == 2) {
+                d.tipo = EXPONENCIAL;
+                d.a = std::stod(partes[1]);
+            } else if (partes[0] == "bimodal" && partes.size() == 4) {
+                d.tipo = BIMODAL;
+                d.a = std::stod(partes[1]);
+                d.b = std::stod(partes[2]);
+                d.p = std::stod(partes[3]);
+            } else {
+                throw std::runtime_error("");
+            }
+        } catch (const std::exception&) {
+            throw std::runtime_error("Distribución inválida: " + texto);
+        }
+        return d;
+    }
+
+    static std::vector<std::string> separar(const std::string& texto, char separador) {
+        std::vector<std::string> partes;
+        std::stringstream ss(texto);
+        std::string parte;
+        while (std::getline(ss, parte, separador)) {
+            partes.push_back(parte);
+        }
+        if (partes.empty()) partes.push_back("");
+        return partes;
+    }
+};
+
+// Mezcla de prioridades con pesos, p. ej. "1:1,2:3,3:1"
+struct MezclaPrioridades {
+    std::vector<int> prioridades = {1, 2, 3, 4, 5};
+    std::vector<double> acumulado = {0.2, 0.4, 0.6, 0.8, 1.0};
+
+    int muestrear(GeneradorAleatorio& rng) const {
+        double u = rng.uniforme01();
+        for (size_t i = 0; i < acumulado.size(); ++i) {
+            if (u < acumulado[i]) return prioridades[i];
+        }
+        return prioridades.back();
+    }
+
+    static MezclaPrioridades parsear(const std::string& texto) {
+        MezclaPrioridades m;
+        m.prioridades.clear();
+        m.acumulado.clear();
+        double total = 0;
+        for (const auto& par : Distribucion::separar(texto, ',')) {
+            std::vector<std::string> kv = Distribucion::separar(par, ':');
+            if (kv.size() != 2) {
+                throw std::runtime_error("Mezcla de prioridades inválida: " + texto);
+            }
+            m.prioridades.push_back(std::stoi(kv[0]));
+            total += std::stod(kv[1]);
+            m.acumulado.push_back(total);
+        }
+        if (total <= 0) {
+            throw std::runtime_error("Mezcla de prioridades inválida: " + texto);
+        }
+        for (auto& a : m.acumulado) a /= total;
+        return m;
+    }
+};
+
+struct EspecificacionCarga {
+    long long procesos = 1000;
+    Distribucion llegadas = Distribucion::parsear("exponencial:4"); // Separación entre llegadas
+    Distribucion rafagas = Distribucion::parsear("uniforme:1:20");  // Burst time
+    MezclaPrioridades prioridades;
+    int recursos = 4;                // Mitad mutex, mitad semáforos
+    int contadorMaximo = 3;          // Contador máximo de los semáforos
+    double densidadAcciones = 0.1;   // Acciones esperadas por ciclo de CPU
+    long long tamanoBloque = 65536;  // Procesos por bloque (afecta la secuencia)
+};
+
+// Contenido de un bloque antes de convertirlo a texto. Las llegadas son
+// relativas al inicio del bloque; el desplazamiento se conoce después de
+// generar los bloques anteriores (suma de prefijos).
+struct BloqueCarga {
+    long long primerIndice = 0;
+    std::vector<long long> llegadaRelativa;
+    std::vector<long long> rafaga;
+    std::vector<int> prioridad;
+    long long duracion = 0; // Suma de separaciones del bloque
+
+    // Acciones por proceso: offsets en formato CSR sobre los arreglos
+    std::vector<long long> inicioAcciones;
+    std::vector<long long> cicloAccion;
+    std::vector<int> recursoAccion;
+    std::vector<char> escrituraAccion;
+};
+
+// Aplicar una opción de línea de comandos a la especificación; devuelve
+// false si la opción no es de carga. "valor" lee el argumento siguiente.
+template <class LeerValor>
+bool aplicarOpcionCarga(EspecificacionCarga& spec, const std::string& arg, LeerValor valor) {
+    if (arg == "--llegadas") spec.llegadas = Distribucion::parsear(valor());
+    else if (arg == "--rafagas") spec.rafagas = Distribucion::parsear(valor());
+    else if (arg == "--prioridades") spec.prioridades = MezclaPrioridades::parsear(valor());
+    else if (arg == "--recursos") spec.recursos = std::stoi(valor());
+    else if (arg == "--contador-max") {
+        spec.contadorMaximo = std::stoi(valor());
+        if (spec.contadorMaximo < 1) {
+            throw std::runtime_error("El contador máximo debe ser al menos 1");
+        }
+    }
+    else if (arg == "--densidad") spec.densidadAcciones = std::stod(valor());
+    else if (arg == "--bloque") spec.tamanoBloque = std::max(1LL, std::stoll(valor()));
+    else return false;
+    return true;
+}
+
+inline std::string nombreRecurso(const EspecificacionCarga& spec, int r) {
+    // Los primeros recursos son mutex; el resto, semáforos
+    int mutexes = (spec.recursos + 1) / 2;
+    return r < mutexes ? "mutex" + std::to_string(r + 1)
+                       : "semaforo" + std::to_string(r - mutexes + 1);
+}
+
+// Contador de cada recurso: 1 para los mutex; los semáforos reparten los
+// valores de 2 a contadorMaximo (con contadorMaximo 1, todos valen 1)
+inline int contadorRecurso(const EspecificacionCarga& spec, int r) {
+    int mutexes = (spec.recursos + 1) / 2;
+    if (r < mutexes) return 1;
+    return std::min(spec.contadorMaximo, 2 + (r % std::max(1, spec.contadorMaximo - 1)));
+}
+
+inline BloqueCarga generarBloque(const EspecificacionCarga& spec, uint64_t semilla, long long bloque) {
+    GeneradorAleatorio rng = GeneradorAleatorio::derivar(semilla, static_cast<uint64_t>(bloque));
+    BloqueCarga b;
+    b.primerIndice = bloque * spec.tamanoBloque;
+    long long cantidad = std::min(spec.tamanoBloque, spec.procesos - b.primerIndice);
+    if (cantidad <= 0) return b;
+
+    b.llegadaRelativa.reserve(cantidad);
+    b.rafaga.reserve(cantidad);
+    b.prioridad.reserve(cantidad);
+    b.inicioAcciones.reserve(cantidad + 1);
+    b.inicioAcciones.push_back(0);
+
+    // Para ordenar las acciones de cada proceso (se reutilizan entre procesos)
+    std::vector<std::pair<long long, long long>> orden;
+    std::vector<int> recursos;
+    std::vector<char> escrituras;
+
+    for (long long i = 0; i < cantidad; ++i) {
+        long long separacion = std::max(0LL, spec.llegadas.muestrear(rng));
+        if (b.primerIndice + i == 0) separacion = 0; // El primer proceso llega en 0
+        b.duracion += separacion;
+        b.llegadaRelativa.push_back(b.duracion);
+
+        long long bt = std::max(1LL, spec.rafagas.muestrear(rng));
+        b.rafaga.push_back(bt);
+        b.prioridad.push_back(spec.prioridades.muestrear(rng));
+
+        // Número de acciones ~ densidad * BT, con redondeo aleatorio
+        if (spec.recursos > 0 && spec.densidadAcciones > 0) {
+            double esperado = spec.densidadAcciones * static_cast<double>(bt);
+            long long n = static_cast<long long>(esperado);
+            if (rng.uniforme01() < esperado - static_cast<double>(n)) n++;
+            n = std::min(n, bt);
+            size_t desde = b.cicloAccion.size();
+            for (long long k = 0; k < n; ++k) {
+                b.cicloAccion.push_back(rng.entero(0, bt - 1));
+                b.recursoAccion.push_back(static_cast<int>(rng.entero(0, spec.recursos - 1)));
+                b.escrituraAccion.push_back(rng.uniforme01() < 0.5);
+            }
+            // Ordenar por ciclo las acciones del proceso, O(n log n): con
+            // densidad alta son tantas como ciclos de su ráfaga. El índice
+            // desempata, así las del mismo ciclo conservan su orden.
+            orden.clear();
+            for (long long k = 0; k < n; ++k) {
+                orden.emplace_back(b.cicloAccion[desde + static_cast<size_t>(k)], k);
+            }
+            std::sort(orden.begin(), orden.end());
+            recursos.assign(b.recursoAccion.begin() + static_cast<std::ptrdiff_t>(desde), b.recursoAccion.end());
+            escrituras.assign(b.escrituraAccion.begin() + static_cast<std::ptrdiff_t>(desde), b.escrituraAccion.end());
+            for (long long k = 0; k < n; ++k) {
+                size_t destino = desde + static_cast<size_t>(k);
+                size_t origen = static_cast<size_t>(orden[static_cast<size_t>(k)].second);
+                b.cicloAccion[destino] = orden[static_cast<size_t>(k)].first;
+                b.recursoAccion[destino] = recursos[origen];
+                b.escrituraAccion[destino] = escrituras[origen];
+            }
+        }
+        b.inicioAcciones.push_back(static_cast<long long>(b.cicloAccion.size()));
+    }
+    return b;
+}
+
+inline long long numeroBloques(const EspecificacionCarga& spec) {
+    return (spec.procesos + spec.tamanoBloque - 1) / spec.tamanoBloque;
+}
+
+// Generar la carga completa en memoria (cargas pequeñas o experimentos)
+inline std::vector<Proceso> generarProcesos(const EspecificacionCarga& spec, uint64_t semilla) {
+    std::vector<Proceso> procesos;
+    procesos.reserve(static_cast<size_t>(spec.procesos));
+    long long desplazamiento = 0;
+    for (long long k = 0; k < numeroBloques(spec); ++k) {
+        BloqueCarga b = generarBloque(spec, semilla, k);
+        for (size_t i = 0; i < b.rafaga.size(); ++i) {
+            procesos.push_back(Proceso("P" + std::to_string(b.primerIndice + i + 1),
+                                       b.rafaga[i],
+                                       desplazamiento + b.llegadaRelativa[i],
+                                       b.prioridad[i]));
+        }
+        desplazamiento += b.duracion;
+    }
+    return procesos;
+}
+
+#endif
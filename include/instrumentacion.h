@@ -0,0 +1,120 @@
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#include <chrono>
+
+// ------------------------------------------------------------
+// Instrumentación de los simuladores
+// ------------------------------------------------------------
+// Contadores y temporizadores por fase del ciclo de simulación. Solo se
+// compilan si se define SIMULADOR_INSTRUMENTACION (ver Makefile); sin esa
+// bandera las macros no generan código y las estadísticas quedan en cero.
+
+enum FaseSimulacion {
+    FASE_ADMISION,       // Mover llegadas a la cola de listos
+    FASE_SELECCION,      // Expropiación y elección del siguiente proceso
+    FASE_EMISION,        // Retener eventos y entregarlos al receptor
+    FASE_SINCRONIZACION, // Posproceso de recursos y acciones
+    NUM_FASES
+};
+
+inline const char* nombreFase(int fase) {
+    switch (fase) {
+        case FASE_ADMISION:       return "Admisión";
+        case FASE_SELECCION:      return "Selección";
+        case FASE_EMISION:        return "Emisión de eventos";
+        case FASE_SINCRONIZACION: return "Sincronización";
+    }
+    return "?";
+}
+
+struct Estadisticas {
+    long long despachos = 0;
+    long long expropiaciones = 0;
+    long long eventosEmitidos = 0;
+    long long busquedasRecurso = 0;
+    long long nanosFase[NUM_FASES] = {};
+    long long nanosTotal = 0;
+
+    // Fase en curso; al anidar fases el tiempo se cuenta de forma
+    // exclusiva (la fase externa se pausa mientras corre la interna)
+    int faseActiva = -1;
+    std::chrono::steady_clock::time_point inicioFase;
+
+    void reiniciar() { *this = Estadisticas(); }
+
+    // Sumar las estadísticas de otra corrida (p. ej. varios algoritmos)
+    void acumular(const Estadisticas& otra) {
+        despachos += otra.despachos;
+        expropiaciones += otra.expropiaciones;
+        eventosEmitidos += otra.eventosEmitidos;
+        busquedasRecurso += otra.busquedasRecurso;
+        for (int f = 0; f < NUM_FASES; ++f) {
+            nanosFase[f] += otra.nanosFase[f];
+        }
+        nanosTotal += otra.nanosTotal;
+    }
+};
+
+#ifdef SIMULADOR_INSTRUMENTACION
+
+class TemporizadorFase {
+public:
+    TemporizadorFase(Estadisticas& e, int f) : est(e), fase(f), anterior(e.faseActiva) {
+        auto ahora = std::chrono::steady_clock::now();
+        if (anterior >= 0) {
+            est.nanosFase[anterior] += nanos(ahora - est.inicioFase);
+        }
+        est.faseActiva = fase;
+        est.inicioFase = ahora;
+    }
+
+    ~TemporizadorFase() {
+        auto ahora = std::chrono::steady_clock::now();
+        est.nanosFase[fase] += nanos(ahora - est.inicioFase);
+        est.faseActiva = anterior;
+        est.inicioFase = ahora;
+    }
+
+private:
+    Estadisticas& est;
+    int fase;
+    int anterior;
+
+    static long long nanos(std::chrono::steady_clock::duration d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    }
+};
+
+class TemporizadorTotal {
+public:
+    explicit TemporizadorTotal(Estadisticas& e)
+        : est(e), inicio(std::chrono::steady_clock::now()) {}
+
+    ~TemporizadorTotal() {
+        est.nanosTotal += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+    }
+
+private:
+    Estadisticas& est;
+    std::chrono::steady_clock::time_point inicio;
+};
+
+#define INSTR_CONCAT_(a, b) a##b
+#define INSTR_CONCAT(a, b) INSTR_CONCAT_(a, b)
+#define INSTR_CONTAR(est, campo) (++(est).campo)
+#define INSTR_FASE(est, fase) TemporizadorFase INSTR_CONCAT(instrFase_, __LINE__)((est), (fase))
+#define INSTR_TOTAL(est) TemporizadorTotal INSTR_CONCAT(instrTotal_, __LINE__)(est)
+const bool INSTRUMENTACION_ACTIVA = true;
+
+#else
+
+#define INSTR_CONTAR(est, campo) ((void)0)
+#define INSTR_FASE(est, fase) ((void)0)
+#define INSTR_TOTAL(est) ((void)0)
+const bool INSTRUMENTACION_ACTIVA = false;
+
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef LECTOR_LLEGADAS_H
+#define LECTOR_LLEGADAS_H
+
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include "estructuras.h"
+#include "parser.h"
+
+// Lee procesos de un descriptor de archivo (stdin, una tubería, un FIFO
+// o un archivo) en el formato de procesos.txt, uno por línea, a medida
+// que llegan. Cada llamada a siguiente() bloquea solo hasta completar una
+// línea, así que se puede alimentar con una fuente en vivo. El
+// descriptor no se cierra.
+class LectorLlegadas {
+public:
+    explicit LectorLlegadas(int descriptor)
+        : fd(descriptor), buffer(64 * 1024), inicio(0), fin(0), terminado(false), numeroLinea(0) {}
+
+    // Siguiente proceso; false al llegar al final de la entrada
+    bool siguiente(Proceso& p) {
+        std::string linea;
+        while (leerLinea(linea)) {
+            numeroLinea++;
+            if (!linea.empty() && linea.back() == '\r') linea.pop_back();
+            if (linea.find_first_not_of(' ') == std::string::npos) continue;
+            try {
+                p = Parser::parsearProceso(linea);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Línea " + std::to_string(numeroLinea) +
+                                         " inválida: " + linea);
+            }
+            return true;
+        }
+        return false;
+    }
+
+    long long getNumeroLinea() const { return numeroLinea; }
+
+    // Si quedan bytes leídos sin consumir; si no, la próxima llamada a
+    // siguiente() puede bloquear esperando la entrada
+    bool hayDatosLeidos() const { return inicio < fin; }
+
+private:
+    int fd;
+    std::vector<char> buffer;
+    size_t inicio; // Primer byte sin consumir
+    size_t fin;    // Fin de los bytes leídos
+    bool terminado;
+    long long numeroLinea;
+
+    bool leerLinea(std::string& linea) {
+        linea.clear();
+        while (true) {
+            for (size_t i = inicio; i < fin; ++i) {
+                if (buffer[i] == '\n') {
+                    linea.append(buffer.data() + inicio, i - inicio);
+                    inicio = i + 1;
+                    return true;
+                }
+            }
+            linea.append(buffer.data() + inicio, fin - inicio);
+            inicio = fin = 0;
+            if (terminado) {
+                // Última línea sin salto al final
+                return !linea.empty();
+            }
+
+            ssize_t leidos = ::read(fd, buffer.data(), buffer.size());
+            if (leidos < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error(std::string("Error al leer las llegadas: ") + std::strerror(errno));
+            }
+            if (leidos == 0) {
+                terminado = true;
+            }
+            fin = static_cast<size_t>(leidos);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef LINEA_TIEMPO_H
+#define LINEA_TIEMPO_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <climits>
+#include <map>
+#include <memory>
+#include "estructuras.h"
+#include "almacen_eventos.h"
+#include "simulador_calendarizacion.h"
+
+// ------------------------------------------------------------
+// Índice de la línea de tiempo de un resultado
+// ------------------------------------------------------------
+// Permite saltar a cualquier ciclo (hacia adelante o hacia atrás) sin
+// recorrer los eventos anteriores. Lee los eventos del almacén del
+// resultado (almacen_eventos.h) a medida que se consultan:
+//   - recorrerEn(desde, hasta): eventos que tocan un intervalo, con el
+//     índice de tiempo del almacén;
+//   - estadoEn(i, ciclo): estado y tiempo restante del proceso i, con el
+//     tramo que cubre el ciclo y los ciclos ejecutados antes;
+//   - contarEn(ciclo): procesos llegados, terminados y el que está en CPU.
+// Si el resultado trae los eventos en memoria (p. ej. una simulación
+// remota) se copian a un almacén propio. En memoria solo quedan los
+// índices del almacén y dos columnas por proceso.
+class LineaTiempo {
+public:
+    enum EstadoProceso {
+        NO_LLEGADO,
+        LISTO,
+        EJECUTANDO,
+        ESPERANDO,
+        EN_ES,
+        TERMINADO
+    };
+
+    struct Foto {
+        EstadoProceso estado;
+        Tiempo ejecutado; // Ciclos en CPU antes del ciclo consultado
+        Tiempo restante;
+    };
+
+    struct Conteo {
+        int llegados;
+        int terminados;
+        int enCpu; // Índice del proceso en CPU, o -1 si está libre
+    };
+
+    LineaTiempo() {}
+
+    explicit LineaTiempo(const ResultadoSimulacion& r) { construir(r); }
+
+    void construir(const ResultadoSimulacion& r) {
+        carga = r.carga;
+        if (r.almacen) {
+            almacen = r.almacen;
+        } else {
+            std::shared_ptr<AlmacenEventos> propio = std::make_shared<AlmacenEventos>(*carga);
+            for (const auto& e : r.eventos) {
+                propio->agregar(e);
+            }
+            almacen = propio;
+        }
+
+        llegadasOrdenadas.resize(carga->size());
+        finesOrdenados.resize(carga->size());
+        for (size_t i = 0; i < carga->size(); ++i) {
+            llegadasOrdenadas[i] = (*carga)[i].arrivalTime;
+            finesOrdenados[i] = almacen->finDe(i);
+        }
+        std::sort(llegadasOrdenadas.begin(), llegadasOrdenadas.end());
+        std::sort(finesOrdenados.begin(), finesOrdenados.end());
+    }
+
+    // Llamar a f con cada evento (RegistroEvento) que toca [desde, hasta)
+    template <class F>
+    void recorrerEn(Tiempo desde, Tiempo hasta, F f) const {
+        almacen->recorrerEn(desde, hasta, f);
+    }
+
+    const AlmacenEventos& getAlmacen() const { return *almacen; }
+
+    // Fin del último evento
+    Tiempo getFin() const { return almacen->getMaxFin(); }
+
+    // Estado del proceso i durante el ciclo [ciclo, ciclo + 1)
+    Foto estadoEn(size_t i, Tiempo ciclo) const {
+        const Proceso& p = (*carga)[i];
+        Foto f{NO_LLEGADO, 0, p.burstTime};
+        if (ciclo < p.arrivalTime) return f;
+
+        f.ejecutado = almacen->ejecutadoEn(i, ciclo);
+        f.restante = p.burstTime - f.ejecutado;
+
+        // Los tramos de un proceso solo se superponen en un ciclo con
+        // ACCESSED, que cuenta como ejecución igual que su RUNNING
+        bool cubierto = false;
+        EstadoProceso tipo = LISTO;
+        almacen->recorrerEn(ciclo, ciclo + 1, [&](const RegistroEvento& e) {
+            if (e.proceso == static_cast<int32_t>(i)) {
+                cubierto = true;
+                tipo = clasificar(e.estado);
+            }
+        });
+
+        if (cubierto) {
+            f.estado = tipo;
+        } else if (ciclo >= almacen->finDe(i)) {
+            f.estado = TERMINADO;
+        } else {
+            f.estado = LISTO;
+        }
+        return f;
+    }
+
+    Conteo contarEn(Tiempo ciclo) const {
+        Conteo c;
+        c.llegados = static_cast<int>(std::upper_bound(llegadasOrdenadas.begin(), llegadasOrdenadas.end(), ciclo)
+                                      - llegadasOrdenadas.begin());
+        c.terminados = static_cast<int>(std::upper_bound(finesOrdenados.begin(), finesOrdenados.end(), ciclo)
+                                        - finesOrdenados.begin());
+        c.enCpu = -1;
+        almacen->recorrerEn(ciclo, ciclo + 1, [&c](const RegistroEvento& e) {
+            if (c.enCpu < 0 && e.estado != EVENTO_WAITING && e.estado != EVENTO_IO) {
+                c.enCpu = e.proceso;
+            }
+        });
+        return c;
+    }
+
+    static const char* nombreEstado(EstadoProceso e) {
+        switch (e) {
+            case NO_LLEGADO: return "No llegado";
+            case LISTO:      return "Listo";
+            case EJECUTANDO: return "Ejecutando";
+            case ESPERANDO:  return "Esperando";
+            case EN_ES:      return "En E/S";
+            case TERMINADO:  return "Terminado";
+        }
+        return "?";
+    }
+
+private:
+    static EstadoProceso clasificar(int32_t estado) {
+        if (estado == EVENTO_WAITING) return ESPERANDO;
+        if (estado == EVENTO_IO) return EN_ES;
+        return EJECUTANDO;
+    }
+
+    CargaCompartida carga;
+    std::shared_ptr<const AlmacenEventos> almacen;
+
+    std::vector<Tiempo> llegadasOrdenadas;
+    std::vector<Tiempo> finesOrdenados;   // TIEMPO_MAXIMO si el proceso no tiene tramos
+};
+
+// ------------------------------------------------------------
+// Eje de tiempo con huecos comprimidos
+// ------------------------------------------------------------
+// En trazas dispersas (días en microsegundos con el CPU casi siempre
+// libre) los tramos sin ningún evento dominan el eje. Cada hueco de más
+// de "umbral" ciclos se dibuja con "anchoHueco" unidades de eje; el resto
+// del tiempo conserva la escala 1:1. aEje() y aTiempo() convierten en
+// O(log h), con h el número de huecos.
+class EjeTiempo {
+public:
+    struct Hueco {
+        Tiempo inicio;
+        Tiempo fin;
+        double eje;      // Posición del inicio del hueco en el eje
+    };
+
+    EjeTiempo() : anchoHueco(0) {}
+
+    // Un hueco es una separación de más de "umbral" ciclos entre lo
+    // cubierto por los eventos. Los eventos se leen en orden de emisión:
+    // cada uno se une a "cubierto" extendido en "umbral", así que dos
+    // tramos quedan unidos si los separa a lo sumo el umbral y en memoria
+    // solo hay un intervalo por hueco.
+    void construir(const std::vector<LineaTiempo>& lineas, Tiempo umbral, Tiempo ancho) {
+        anchoHueco = ancho;
+        huecos.clear();
+
+        // Inicio -> fin + umbral de cada intervalo cubierto; desde 0 como
+        // si hubiera un evento vacío en el ciclo 0
+        std::map<Tiempo, Tiempo> cubierto;
+        cubierto[0] = umbral;
+        for (const auto& linea : lineas) {
+            linea.getAlmacen().recorrer([&](const RegistroEvento& e) {
+                unir(cubierto, e.inicio, e.fin + umbral);
+            });
+        }
+
+        double recortado = 0; // Unidades de eje eliminadas hasta ahora
+        for (auto it = cubierto.begin(); std::next(it) != cubierto.end(); ++it) {
+            Tiempo inicio = it->second - umbral;
+            Tiempo fin = std::next(it)->first;
+            huecos.push_back({inicio, fin, static_cast<double>(inicio) - recortado});
+            recortado += static_cast<double>(fin - inicio - anchoHueco);
+        }
+    }
+
+    double aEje(Tiempo t) const {
+        size_t k = ultimoHuecoAntes(t);
+        if (k == 0) return static_cast<double>(t);
+        const Hueco& h = huecos[k - 1];
+        if (t < h.fin) {
+            return h.eje + static_cast<double>(t - h.inicio) * anchoHueco / static_cast<double>(h.fin - h.inicio);
+        }
+        return h.eje + anchoHueco + static_cast<double>(t - h.fin);
+    }
+
+    Tiempo aTiempo(double x) const {
+        auto it = std::upper_bound(huecos.begin(), huecos.end(), x,
+            [](double v, const Hueco& h) { return v < h.eje; });
+        if (it == huecos.begin()) return static_cast<Tiempo>(x);
+        const Hueco& h = *(it - 1);
+        if (x < h.eje + anchoHueco) {
+            return h.inicio + static_cast<Tiempo>((x - h.eje) * static_cast<double>(h.fin - h.inicio) / anchoHueco);
+        }
+        return h.fin + static_cast<Tiempo>(x - h.eje - anchoHueco);
+    }
+
+    // Hueco que contiene a t, o nullptr
+    const Hueco* huecoEn(Tiempo t) const {
+        size_t k = ultimoHuecoAntes(t);
+        if (k == 0 || t >= huecos[k - 1].fin) return nullptr;
+        return &huecos[k - 1];
+    }
+
+    const std::vector<Hueco>& getHuecos() const { return huecos; }
+
+    Tiempo getAnchoHueco() const { return anchoHueco; }
+
+private:
+    static void unir(std::map<Tiempo, Tiempo>& cubierto, Tiempo inicio, Tiempo fin) {
+        auto it = cubierto.upper_bound(inicio);
+        if (it != cubierto.begin() && std::prev(it)->second >= inicio) {
+            --it;
+            if (it->second >= fin) return;
+            inicio = it->first;
+        }
+        while (it != cubierto.end() && it->first <= fin) {
+            fin = std::max(fin, it->second);
+            it = cubierto.erase(it);
+        }
+        cubierto[inicio] = fin;
+    }
+
+    // Número de huecos que empiezan en t o antes
+    size_t ultimoHuecoAntes(Tiempo t) const {
+        return std::upper_bound(huecos.begin(), huecos.end(), t,
+            [](Tiempo v, const Hueco& h) { return v < h.inicio; }) - huecos.begin();
+    }
+
+    std::vector<Hueco> huecos;
+    Tiempo anchoHueco;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <vector>
+#include <cstddef>
+#include <climits>
+#include <algorithm>
+#include "estructuras.h"
+
+// ------------------------------------------------------------
+// Métricas sobre columnas de tiempos
+// ------------------------------------------------------------
+// Las métricas por proceso (espera, respuesta, finalización) se guardan
+// como arreglos contiguos de Tiempo. Los núcleos de este archivo los
+// recorren con varios acumuladores independientes y sin saltos dentro
+// del ciclo, de modo que el compilador los vectoriza con -O3 (mínimo y
+// máximo de 64 bits necesitan SSE4.2 o AVX2: -march=native).
+//
+// La suma no cabe en 64 bits con trazas largas (10^8 procesos de días en
+// microsegundos), así que se acumulan por separado las mitades alta y
+// baja de cada valor y se combinan al final.
+
+struct ResumenColumna {
+    long double suma = 0; // Exacta hasta 2^64
+    Tiempo minimo = 0;
+    Tiempo maximo = 0;
+    double media = 0.0;
+    double varianza = 0.0; // Poblacional
+};
+
+// Número de acumuladores por ciclo: rompe la dependencia entre sumas
+// consecutivas y coincide con el ancho de un registro AVX2 de 64 bits
+const size_t CARRILES_METRICAS = 4;
+
+inline long double sumarColumna(const Tiempo* v, size_t n) {
+    // Cada valor como entero sin signo de 64 bits = alta * 2^32 + baja;
+    // los negativos (p. ej. startTime = -1) restan 2^64 cada uno
+    unsigned long long alta[CARRILES_METRICAS] = {0, 0, 0, 0};
+    unsigned long long baja[CARRILES_METRICAS] = {0, 0, 0, 0};
+    unsigned long long negativos[CARRILES_METRICAS] = {0, 0, 0, 0};
+    size_t i = 0;
+    for (; i + CARRILES_METRICAS <= n; i += CARRILES_METRICAS) {
+        for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+            unsigned long long u = static_cast<unsigned long long>(v[i + c]);
+            alta[c] += u >> 32;
+            baja[c] += u & 0xFFFFFFFFULL;
+            negativos[c] += u >> 63;
+        }
+    }
+    long double total = 0;
+    for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+        total += static_cast<long double>(alta[c]) * 4294967296.0L + static_cast<long double>(baja[c])
+               - static_cast<long double>(negativos[c]) * 18446744073709551616.0L;
+    }
+    for (; i < n; ++i) {
+        total += static_cast<long double>(v[i]);
+    }
+    return total;
+}
+
+inline void minimoMaximoColumna(const Tiempo* v, size_t n, Tiempo& minimo, Tiempo& maximo) {
+    Tiempo mn[CARRILES_METRICAS] = {LLONG_MAX, LLONG_MAX, LLONG_MAX, LLONG_MAX};
+    Tiempo mx[CARRILES_METRICAS] = {LLONG_MIN, LLONG_MIN, LLONG_MIN, LLONG_MIN};
+    size_t i = 0;
+    for (; i + CARRILES_METRICAS <= n; i += CARRILES_METRICAS) {
+        for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+            mn[c] = std::min(mn[c], v[i + c]);
+            mx[c] = std::max(mx[c], v[i + c]);
+        }
+    }
+    minimo = std::min(std::min(mn[0], mn[1]), std::min(mn[2], mn[3]));
+    maximo = std::max(std::max(mx[0], mx[1]), std::max(mx[2], mx[3]));
+    for (; i < n; ++i) {
+        minimo = std::min(minimo, v[i]);
+        maximo = std::max(maximo, v[i]);
+    }
+}
+
+// Suma de (v[i] - media)^2; en dos pasadas para no perder precisión
+inline double sumaCuadradosColumna(const Tiempo* v, size_t n, double media) {
+    double parcial[CARRILES_METRICAS] = {0.0, 0.0, 0.0, 0.0};
+    size_t i = 0;
+    for (; i + CARRILES_METRICAS <= n; i += CARRILES_METRICAS) {
+        for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+            double d = static_cast<double>(v[i + c]) - media;
+            parcial[c] += d * d;
+        }
+    }
+    double total = (parcial[0] + parcial[1]) + (parcial[2] + parcial[3]);
+    for (; i < n; ++i) {
+        double d = static_cast<double>(v[i]) - media;
+        total += d * d;
+    }
+    return total;
+}
+
+inline ResumenColumna resumirColumna(const std::vector<Tiempo>& v) {
+    ResumenColumna r;
+    if (v.empty()) return r;
+    size_t n = v.size();
+    r.suma = sumarColumna(v.data(), n);
+    minimoMaximoColumna(v.data(), n, r.minimo, r.maximo);
+    r.media = static_cast<double>(r.suma / static_cast<long double>(n));
+    r.varianza = sumaCuadradosColumna(v.data(), n, r.media) / static_cast<double>(n);
+    return r;
+}
+
+// Histograma de "cubetas.size()" intervalos de ancho "ancho" a partir de
+// "minimo"; los valores fuera de rango se acumulan en la primera o la
+// última cubeta. Se llenan varias copias intercaladas para que dos
+// valores seguidos en la misma cubeta no esperen uno al otro.
+inline void histogramaColumna(const Tiempo* v, size_t n, Tiempo minimo, Tiempo ancho,
+                              std::vector<long long>& cubetas) {
+    size_t k = cubetas.size();
+    std::fill(cubetas.begin(), cubetas.end(), 0);
+    if (k == 0) return;
+    ancho = std::max<Tiempo>(1, ancho);
+
+    std::vector<long long> copias(CARRILES_METRICAS * k, 0);
+    long long ultima = static_cast<long long>(k) - 1;
+    size_t i = 0;
+    for (; i + CARRILES_METRICAS <= n; i += CARRILES_METRICAS) {
+        for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+            long long b = (v[i + c] - minimo) / ancho;
+            b = std::min(std::max(b, 0LL), ultima);
+            copias[c * k + static_cast<size_t>(b)]++;
+        }
+    }
+    for (; i < n; ++i) {
+        long long b = (v[i] - minimo) / ancho;
+        b = std::min(std::max(b, 0LL), ultima);
+        copias[static_cast<size_t>(b)]++;
+    }
+    for (size_t c = 0; c < CARRILES_METRICAS; ++c) {
+        for (size_t b = 0; b < k; ++b) {
+            cubetas[b] += copias[c * k + b];
+        }
+    }
+}
+
+// Histograma de k cubetas que cubre [resumen.minimo, resumen.maximo]
+inline std::vector<long long> histogramaColumna(const std::vector<Tiempo>& v, const ResumenColumna& resumen,
+                                                size_t k) {
+    std::vector<long long> cubetas(k, 0);
+    if (k == 0 || v.empty()) return cubetas;
+    // En unsigned: maximo - minimo puede no caber en un Tiempo
+    unsigned long long rango = static_cast<unsigned long long>(resumen.maximo) -
+                               static_cast<unsigned long long>(resumen.minimo);
+    Tiempo ancho = static_cast<Tiempo>(rango / k + 1);
+    histogramaColumna(v.data(), v.size(), resumen.minimo, ancho, cubetas);
+    return cubetas;
+}
+
+#endif
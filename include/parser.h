@@ -23,31 +23,218 @@ public:
         
         while (std::getline(file, linea)) {
             if (linea.empty()) continue;
-            
+            procesos.push_back(parsearProceso(linea));
+        }
+        
+        file.close();
+        return procesos;
+    }
+    
+    // Una línea "<PID>, <BT>, <AT>, <Priority>[, <RÁFAGAS>[, <GRUPO>]]"
+    // (también la usa el modo en línea, que recibe los procesos de uno en
+    // uno). Las ráfagas pueden quedar vacías para dar solo el grupo.
+    static Proceso parsearProceso(const std::string& linea) {
+        std::stringstream ss(linea);
+        std::string pid, bt_str, at_str, pr_str, rafagas_str, grupo_str;
+        
+        // Leer: <PID>, <BT>, <AT>, <Priority>[, <RÁFAGAS>[, <GRUPO>]]
+        std::getline(ss, pid, ',');
+        std::getline(ss, bt_str, ',');
+        std::getline(ss, at_str, ',');
+        std::getline(ss, pr_str, ',');
+        std::getline(ss, rafagas_str, ',');
+        std::getline(ss, grupo_str, ',');
+        
+        // Limpiar espacios
+        pid = trim(pid);
+        bt_str = trim(bt_str);
+        at_str = trim(at_str);
+        pr_str = trim(pr_str);
+        
+        Tiempo bt = std::stoll(bt_str);
+        Tiempo at = std::stoll(at_str);
+        int pr = std::stoi(pr_str);
+        
+        Proceso p(pid, bt, at, pr);
+        parsearRafagas(rafagas_str, p);
+        p.grupo = limpiar(grupo_str);
+        if (!p.grupo.empty() && !nombreGrupoValido(p.grupo)) {
+            throw std::runtime_error("Grupo inválido en " + pid + ": " + p.grupo);
+        }
+        return p;
+    }
+    
+    // Ráfagas separadas por espacios, alternando CPU y E/S y empezando y
+    // terminando en CPU: "3 disco:4 2 red:1 3". Las de CPU deben sumar BT.
+    static void parsearRafagas(const std::string& texto, Proceso& p) {
+        std::stringstream ss(texto);
+        std::string ficha;
+        std::vector<Tiempo> cpu;
+        std::vector<RafagaES> es;
+        while (ss >> ficha) {
+            size_t separador = ficha.find(':');
+            bool esperaCPU = cpu.size() == es.size();
+            if (esperaCPU != (separador == std::string::npos)) {
+                throw std::runtime_error("Las ráfagas de " + p.pid + " deben alternar CPU y E/S: " + ficha);
+            }
+            if (esperaCPU) {
+                cpu.push_back(std::stoll(ficha));
+                if (cpu.back() <= 0) {
+                    throw std::runtime_error("Ráfaga de CPU inválida en " + p.pid + ": " + ficha);
+                }
+            } else {
+                es.push_back({ficha.substr(0, separador), std::stoll(ficha.substr(separador + 1))});
+                if (es.back().dispositivo.empty() || es.back().duracion <= 0) {
+                    throw std::runtime_error("Ráfaga de E/S inválida en " + p.pid + ": " + ficha);
+                }
+            }
+        }
+        if (es.empty()) return;
+        if (cpu.size() == es.size()) {
+            throw std::runtime_error("Las ráfagas de " + p.pid + " deben terminar en CPU");
+        }
+        
+        Tiempo total = 0;
+        for (Tiempo t : cpu) total += t;
+        if (total != p.burstTime) {
+            throw std::runtime_error("Las ráfagas de CPU de " + p.pid + " suman " + std::to_string(total) +
+                                     " en lugar de " + std::to_string(p.burstTime));
+        }
+        p.rafagasCPU = std::move(cpu);
+        p.rafagasES = std::move(es);
+        p.remainingTime = p.rafagasCPU[0];
+    }
+    
+    // Una línea "<NOMBRE>, <SERVIDORES>[, <LATENCIA>]" de dispositivos.txt
+    static Dispositivo parsearDispositivo(const std::string& linea) {
+        std::stringstream ss(linea);
+        std::string nombre, servidores_str, latencia_str;
+        
+        // Leer: <NOMBRE>, <SERVIDORES>[, <LATENCIA>]
+        std::getline(ss, nombre, ',');
+        std::getline(ss, servidores_str, ',');
+        std::getline(ss, latencia_str, ',');
+        
+        nombre = trim(nombre);
+        int servidores = std::stoi(trim(servidores_str));
+        Tiempo latencia = 0;
+        if (latencia_str.find_first_not_of(" \r") != std::string::npos) {
+            latencia = std::stoll(trim(latencia_str));
+        }
+        if (servidores < 1 || latencia < 0) {
+            throw std::runtime_error("Dispositivo inválido: " + linea);
+        }
+        return Dispositivo(nombre, servidores, latencia);
+    }
+    
+    // Cargar dispositivos de E/S desde archivo
+    static std::vector<Dispositivo> cargarDispositivos(const std::string& archivo) {
+        std::vector<Dispositivo> dispositivos;
+        std::string rutaCompleta = construirRuta(archivo);
+        std::ifstream file(rutaCompleta);
+        std::string linea;
+        
+        if (!file.is_open()) {
+            throw std::runtime_error("No se pudo abrir el archivo: " + rutaCompleta);
+        }
+        
+        while (std::getline(file, linea)) {
+            if (linea.empty()) continue;
+            dispositivos.push_back(parsearDispositivo(linea));
+        }
+        
+        file.close();
+        return dispositivos;
+    }
+    
+    // Una línea "<NOMBRE>, <PESO>[, <ALGORITMO>[, <RESPUESTA>]]" de
+    // grupos.txt. Sin algoritmo (o con "-") el grupo usa el de la corrida;
+    // RESPUESTA es la respuesta promedio que se espera del grupo.
+    static Grupo parsearGrupo(const std::string& linea) {
+        std::stringstream ss(linea);
+        std::string nombre, peso_str, algoritmo_str, respuesta_str;
+        
+        // Leer: <NOMBRE>, <PESO>[, <ALGORITMO>[, <RESPUESTA>]]
+        std::getline(ss, nombre, ',');
+        std::getline(ss, peso_str, ',');
+        std::getline(ss, algoritmo_str, ',');
+        std::getline(ss, respuesta_str, ',');
+        
+        nombre = limpiar(nombre);
+        int peso = std::stoi(trim(peso_str));
+        std::string algoritmo = limpiar(algoritmo_str);
+        if (algoritmo == "-") {
+            algoritmo.clear();
+        }
+        Tiempo respuesta = 0;
+        if (respuesta_str.find_first_not_of(" \r") != std::string::npos) {
+            respuesta = std::stoll(trim(respuesta_str));
+        }
+        if (!nombreGrupoValido(nombre) || peso < 1 || respuesta < 0) {
+            throw std::runtime_error("Grupo inválido: " + linea);
+        }
+        return Grupo(nombre, peso, algoritmo, respuesta);
+    }
+    
+    // Cargar grupos del reparto justo desde archivo
+    static std::vector<Grupo> cargarGrupos(const std::string& archivo) {
+        std::vector<Grupo> grupos;
+        std::string rutaCompleta = construirRuta(archivo);
+        std::ifstream file(rutaCompleta);
+        std::string linea;
+        
+        if (!file.is_open()) {
+            throw std::runtime_error("No se pudo abrir el archivo: " + rutaCompleta);
+        }
+        
+        while (std::getline(file, linea)) {
+            if (linea.empty()) continue;
+            grupos.push_back(parsearGrupo(linea));
+        }
+        
+        file.close();
+        return grupos;
+    }
+    
+    // Cargar un modelo DVFS desde archivo. Cada línea es un nivel
+    // "<FRECUENCIA>, <POTENCIA ACTIVA>[, <POTENCIA OCIOSA>]" o el costo de
+    // cambiar de nivel "cambio, <LATENCIA>[, <ENERGÍA>]".
+    static ModeloDVFS cargarDVFS(const std::string& archivo) {
+        ModeloDVFS modelo;
+        std::string rutaCompleta = construirRuta(archivo);
+        std::ifstream file(rutaCompleta);
+        std::string linea;
+        
+        if (!file.is_open()) {
+            throw std::runtime_error("No se pudo abrir el archivo: " + rutaCompleta);
+        }
+        
+        while (std::getline(file, linea)) {
+            if (linea.find_first_not_of(" \r") == std::string::npos) continue;
             std::stringstream ss(linea);
-            std::string pid, bt_str, at_str, pr_str;
+            std::string primero, segundo, tercero;
+            std::getline(ss, primero, ',');
+            std::getline(ss, segundo, ',');
+            std::getline(ss, tercero, ',');
+            primero = trim(primero);
+            bool hayTercero = tercero.find_first_not_of(" \r") != std::string::npos;
             
-            // Leer: <PID>, <BT>, <AT>, <Priority>
-            std::getline(ss, pid, ',');
-            std::getline(ss, bt_str, ',');
-            std::getline(ss, at_str, ',');
-            std::getline(ss, pr_str, ',');
-            
-            // Limpiar espacios
-            pid = trim(pid);
-            bt_str = trim(bt_str);
-            at_str = trim(at_str);
-            pr_str = trim(pr_str);
-            
-            int bt = std::stoi(bt_str);
-            int at = std::stoi(at_str);
-            int pr = std::stoi(pr_str);
-            
-            procesos.push_back(Proceso(pid, bt, at, pr));
+            if (primero == "cambio") {
+                modelo.latenciaCambio = std::stoll(trim(segundo));
+                modelo.energiaCambio = hayTercero ? std::stod(trim(tercero)) : 0.0;
+            } else {
+                long long frecuencia = std::stoll(primero);
+                double activa = std::stod(trim(segundo));
+                double ociosa = hayTercero ? std::stod(trim(tercero)) : 0.0;
+                if (frecuencia <= 0 || activa < 0 || ociosa < 0) {
+                    throw std::runtime_error("Nivel de frecuencia inválido: " + linea);
+                }
+                modelo.niveles.push_back(NivelFrecuencia(frecuencia, activa, ociosa));
+            }
         }
         
         file.close();
-        return procesos;
+        return modelo;
     }
     
     // Cargar recursos desde archivo
@@ -65,24 +252,58 @@ public:
             if (linea.empty()) continue;
             
             std::stringstream ss(linea);
-            std::string nombre, contador_str;
+            std::string nombre, contador_str, entrega_str;
             
-            // Leer: <NOMBRE RECURSO>, <CONTADOR>
+            // Leer: <NOMBRE RECURSO>, <CONTADOR>[, <ENTREGA>]
             std::getline(ss, nombre, ',');
             std::getline(ss, contador_str, ',');
+            std::getline(ss, entrega_str, ',');
             
             nombre = trim(nombre);
             contador_str = trim(contador_str);
             
             int contador = std::stoi(contador_str);
             
-            recursos.push_back(Recurso(nombre, contador));
+            PoliticaEntrega entrega = ENTREGA_POR_DEFECTO;
+            int parametro = 0;
+            if (entrega_str.find_first_not_of(" \r") != std::string::npos) {
+                parsearEntrega(entrega_str, entrega, parametro);
+            }
+            recursos.push_back(Recurso(nombre, contador, entrega, parametro));
         }
         
         file.close();
         return recursos;
     }
     
+    // Política de entrega: "irrumpir", "fifo", "girar[:N]" o "lote[:N]"
+    // (columna opcional de recursos.txt)
+    static void parsearEntrega(const std::string& texto, PoliticaEntrega& politica, int& parametro) {
+        std::string t = trim(texto);
+        t.erase(t.find_last_not_of(" \r") + 1);
+        size_t separador = t.find(':');
+        std::string nombre = trim(t.substr(0, separador));
+        parametro = 2;
+        if (separador != std::string::npos) {
+            parametro = std::stoi(t.substr(separador + 1));
+        }
+        
+        if (nombre == "irrumpir") {
+            politica = ENTREGA_IRRUMPIR;
+        } else if (nombre == "fifo") {
+            politica = ENTREGA_FIFO;
+        } else if (nombre == "girar") {
+            politica = ENTREGA_GIRAR;
+        } else if (nombre == "lote") {
+            politica = ENTREGA_LOTE;
+        } else {
+            throw std::runtime_error("Política de entrega desconocida: " + t);
+        }
+        if (parametro < 0 || (politica == ENTREGA_LOTE && parametro < 1)) {
+            throw std::runtime_error("Parámetro de entrega inválido: " + t);
+        }
+    }
+    
     // Cargar acciones desde archivo
     static std::vector<Accion> cargarAcciones(const std::string& archivo) {
         std::vector<Accion> acciones;
@@ -111,7 +332,7 @@ public:
             recurso = trim(recurso);
             ciclo_str = trim(ciclo_str);
             
-            int ciclo = std::stoi(ciclo_str);
+            Tiempo ciclo = std::stoll(ciclo_str);
             
             acciones.push_back(Accion(pid, tipo, recurso, ciclo));
         }
@@ -119,13 +340,30 @@ public:
         file.close();
         return acciones;
     }
-    
+
 private:
-    // Construir ruta completa al archivo
+    // Construir ruta completa al archivo: los nombres sueltos se buscan en
+    // data/; las rutas absolutas o que ya empiezan por data/ se respetan
     static std::string construirRuta(const std::string& archivo) {
+        if (archivo.rfind("/", 0) == 0 || archivo.rfind("data/", 0) == 0) {
+            return archivo;
+        }
         return "data/" + archivo;
     }
     
+    // Un nombre de grupo: partes no vacías separadas por "/"
+    static bool nombreGrupoValido(const std::string& nombre) {
+        return !nombre.empty() && nombre.front() != '/' && nombre.back() != '/' &&
+               nombre.find("//") == std::string::npos;
+    }
+    
+    // Como trim, quitando también el fin de línea de Windows
+    static std::string limpiar(const std::string& str) {
+        std::string t = trim(str);
+        t.erase(t.find_last_not_of(" \r") + 1);
+        return t;
+    }
+    
     // Función auxiliar para eliminar espacios en blanco
     static std::string trim(const std::string& str) {
         size_t first = str.find_first_not_of(' ');
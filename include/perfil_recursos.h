@@ -0,0 +1,143 @@
+#ifndef PERFIL_RECURSOS_H
+#define PERFIL_RECURSOS_H
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "estructuras.h"
+#include "metricas.h"
+
+// ------------------------------------------------------------
+// Perfil de contención por recurso
+// ------------------------------------------------------------
+// El simulador de sincronización avisa cada adquisición, liberación y
+// encolamiento. Durante la corrida solo se guardan columnas de tiempos
+// (retención y espera) y los cambios de ocupación; los resúmenes,
+// histogramas y la utilización por ventana se calculan al pedirlos.
+
+struct PerfilRecurso {
+    std::string nombre;
+    int capacidad = 0;
+    long long adquisiciones = 0;
+    long long disputadas = 0;           // Adquisiciones que tuvieron que esperar
+    size_t colaMaxima = 0;
+    ResumenColumna retencion;           // Desde que se toma hasta que se suelta
+    ResumenColumna espera;              // Solo de las disputadas
+    std::vector<long long> histogramaRetencion;
+    std::vector<long long> histogramaEspera;
+    double utilizacion = 0.0;           // Unidades ocupadas / capacidad, en promedio
+    std::vector<float> usoEnElTiempo;   // Utilización en cada ventana de la corrida
+};
+
+class PerfiladorRecursos {
+public:
+    static const size_t CUBETAS = 16;
+    static const size_t VENTANAS = 64;
+
+    void reiniciar(const std::vector<Recurso>& recursos) {
+        datos.assign(recursos.size(), Datos());
+        for (size_t r = 0; r < recursos.size(); ++r) {
+            datos[r].nombre = recursos[r].nombre;
+            datos[r].capacidad = recursos[r].contadorOriginal;
+        }
+        fin = 0;
+    }
+
+    // "ocupadas": unidades retenidas después del cambio
+    void adquirido(int r, Tiempo tiempo, int ocupadas, bool disputada, Tiempo espera) {
+        Datos& d = datos[r];
+        d.adquisiciones++;
+        if (disputada) {
+            d.disputadas++;
+            d.esperas.push_back(espera);
+        }
+        ocupar(d, tiempo, ocupadas);
+    }
+
+    void liberado(int r, Tiempo tiempo, int ocupadas, Tiempo retencion) {
+        Datos& d = datos[r];
+        d.retenciones.push_back(retencion);
+        ocupar(d, tiempo, ocupadas);
+    }
+
+    void encolado(int r, size_t largoCola) {
+        datos[r].colaMaxima = std::max(datos[r].colaMaxima, largoCola);
+    }
+
+    // Un perfil por recurso, en el orden de recursos.txt
+    std::vector<PerfilRecurso> resumir() const {
+        std::vector<PerfilRecurso> perfiles;
+        for (const Datos& d : datos) {
+            PerfilRecurso p;
+            p.nombre = d.nombre;
+            p.capacidad = d.capacidad;
+            p.adquisiciones = d.adquisiciones;
+            p.disputadas = d.disputadas;
+            p.colaMaxima = d.colaMaxima;
+            p.retencion = resumirColumna(d.retenciones);
+            p.espera = resumirColumna(d.esperas);
+            p.histogramaRetencion = histogramaColumna(d.retenciones, p.retencion, CUBETAS);
+            p.histogramaEspera = histogramaColumna(d.esperas, p.espera, CUBETAS);
+            utilizacionEnVentanas(d, p);
+            perfiles.push_back(std::move(p));
+        }
+        return perfiles;
+    }
+
+private:
+    struct Datos {
+        std::string nombre;
+        int capacidad = 0;
+        long long adquisiciones = 0;
+        long long disputadas = 0;
+        size_t colaMaxima = 0;
+        std::vector<Tiempo> retenciones;
+        std::vector<Tiempo> esperas;
+        // Unidades ocupadas desde cada instante (en orden de tiempo)
+        std::vector<std::pair<Tiempo, int>> ocupacion;
+    };
+
+    std::vector<Datos> datos;
+    Tiempo fin = 0;
+
+    void ocupar(Datos& d, Tiempo tiempo, int ocupadas) {
+        if (!d.ocupacion.empty() && d.ocupacion.back().first == tiempo) {
+            d.ocupacion.back().second = ocupadas;
+        } else {
+            d.ocupacion.push_back({tiempo, ocupadas});
+        }
+        fin = std::max(fin, tiempo);
+    }
+
+    // Integrar la ocupación sobre VENTANAS intervalos iguales de [0, fin)
+    void utilizacionEnVentanas(const Datos& d, PerfilRecurso& p) const {
+        p.usoEnElTiempo.assign(VENTANAS, 0.0f);
+        if (fin <= 0 || d.capacidad <= 0) return;
+        const double ancho = static_cast<double>(fin) / VENTANAS;
+        std::vector<double> ocupado(VENTANAS, 0.0);
+        double total = 0.0;
+        for (size_t k = 0; k < d.ocupacion.size(); ++k) {
+            Tiempo desde = d.ocupacion[k].first;
+            Tiempo hasta = k + 1 < d.ocupacion.size() ? d.ocupacion[k + 1].first : fin;
+            int unidades = d.ocupacion[k].second;
+            if (unidades == 0 || hasta <= desde) continue;
+            total += static_cast<double>(hasta - desde) * unidades;
+
+            // Repartir [desde, hasta) entre las ventanas que toca
+            size_t w = std::min(VENTANAS - 1, static_cast<size_t>(desde / ancho));
+            double inicio = static_cast<double>(desde);
+            while (inicio < hasta && w < VENTANAS) {
+                double finVentana = std::min(static_cast<double>(hasta), (w + 1) * ancho);
+                ocupado[w] += (finVentana - inicio) * unidades;
+                inicio = finVentana;
+                w++;
+            }
+        }
+        for (size_t w = 0; w < VENTANAS; ++w) {
+            p.usoEnElTiempo[w] = static_cast<float>(ocupado[w] / (ancho * d.capacidad));
+        }
+        p.utilizacion = total / (static_cast<double>(fin) * d.capacidad);
+    }
+};
+
+#endif
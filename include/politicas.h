@@ -0,0 +1,459 @@
+#ifndef POLITICAS_H
+#define POLITICAS_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <memory_resource>
+#include "estructuras.h"
+
+enum TipoAlgoritmo {
+    FIFO,
+    SJF,
+    SRTF,
+    ROUND_ROBIN,
+    PRIORITY
+};
+
+// Nombre corto de cada algoritmo (el mismo que se usa en la interfaz)
+inline const char* nombreAlgoritmo(TipoAlgoritmo tipo) {
+    switch (tipo) {
+        case FIFO:        return "FIFO";
+        case SJF:         return "SJF";
+        case SRTF:        return "SRTF";
+        case ROUND_ROBIN: return "RR";
+        case PRIORITY:    return "PRIO";
+    }
+    return "?";
+}
+
+// ------------------------------------------------------------
+// Políticas de calendarización
+// ------------------------------------------------------------
+// Cada política decide únicamente el orden de ejecución; el ciclo de
+// simulación (admisión, eventos de Gantt y métricas) vive en
+// SimuladorCalendarizacion::simular y se instancia una vez por política,
+// por lo que las llamadas a los ganchos se resuelven en compilación.
+//
+// Ganchos que el ciclo invoca sobre la política:
+//   alLlegar(p, t)          el proceso está listo desde el instante t
+//   hayListos()             si queda algún proceso listo
+//   elegirSiguiente(t)      extrae el próximo proceso a ejecutar
+//   tramo(p, t, proxima)    tiempo a ejecutar antes de la siguiente decisión
+//                           (proxima = próxima llegada conocida)
+//   alAvanzar(p, ejecutado) notificación tras ejecutar un tramo
+//   debeExpropiar(p, t)     si el proceso en CPU debe ceder el CPU
+//   alExpropiar(p, t)       devuelve a la cola un proceso expropiado
+//   guardar(e, base)        copia la cola de listos a un punto de control
+//   restaurar(e, base)      reconstruye la cola desde un punto de control
+//                           (base = primer proceso; se guardan índices)
+//
+// La base CRTP aporta el comportamiento no expropiativo por defecto; una
+// política solo redefine los ganchos que necesita. Las colas reciben la
+// memoria de la corrida (ver arena.h).
+template <class Derivada>
+class Politica {
+public:
+    bool debeExpropiar(const Proceso&, Tiempo) const { return false; }
+
+    void alExpropiar(Proceso* p, Tiempo t) { derivada().alLlegar(p, t); }
+
+    Tiempo tramo(const Proceso& p, Tiempo, Tiempo) const { return p.remainingTime; }
+
+    void alAvanzar(Proceso&, Tiempo) {}
+
+protected:
+    Derivada& derivada() { return static_cast<Derivada&>(*this); }
+};
+
+// Contenido de una cola de listos en un punto de control. Se guardan
+// índices en lugar de punteros para que sobreviva a cambios de la carga.
+struct EstadoCola {
+    struct Entrada {
+        int indice;
+        long long clave;
+        long long orden;
+    };
+    std::vector<Entrada> entradas;
+    long long inserciones = 0;
+};
+
+// Cola de listos ordenada por una clave entera; los empates se resuelven
+// por tiempo de llegada y después por orden de inserción, lo que mantiene
+// el resultado estable.
+class ColaPorClave {
+public:
+    explicit ColaPorClave(std::pmr::memory_resource* memoria) : heap(memoria) {}
+
+    struct Entrada {
+        long long clave;
+        Tiempo llegada;
+        long long orden;
+        Proceso* proceso;
+    };
+
+    void insertar(Proceso* p, long long clave) { insertar(p, clave, inserciones++); }
+
+    // Con un orden de inserción dado (para mover entradas entre colas sin
+    // perder su desempate)
+    void insertar(Proceso* p, long long clave, long long orden) {
+        heap.push_back({clave, p->arrivalTime, orden, p});
+        std::push_heap(heap.begin(), heap.end(), mayor);
+    }
+
+    const Entrada& cima() const { return heap.front(); }
+
+    Proceso* extraer() {
+        std::pop_heap(heap.begin(), heap.end(), mayor);
+        Proceso* p = heap.back().proceso;
+        heap.pop_back();
+        return p;
+    }
+
+    bool vacia() const { return heap.empty(); }
+
+    void clear() { heap.clear(); }
+
+    // Entradas en el orden del arreglo del heap (no en orden de extracción)
+    template <class F>
+    void recorrer(F f) const {
+        for (const auto& x : heap) f(x);
+    }
+
+    // El arreglo del heap se copia tal cual, así que restaurarlo no
+    // necesita volver a ordenarlo
+    void guardar(EstadoCola& e, const Proceso* base) const {
+        e.entradas.clear();
+        for (const auto& x : heap) {
+            e.entradas.push_back({static_cast<int>(x.proceso - base), x.clave, x.orden});
+        }
+        e.inserciones = inserciones;
+    }
+
+    void restaurar(const EstadoCola& e, Proceso* base) {
+        heap.clear();
+        for (const auto& x : e.entradas) {
+            Proceso* p = base + x.indice;
+            heap.push_back({x.clave, p->arrivalTime, x.orden, p});
+        }
+        inserciones = e.inserciones;
+    }
+
+private:
+    // Comparador invertido: std::*_heap deja en la cima la menor clave
+    static bool mayor(const Entrada& a, const Entrada& b) {
+        if (a.clave != b.clave) return a.clave > b.clave;
+        if (a.llegada != b.llegada) return a.llegada > b.llegada;
+        return a.orden > b.orden;
+    }
+
+    std::pmr::vector<Entrada> heap;
+    long long inserciones = 0;
+};
+
+// Cola de procesos sobre un arreglo circular que reutiliza su memoria.
+// Con la arena monótona (arena.h) una std::deque pediría un bloque nuevo
+// cada vez que avanza y la arena crecería con el número de despachos; el
+// arreglo solo se duplica cuando se llena, así que la memoria depende del
+// máximo de procesos listos a la vez.
+class ColaCircular {
+public:
+    explicit ColaCircular(std::pmr::memory_resource* memoria) : datos(memoria), cabeza(0), cuenta(0) {}
+
+    void push_back(Proceso* p) {
+        if (cuenta == datos.size()) crecer();
+        datos[(cabeza + cuenta) & (datos.size() - 1)] = p;
+        cuenta++;
+    }
+
+    Proceso* front() const { return datos[cabeza]; }
+
+    void pop_front() {
+        cabeza = (cabeza + 1) & (datos.size() - 1);
+        cuenta--;
+    }
+
+    bool empty() const { return cuenta == 0; }
+
+    size_t size() const { return cuenta; }
+
+    // i-ésimo desde el frente
+    Proceso* operator[](size_t i) const { return datos[(cabeza + i) & (datos.size() - 1)]; }
+
+    void clear() {
+        cabeza = 0;
+        cuenta = 0;
+    }
+
+private:
+    // Capacidad siempre potencia de dos: el índice circular es una máscara
+    void crecer() {
+        std::pmr::vector<Proceso*> nuevo(std::max<size_t>(16, 2 * datos.size()), nullptr,
+                                         datos.get_allocator());
+        for (size_t i = 0; i < cuenta; ++i) nuevo[i] = (*this)[i];
+        datos.swap(nuevo);
+        cabeza = 0;
+    }
+
+    std::pmr::vector<Proceso*> datos;
+    size_t cabeza;
+    size_t cuenta;
+};
+
+// FIFO (First In First Out): orden de llegada, sin expropiación
+class PoliticaFIFO : public Politica<PoliticaFIFO> {
+public:
+    explicit PoliticaFIFO(std::pmr::memory_resource* memoria) : cola(memoria) {}
+
+    void alLlegar(Proceso* p, Tiempo) { cola.push_back(p); }
+
+    bool hayListos() const { return !cola.empty(); }
+
+    Proceso* elegirSiguiente(Tiempo) {
+        Proceso* p = cola.front();
+        cola.pop_front();
+        return p;
+    }
+
+    void guardar(EstadoCola& e, const Proceso* base) const {
+        e.entradas.clear();
+        for (size_t i = 0; i < cola.size(); ++i) {
+            e.entradas.push_back({static_cast<int>(cola[i] - base), 0, 0});
+        }
+    }
+
+    void restaurar(const EstadoCola& e, Proceso* base) {
+        cola.clear();
+        for (const auto& x : e.entradas) cola.push_back(base + x.indice);
+    }
+
+private:
+    ColaCircular cola;
+};
+
+// SJF (Shortest Job First): menor ráfaga de CPU (la que empieza al
+// llegar o al volver de E/S), sin expropiación
+class PoliticaSJF : public Politica<PoliticaSJF> {
+public:
+    explicit PoliticaSJF(std::pmr::memory_resource* memoria) : listos(memoria) {}
+
+    void alLlegar(Proceso* p, Tiempo) { listos.insertar(p, p->remainingTime); }
+
+    bool hayListos() const { return !listos.vacia(); }
+
+    Proceso* elegirSiguiente(Tiempo) { return listos.extraer(); }
+
+    void guardar(EstadoCola& e, const Proceso* base) const { listos.guardar(e, base); }
+
+    void restaurar(const EstadoCola& e, Proceso* base) { listos.restaurar(e, base); }
+
+private:
+    ColaPorClave listos;
+};
+
+// SRTF (Shortest Remaining Time First): SJF expropiativo. Solo una
+// llegada puede cambiar la decisión, así que cada tramo dura hasta la
+// próxima llegada o hasta que el proceso termina.
+class PoliticaSRTF : public Politica<PoliticaSRTF> {
+public:
+    explicit PoliticaSRTF(std::pmr::memory_resource* memoria) : listos(memoria) {}
+
+    void alLlegar(Proceso* p, Tiempo) { listos.insertar(p, p->remainingTime); }
+
+    bool hayListos() const { return !listos.vacia(); }
+
+    Proceso* elegirSiguiente(Tiempo) { return listos.extraer(); }
+
+    Tiempo tramo(const Proceso& p, Tiempo t, Tiempo proxima) const {
+        return std::min(p.remainingTime, proxima - t);
+    }
+
+    // Solo se cambia de contexto si hay un proceso con tiempo restante
+    // estrictamente menor; en empate continúa el proceso actual
+    bool debeExpropiar(const Proceso& p, Tiempo) const {
+        return !listos.vacia() && listos.cima().clave < p.remainingTime;
+    }
+
+    void guardar(EstadoCola& e, const Proceso* base) const { listos.guardar(e, base); }
+
+    void restaurar(const EstadoCola& e, Proceso* base) { listos.restaurar(e, base); }
+
+private:
+    ColaPorClave listos;
+};
+
+// Round Robin: cola circular con quantum fijo
+class PoliticaRoundRobin : public Politica<PoliticaRoundRobin> {
+public:
+    PoliticaRoundRobin(Tiempo q, std::pmr::memory_resource* memoria) : cola(memoria), quantum(q) {
+        // Con quantum <= 0 ningún tramo avanzaría el reloj
+        if (quantum <= 0) {
+            throw std::runtime_error("El quantum debe ser positivo");
+        }
+    }
+
+    void alLlegar(Proceso* p, Tiempo) { cola.push_back(p); }
+
+    bool hayListos() const { return !cola.empty(); }
+
+    Proceso* elegirSiguiente(Tiempo) {
+        Proceso* p = cola.front();
+        cola.pop_front();
+        return p;
+    }
+
+    Tiempo tramo(const Proceso& p, Tiempo, Tiempo) const {
+        return std::min(quantum, p.remainingTime);
+    }
+
+    // Al agotar el quantum el proceso vuelve al final de la cola, detrás
+    // de los que llegaron durante su ejecución. Si no hay nadie más listo
+    // sigue en CPU: ceder y volver a elegirlo no sería un cambio de
+    // contexto real
+    bool debeExpropiar(const Proceso&, Tiempo) const { return hayListos(); }
+
+    void guardar(EstadoCola& e, const Proceso* base) const {
+        e.entradas.clear();
+        for (size_t i = 0; i < cola.size(); ++i) {
+            e.entradas.push_back({static_cast<int>(cola[i] - base), 0, 0});
+        }
+    }
+
+    void restaurar(const EstadoCola& e, Proceso* base) {
+        cola.clear();
+        for (const auto& x : e.entradas) cola.push_back(base + x.indice);
+    }
+
+private:
+    ColaCircular cola;
+    Tiempo quantum;
+};
+
+// Priority con envejecimiento: cada INTERVALO_ENVEJECIMIENTO ciclos en
+// la cola de listos, la prioridad mejora en 1 hasta llegar a 1, como en
+// la versión original; una prioridad inicial de 1 o menos no cambia. La
+// prioridad efectiva en el tiempo t es
+//   max(1, priority - floor((t - listo) / INTERVALO_ENVEJECIMIENTO))
+// con "listo" la llegada o el regreso de E/S (la versión original
+// envejecía a todos los listos a la vez, con un reloj común). Los empates
+// se resuelven por llegada y orden de ingreso.
+//
+// El envejecimiento es perezoso y priority no se modifica. Si listo = q *
+// INTERVALO + r, los pasos en t son floor((t - r) / INTERVALO) - q: para
+// los procesos del mismo residuo r el descuento es común, así que cada
+// residuo es un heap con la clave fija priority + q. Los que llegan al
+// piso (o empiezan en él) pasan una sola vez a un heap aparte, donde
+// empatan en 1 y los ordena la llegada. Elegir revisa la cima de cada
+// heap: O(INTERVALO * log n) por despacho.
+class PoliticaPriority : public Politica<PoliticaPriority> {
+public:
+    static const int INTERVALO_ENVEJECIMIENTO = 5;
+
+    explicit PoliticaPriority(std::pmr::memory_resource* memoria) : enElPiso(memoria), inserciones(0) {
+        envejeciendo.reserve(INTERVALO_ENVEJECIMIENTO);
+        for (int r = 0; r < INTERVALO_ENVEJECIMIENTO; ++r) envejeciendo.emplace_back(memoria);
+    }
+
+    void alLlegar(Proceso* p, Tiempo t) { encolar(p, t, inserciones++); }
+
+    bool hayListos() const {
+        if (!enElPiso.vacia()) return true;
+        for (const auto& cola : envejeciendo) {
+            if (!cola.vacia()) return true;
+        }
+        return false;
+    }
+
+    Proceso* elegirSiguiente(Tiempo t) {
+        // Los que alcanzaron el piso en t dejan de envejecer
+        for (int r = 0; r < INTERVALO_ENVEJECIMIENTO; ++r) {
+            ColaPorClave& cola = envejeciendo[r];
+            while (!cola.vacia() && cola.cima().clave - pasos(t, r) <= 1) {
+                ColaPorClave::Entrada e = cola.cima();
+                cola.extraer();
+                enElPiso.insertar(e.proceso, 1, e.orden);
+            }
+        }
+        if (!enElPiso.vacia()) {
+            return enElPiso.extraer();
+        }
+
+        int mejor = -1;
+        long long efectivaMejor = 0;
+        for (int r = 0; r < INTERVALO_ENVEJECIMIENTO; ++r) {
+            if (envejeciendo[r].vacia()) continue;
+            const ColaPorClave::Entrada& e = envejeciendo[r].cima();
+            long long efectiva = e.clave - pasos(t, r);
+            if (mejor < 0) {
+                mejor = r;
+                efectivaMejor = efectiva;
+                continue;
+            }
+            const ColaPorClave::Entrada& m = envejeciendo[mejor].cima();
+            if (efectiva < efectivaMejor ||
+                (efectiva == efectivaMejor && (e.llegada < m.llegada || (e.llegada == m.llegada && e.orden < m.orden)))) {
+                mejor = r;
+                efectivaMejor = efectiva;
+            }
+        }
+        return envejeciendo[mejor].extraer();
+    }
+
+    // Se guarda desde cuándo está listo cada proceso que aún envejece
+    // (o EN_EL_PISO); al restaurar, las claves se recalculan
+    void guardar(EstadoCola& e, const Proceso* base) const {
+        e.entradas.clear();
+        enElPiso.recorrer([&](const ColaPorClave::Entrada& x) {
+            e.entradas.push_back({static_cast<int>(x.proceso - base), EN_EL_PISO, x.orden});
+        });
+        for (int r = 0; r < INTERVALO_ENVEJECIMIENTO; ++r) {
+            envejeciendo[r].recorrer([&](const ColaPorClave::Entrada& x) {
+                long long listo = (x.clave - x.proceso->priority) * INTERVALO_ENVEJECIMIENTO + r;
+                e.entradas.push_back({static_cast<int>(x.proceso - base), listo, x.orden});
+            });
+        }
+        e.inserciones = inserciones;
+    }
+
+    void restaurar(const EstadoCola& e, Proceso* base) {
+        enElPiso.clear();
+        for (auto& cola : envejeciendo) cola.clear();
+        for (const auto& x : e.entradas) {
+            Proceso* p = base + x.indice;
+            if (x.clave == EN_EL_PISO) {
+                enElPiso.insertar(p, std::min(p->priority, 1), x.orden);
+            } else {
+                encolar(p, x.clave, x.orden);
+            }
+        }
+        inserciones = e.inserciones;
+    }
+
+private:
+    static constexpr long long EN_EL_PISO = -1;
+
+    ColaPorClave enElPiso;                  // Clave: prioridad efectiva final (<= 1)
+    std::vector<ColaPorClave> envejeciendo; // Por residuo de "listo"; clave: priority + q
+    long long inserciones;
+
+    // División hacia abajo (las llegadas pueden ser negativas)
+    static long long cocientePiso(Tiempo t) {
+        long long q = t / INTERVALO_ENVEJECIMIENTO;
+        return q * INTERVALO_ENVEJECIMIENTO > t ? q - 1 : q;
+    }
+
+    // Pasos de envejecimiento en t, comunes al residuo r
+    static long long pasos(Tiempo t, int r) { return cocientePiso(t - r); }
+
+    void encolar(Proceso* p, Tiempo listo, long long orden) {
+        if (p->priority <= 1) {
+            enElPiso.insertar(p, p->priority, orden);
+            return;
+        }
+        long long q = cocientePiso(listo);
+        int r = static_cast<int>(listo - q * INTERVALO_ENVEJECIMIENTO);
+        envejeciendo[r].insertar(p, p->priority + q, orden);
+    }
+};
+
+#endif
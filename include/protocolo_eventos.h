@@ -0,0 +1,138 @@
+#ifndef PROTOCOLO_EVENTOS_H
+#define PROTOCOLO_EVENTOS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "estructuras.h"
+
+// ------------------------------------------------------------
+// Protocolo de eventos por socket Unix
+// ------------------------------------------------------------
+// Un simulador sin interfaz (ServidorEventos) publica lo que produce y
+// la interfaz gráfica (ClienteEventos) lo dibuja en vivo. Ambos extremos
+// están en la misma máquina, así que los enteros viajan en el orden de
+// bytes nativo.
+//
+// Cada mensaje es: tipo (1 byte), largo del contenido (4 bytes) y el
+// contenido. Los textos van como largo (2 bytes) y bytes.
+//
+// Servidor -> cliente:
+//   GRUPO     grupo, nombre                 un algoritmo (p. ej. "RR")
+//   PROCESO   pid, ráfaga, llegada, prioridad
+//   EVENTO    grupo, pid, inicio, fin, estado
+//   TERMINADO grupo, pid, espera, respuesta, finalización
+//   FIN                                     no habrá más mensajes
+// Cliente -> servidor:
+//   CREDITO   n                             admite n mensajes más (0 < n < 2^31)
+//   VENTANA   desde, hasta                  solo eventos que toquen [desde, hasta)
+//
+// Control de flujo por créditos: cada mensaje del servidor (salvo FIN)
+// gasta un crédito y el servidor se detiene, junto con la simulación,
+// cuando se le acaban. El cliente devuelve créditos a medida que procesa
+// los mensajes, de modo que un cliente lento frena al servidor en lugar
+// de acumular datos sin límite.
+
+enum TipoMensaje : uint8_t {
+    MENSAJE_GRUPO = 1,
+    MENSAJE_PROCESO = 2,
+    MENSAJE_EVENTO = 3,
+    MENSAJE_TERMINADO = 4,
+    MENSAJE_FIN = 5,
+    MENSAJE_CREDITO = 16,
+    MENSAJE_VENTANA = 17
+};
+
+const size_t TAMANO_CABECERA = 5;
+
+// Créditos que el cliente concede al conectarse
+const uint32_t CREDITOS_INICIALES = 16384;
+
+// Escribe mensajes al final de un buffer
+class EscritorMensajes {
+public:
+    explicit EscritorMensajes(std::vector<char>& destino) : buffer(destino), inicioMensaje(0) {}
+
+    void iniciar(TipoMensaje tipo) {
+        inicioMensaje = buffer.size();
+        buffer.push_back(static_cast<char>(tipo));
+        buffer.resize(buffer.size() + 4);
+    }
+
+    // Completa el largo del mensaje en curso
+    void terminar() {
+        uint32_t largo = static_cast<uint32_t>(buffer.size() - inicioMensaje - TAMANO_CABECERA);
+        std::memcpy(buffer.data() + inicioMensaje + 1, &largo, sizeof(largo));
+    }
+
+    void entero(int64_t v) { bytes(&v, sizeof(v)); }
+    void entero32(uint32_t v) { bytes(&v, sizeof(v)); }
+
+    void texto(const std::string& s) {
+        uint16_t largo = static_cast<uint16_t>(std::min<size_t>(s.size(), UINT16_MAX));
+        bytes(&largo, sizeof(largo));
+        bytes(s.data(), largo);
+    }
+
+private:
+    std::vector<char>& buffer;
+    size_t inicioMensaje;
+
+    void bytes(const void* datos, size_t n) {
+        const char* p = static_cast<const char*>(datos);
+        buffer.insert(buffer.end(), p, p + n);
+    }
+};
+
+// Lee el contenido de un mensaje; lanza una excepción si está truncado
+class LectorMensaje {
+public:
+    LectorMensaje(const char* datos, size_t largo) : p(datos), fin(datos + largo) {}
+
+    int64_t entero() {
+        int64_t v;
+        bytes(&v, sizeof(v));
+        return v;
+    }
+
+    uint32_t entero32() {
+        uint32_t v;
+        bytes(&v, sizeof(v));
+        return v;
+    }
+
+    std::string texto() {
+        uint16_t largo;
+        bytes(&largo, sizeof(largo));
+        std::string s(largo, '\0');
+        bytes(&s[0], largo);
+        return s;
+    }
+
+private:
+    const char* p;
+    const char* fin;
+
+    void bytes(void* destino, size_t n) {
+        if (static_cast<size_t>(fin - p) < n) {
+            throw std::runtime_error("Mensaje del protocolo truncado");
+        }
+        std::memcpy(destino, p, n);
+        p += n;
+    }
+};
+
+// Si buffer[desde..] empieza con un mensaje completo, devuelve su tamaño
+// total (cabecera incluida); si no, 0
+inline size_t mensajeCompleto(const std::vector<char>& buffer, size_t desde) {
+    if (buffer.size() - desde < TAMANO_CABECERA) return 0;
+    uint32_t largo;
+    std::memcpy(&largo, buffer.data() + desde + 1, sizeof(largo));
+    if (buffer.size() - desde < TAMANO_CABECERA + largo) return 0;
+    return TAMANO_CABECERA + largo;
+}
+
+#endif
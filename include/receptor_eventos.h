@@ -0,0 +1,53 @@
+#ifndef RECEPTOR_EVENTOS_H
+#define RECEPTOR_EVENTOS_H
+
+#include <string>
+#include <vector>
+#include "estructuras.h"
+
+// Interfaz para consumir los resultados de una simulación mientras se
+// produce (exportadores, servidores, etc.). Los simuladores la invocan una
+// vez por tramo terminado, no por ciclo de reloj.
+class ReceptorEventos {
+public:
+    virtual ~ReceptorEventos() {}
+
+    // Tramo terminado del diagrama de Gantt
+    virtual void alEvento(const EventoGantt& evento) = 0;
+
+    // Cambio en un recurso de sincronización: adquisición (adquirido =
+    // true) o liberación, con los permisos que quedan disponibles
+    virtual void alRecurso(const std::string& /*recurso*/, const std::string& /*pid*/,
+                           Tiempo /*ciclo*/, int /*disponibles*/, bool /*adquirido*/) {}
+
+    // Proceso terminado, con sus métricas ya calculadas
+    virtual void alTerminar(const Proceso& /*proceso*/) {}
+};
+
+// Reenvía todo a varios receptores (p. ej. un trace y un servidor)
+class ReceptoresMultiples : public ReceptorEventos {
+public:
+    void agregar(ReceptorEventos* r) {
+        if (r) receptores.push_back(r);
+    }
+
+    bool vacio() const { return receptores.empty(); }
+
+    void alEvento(const EventoGantt& evento) override {
+        for (ReceptorEventos* r : receptores) r->alEvento(evento);
+    }
+
+    void alRecurso(const std::string& recurso, const std::string& pid,
+                   Tiempo ciclo, int disponibles, bool adquirido) override {
+        for (ReceptorEventos* r : receptores) r->alRecurso(recurso, pid, ciclo, disponibles, adquirido);
+    }
+
+    void alTerminar(const Proceso& proceso) override {
+        for (ReceptorEventos* r : receptores) r->alTerminar(proceso);
+    }
+
+private:
+    std::vector<ReceptorEventos*> receptores;
+};
+
+#endif
@@ -0,0 +1,483 @@
+#ifndef REPARTO_GRUPOS_H
+#define REPARTO_GRUPOS_H
+
+#include <set>
+#include <string>
+#include <vector>
+#include <variant>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <memory_resource>
+#include "estructuras.h"
+#include "politicas.h"
+
+// Uso de la CPU de un grupo durante una corrida
+struct UsoGrupo {
+    std::string nombre;
+    int nivel = 0;              // Profundidad en la jerarquía (0: primer nivel)
+    int peso = 1;
+    size_t procesos = 0;
+    Tiempo cpu = 0;             // Ráfagas de CPU de sus procesos
+    double cuota = 0.0;         // cpu / CPU ocupada en la corrida
+    double cuotaObjetivo = 0.0; // Peso / pesos de los hermanos, en cada nivel
+    double cpuMerecida = 0.0;   // Su parte exacta de la CPU del padre mientras tuvo trabajo
+    double esperaPromedio = 0.0;
+    double respuestaPromedio = 0.0;
+    Tiempo respuestaObjetivo = 0;
+};
+
+// ------------------------------------------------------------
+// Jerarquía de grupos
+// ------------------------------------------------------------
+// Árbol con los grupos declarados en grupos.txt y los que nombra la
+// carga. El nodo 0 es la raíz; los procesos sin grupo van a un grupo de
+// primer nivel "(sin grupo)" de peso 1. Sin grupos declarados, cada
+// nombre de la carga es un grupo implícito de peso 1 (como los
+// dispositivos de E/S). Los procesos solo pueden estar en hojas.
+class ArbolGrupos {
+public:
+    struct Nodo {
+        std::string nombre;
+        int padre = -1;
+        int nivel = -1;
+        int peso = 1;
+        int algoritmo = -1;         // TipoAlgoritmo, o -1: el de la corrida
+        Tiempo respuestaObjetivo = 0;
+        bool declarado = false;
+        std::vector<int> hijos;
+        size_t procesos = 0;        // Propios (solo en hojas)
+    };
+
+    void configurar(const std::vector<Grupo>& declarados, const std::vector<Proceso>& procesos) {
+        nodos.assign(1, Nodo());
+        indice.clear();
+        for (const Grupo& g : declarados) {
+            Nodo& n = nodos[obtener(g.nombre)];
+            if (n.declarado) {
+                throw std::runtime_error("Grupo repetido: " + g.nombre);
+            }
+            n.declarado = true;
+            n.peso = g.peso;
+            n.respuestaObjetivo = g.respuestaObjetivo;
+            if (!g.algoritmo.empty()) {
+                n.algoritmo = algoritmoPorNombre(g);
+            }
+        }
+
+        grupoProceso.resize(procesos.size());
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            const std::string& nombre = procesos[i].grupo.empty() ? SIN_GRUPO : procesos[i].grupo;
+            auto it = indice.find(nombre);
+            if (it == indice.end() && !declarados.empty() && !procesos[i].grupo.empty()) {
+                throw std::runtime_error("Grupo desconocido en " + procesos[i].pid + ": " + nombre);
+            }
+            int g = it != indice.end() ? it->second : obtener(nombre);
+            grupoProceso[i] = g;
+            nodos[g].procesos++;
+        }
+        for (const Nodo& n : nodos) {
+            if (n.procesos > 0 && !n.hijos.empty()) {
+                throw std::runtime_error("El grupo " + n.nombre + " tiene subgrupos: sus procesos deben ir "
+                                         "en uno de ellos");
+            }
+        }
+
+        hojas.clear();
+        for (size_t g = 0; g < nodos.size(); ++g) {
+            if (nodos[g].procesos > 0) hojas.push_back(static_cast<int>(g));
+        }
+    }
+
+    const std::vector<Nodo>& getNodos() const { return nodos; }
+
+    // Grupos con procesos, en orden de creación
+    const std::vector<int>& getHojas() const { return hojas; }
+
+    int grupoDe(size_t proceso) const { return grupoProceso[proceso]; }
+
+    // Uso de cada grupo con procesos en la corrida, en preorden. La cuota
+    // objetivo reparte cada nivel entre los hermanos que tienen procesos;
+    // "merecida" es la CPU de cada nodo según PoliticaGrupos::getCpuMerecida.
+    std::vector<UsoGrupo> resumir(const std::vector<Proceso>& procesos,
+                                  const std::vector<double>& merecida) const {
+        struct Suma {
+            size_t procesos = 0;
+            Tiempo cpu = 0;
+            long long espera = 0;
+            long long respuesta = 0;
+        };
+        std::vector<Suma> suma(nodos.size());
+        Tiempo ocupado = 0;
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            const Proceso& p = procesos[i];
+            ocupado += p.burstTime;
+            for (int n = grupoProceso[i]; n > 0; n = nodos[n].padre) {
+                suma[n].procesos++;
+                suma[n].cpu += p.burstTime;
+                suma[n].espera += p.waitingTime;
+                suma[n].respuesta += p.responseTime;
+            }
+        }
+
+        std::vector<UsoGrupo> usos;
+        std::vector<double> objetivo(nodos.size(), 1.0);
+        std::vector<int> pendientes(nodos[0].hijos.rbegin(), nodos[0].hijos.rend());
+        while (!pendientes.empty()) {
+            int n = pendientes.back();
+            pendientes.pop_back();
+            if (suma[n].procesos == 0) continue;
+
+            const Nodo& nodo = nodos[n];
+            long long pesoHermanos = 0;
+            for (int h : nodos[nodo.padre].hijos) {
+                if (suma[h].procesos > 0) pesoHermanos += nodos[h].peso;
+            }
+            objetivo[n] = objetivo[nodo.padre] * nodo.peso / static_cast<double>(pesoHermanos);
+
+            UsoGrupo u;
+            u.nombre = nodo.nombre;
+            u.nivel = nodo.nivel;
+            u.peso = nodo.peso;
+            u.procesos = suma[n].procesos;
+            u.cpu = suma[n].cpu;
+            u.cuota = ocupado > 0 ? static_cast<double>(u.cpu) / static_cast<double>(ocupado) : 0.0;
+            u.cuotaObjetivo = objetivo[n];
+            u.cpuMerecida = n < static_cast<int>(merecida.size()) ? merecida[n] : 0.0;
+            u.esperaPromedio = static_cast<double>(suma[n].espera) / static_cast<double>(u.procesos);
+            u.respuestaPromedio = static_cast<double>(suma[n].respuesta) / static_cast<double>(u.procesos);
+            u.respuestaObjetivo = nodo.respuestaObjetivo;
+            usos.push_back(u);
+
+            pendientes.insert(pendientes.end(), nodo.hijos.rbegin(), nodo.hijos.rend());
+        }
+        return usos;
+    }
+
+private:
+    static constexpr const char* SIN_GRUPO = "(sin grupo)";
+
+    // Índice del grupo "nombre", creando él y sus ancestros si faltan
+    int obtener(const std::string& nombre) {
+        auto it = indice.find(nombre);
+        if (it != indice.end()) return it->second;
+
+        size_t separador = nombre.rfind('/');
+        int padre = separador == std::string::npos ? 0 : obtener(nombre.substr(0, separador));
+        Nodo n;
+        n.nombre = nombre;
+        n.padre = padre;
+        n.nivel = nodos[padre].nivel + 1;
+        int g = static_cast<int>(nodos.size());
+        nodos.push_back(n);
+        nodos[padre].hijos.push_back(g);
+        indice[nombre] = g;
+        return g;
+    }
+
+    static int algoritmoPorNombre(const Grupo& g) {
+        for (int t = FIFO; t <= PRIORITY; ++t) {
+            if (g.algoritmo == nombreAlgoritmo(static_cast<TipoAlgoritmo>(t))) return t;
+        }
+        throw std::runtime_error("Algoritmo desconocido en el grupo " + g.nombre + ": " + g.algoritmo);
+    }
+
+    std::vector<Nodo> nodos;
+    std::unordered_map<std::string, int> indice;
+    std::vector<int> grupoProceso;
+    std::vector<int> hojas;
+};
+
+// ------------------------------------------------------------
+// Política de un grupo
+// ------------------------------------------------------------
+// Cualquiera de las políticas de politicas.h, elegida al ejecutar (cada
+// grupo puede tener la suya). Reenvía los ganchos a la política activa.
+class PoliticaInterna {
+public:
+    PoliticaInterna(TipoAlgoritmo tipo, Tiempo quantum, std::pmr::memory_resource* memoria)
+        : politica(crear(tipo, quantum, memoria)) {}
+
+    void alLlegar(Proceso* p, Tiempo t) {
+        std::visit([&](auto& x) { x.alLlegar(p, t); }, politica);
+    }
+
+    Proceso* elegirSiguiente(Tiempo t) {
+        return std::visit([&](auto& x) { return x.elegirSiguiente(t); }, politica);
+    }
+
+    Tiempo tramo(const Proceso& p, Tiempo t, Tiempo proxima) const {
+        return std::visit([&](const auto& x) { return x.tramo(p, t, proxima); }, politica);
+    }
+
+    void alAvanzar(Proceso& p, Tiempo ejecutado) {
+        std::visit([&](auto& x) { x.alAvanzar(p, ejecutado); }, politica);
+    }
+
+    bool debeExpropiar(const Proceso& p, Tiempo t) const {
+        return std::visit([&](const auto& x) { return x.debeExpropiar(p, t); }, politica);
+    }
+
+    void alExpropiar(Proceso* p, Tiempo t) {
+        std::visit([&](auto& x) { x.alExpropiar(p, t); }, politica);
+    }
+
+    // Si una llegada puede expropiar a mitad de un tramo (SRTF)
+    bool expropiaPorLlegada() const { return std::holds_alternative<PoliticaSRTF>(politica); }
+
+private:
+    typedef std::variant<PoliticaFIFO, PoliticaSJF, PoliticaSRTF, PoliticaRoundRobin, PoliticaPriority> Variante;
+
+    static Variante crear(TipoAlgoritmo tipo, Tiempo quantum, std::pmr::memory_resource* memoria) {
+        switch (tipo) {
+            case FIFO:        return Variante(std::in_place_type<PoliticaFIFO>, memoria);
+            case SJF:         return Variante(std::in_place_type<PoliticaSJF>, memoria);
+            case SRTF:        return Variante(std::in_place_type<PoliticaSRTF>, memoria);
+            case ROUND_ROBIN: return Variante(std::in_place_type<PoliticaRoundRobin>, quantum, memoria);
+            case PRIORITY:    return Variante(std::in_place_type<PoliticaPriority>, memoria);
+        }
+        return Variante(std::in_place_type<PoliticaFIFO>, memoria);
+    }
+
+    Variante politica;
+};
+
+// ------------------------------------------------------------
+// Reparto justo jerárquico
+// ------------------------------------------------------------
+// Calendarización por pasos (stride) en cada nivel del árbol: un grupo
+// avanza su "pase" ejecutado / peso, y en cada nivel se elige al hermano
+// con trabajo de menor pase (un std::set por nodo, O(log n) por nivel).
+// Dentro de cada hoja decide su PoliticaInterna.
+//
+// Un grupo que se queda sin trabajo no acumula crédito: al volver
+// empieza en el "reloj" de su padre, el menor pase activo que se vio.
+// Para el reporte se integra además la CPU que "merece" cada grupo: de
+// cada tramo que recibe su padre, peso / (pesos de los hermanos con
+// trabajo), en O(1) por nivel.
+//
+// Mientras hay otro grupo con trabajo, los tramos se cortan cada
+// "rebanada" ciclos y en cada llegada, y el proceso en CPU cede si otro
+// grupo quedó con menor pase. Si su política no lo habría expropiado,
+// queda suspendido al frente de su grupo con el resto de su tramo
+// ("pendiente") y continúa cuando el grupo vuelve a la CPU; así el
+// reparto no cambia el orden dentro del grupo. Con un solo grupo con
+// procesos la política del grupo decide sola y el resultado es el mismo
+// que sin grupos.
+//
+// Las colas de los grupos usan la memoria de la corrida; los conjuntos
+// de hijos activos insertan y borran nodos en cada tramo, así que usan
+// "memoriaNodos", que debe reutilizar la memoria liberada (un pool, no la arena).
+class PoliticaGrupos : public Politica<PoliticaGrupos> {
+public:
+    PoliticaGrupos(const ArbolGrupos& a, TipoAlgoritmo tipo, Tiempo quantum, Tiempo rebanadaGrupos,
+                   const Proceso* primero, std::pmr::memory_resource* memoria,
+                   std::pmr::memory_resource* memoriaNodos)
+        : arbol(a), base(primero), rebanada(rebanadaGrupos),
+          variosGrupos(a.getHojas().size() > 1) {
+        const std::vector<ArbolGrupos::Nodo>& nodos = arbol.getNodos();
+        estado.reserve(nodos.size());
+        for (size_t n = 0; n < nodos.size(); ++n) {
+            estado.emplace_back(memoriaNodos);
+            estado.back().peso = nodos[n].peso;
+            estado.back().paso = 1.0 / nodos[n].peso;
+        }
+        internas.reserve(arbol.getHojas().size());
+        for (int g : arbol.getHojas()) {
+            int algoritmo = nodos[g].algoritmo >= 0 ? nodos[g].algoritmo : tipo;
+            estado[g].interna = static_cast<int>(internas.size());
+            internas.emplace_back(static_cast<TipoAlgoritmo>(algoritmo), quantum, memoria);
+        }
+    }
+
+    void alLlegar(Proceso* p, Tiempo t) {
+        int g = arbol.grupoDe(static_cast<size_t>(p - base));
+        interna(g).alLlegar(p, t);
+        listos++;
+        sumarTrabajo(g);
+    }
+
+    bool hayListos() const { return listos > 0; }
+
+    // Bajar por el árbol hasta la hoja de menor pase en cada nivel
+    Proceso* elegirSiguiente(Tiempo t) {
+        int n = 0;
+        while (estado[n].interna < 0) {
+            n = estado[n].activos.begin()->second;
+        }
+        EstadoNodo& e = estado[n];
+        PoliticaInterna& politica = interna(n);
+
+        Proceso* p = e.suspendido;
+        pendiente = 0;
+        if (p) {
+            e.suspendido = nullptr;
+            pendiente = e.pendiente;
+            // Las llegadas al grupo mientras estaba fuera pueden expropiarlo
+            if (politica.expropiaPorLlegada() && politica.debeExpropiar(*p, t)) {
+                politica.alExpropiar(p, t);
+                p = politica.elegirSiguiente(t);
+                pendiente = 0;
+            }
+        } else {
+            p = politica.elegirSiguiente(t);
+        }
+        listos--;
+        actual = n;
+        return p;
+    }
+
+    Tiempo tramo(const Proceso& p, Tiempo t, Tiempo proxima) {
+        Tiempo r = interna(actual).tramo(p, t, proxima);
+        if (pendiente > 0) {
+            r = std::min(r, pendiente);
+        }
+        planeado = r;
+        if (variosGrupos) {
+            // Hay otro grupo con trabajo si no todos los listos son del actual
+            if (listos + 1 > estado[actual].trabajo) {
+                r = std::min(r, rebanada);
+            }
+            r = std::min(r, proxima - t);
+        }
+        return r;
+    }
+
+    void alAvanzar(Proceso& p, Tiempo ejecutado) {
+        interna(actual).alAvanzar(p, ejecutado);
+        pendiente = planeado - ejecutado;
+        cargar(actual, ejecutado);
+        // Terminó su ráfaga: deja la CPU para terminar o pasar a E/S
+        if (p.remainingTime == 0) {
+            restarTrabajo(actual);
+            pendiente = 0;
+            actual = -1;
+        }
+    }
+
+    bool debeExpropiar(const Proceso& p, Tiempo t) {
+        expropiaInterna = pendiente == 0 && interna(actual).debeExpropiar(p, t);
+        return expropiaInterna || cedeGrupo();
+    }
+
+    void alExpropiar(Proceso* p, Tiempo t) {
+        if (expropiaInterna) {
+            interna(actual).alExpropiar(p, t);
+        } else {
+            estado[actual].suspendido = p;
+            estado[actual].pendiente = pendiente;
+        }
+        listos++;
+        actual = -1;
+    }
+
+    // Las corridas con grupos no guardan puntos de control (ver
+    // SimuladorCalendarizacion::puntoReanudacion)
+    void guardar(EstadoCola& e, const Proceso*) const { e.entradas.clear(); }
+
+    void restaurar(const EstadoCola&, Proceso*) {}
+
+    // CPU merecida por cada nodo del árbol hasta ahora
+    std::vector<double> getCpuMerecida() const {
+        std::vector<double> merecida(estado.size(), 0.0);
+        for (size_t n = 1; n < estado.size(); ++n) {
+            const EstadoNodo& e = estado[n];
+            merecida[n] = e.merecida;
+            if (e.trabajo > 0) {
+                merecida[n] += e.peso * (estado[padre(static_cast<int>(n))].integral - e.marca);
+            }
+        }
+        return merecida;
+    }
+
+private:
+    struct EstadoNodo {
+        explicit EstadoNodo(std::pmr::memory_resource* memoria) : activos(memoria) {}
+
+        double pase = 0.0;
+        double peso = 1.0;
+        double paso = 1.0;          // 1 / peso
+        double reloj = 0.0;         // Menor pase activo visto entre los hijos
+
+        // CPU merecida: "integral" suma ejecutado / pesoActivo de los
+        // tramos de los hijos; "marca" es la del padre al activarse
+        double pesoActivo = 0.0;
+        double integral = 0.0;
+        double marca = 0.0;
+        double merecida = 0.0;
+
+        int trabajo = 0;            // Procesos listos o en CPU en el subárbol (no en la raíz)
+        std::pmr::set<std::pair<double, int>> activos;  // Hijos con trabajo, por pase
+        int interna = -1;           // Índice en "internas" (solo hojas)
+        Proceso* suspendido = nullptr;
+        Tiempo pendiente = 0;
+    };
+
+    PoliticaInterna& interna(int g) { return internas[estado[g].interna]; }
+
+    int padre(int n) const { return arbol.getNodos()[n].padre; }
+
+    void sumarTrabajo(int g) {
+        for (int n = g; n > 0; n = padre(n)) {
+            if (estado[n].trabajo++ == 0) {
+                EstadoNodo& p = estado[padre(n)];
+                double referencia = p.activos.empty() ? p.reloj : std::max(p.reloj, p.activos.begin()->first);
+                estado[n].pase = std::max(estado[n].pase, referencia);
+                p.activos.insert({estado[n].pase, n});
+                p.pesoActivo += estado[n].peso;
+                estado[n].marca = p.integral;
+            }
+        }
+    }
+
+    void restarTrabajo(int g) {
+        for (int n = g; n > 0; n = padre(n)) {
+            if (--estado[n].trabajo == 0) {
+                EstadoNodo& p = estado[padre(n)];
+                p.activos.erase({estado[n].pase, n});
+                p.pesoActivo -= estado[n].peso;
+                estado[n].merecida += estado[n].peso * (p.integral - estado[n].marca);
+            }
+        }
+    }
+
+    // Cobrar "ejecutado" ciclos a la hoja g y a sus ancestros
+    void cargar(int g, Tiempo ejecutado) {
+        for (int n = g; n > 0; n = padre(n)) {
+            EstadoNodo& p = estado[padre(n)];
+            p.activos.erase({estado[n].pase, n});
+            estado[n].pase += static_cast<double>(ejecutado) * estado[n].paso;
+            p.activos.insert({estado[n].pase, n});
+            p.reloj = std::max(p.reloj, p.activos.begin()->first);
+            p.integral += static_cast<double>(ejecutado) / p.pesoActivo;
+        }
+    }
+
+    // Si en algún nivel otro hermano con trabajo tiene menor pase
+    bool cedeGrupo() const {
+        for (int n = actual; n > 0; n = padre(n)) {
+            const auto& primero = *estado[padre(n)].activos.begin();
+            if (primero.second != n && primero.first < estado[n].pase) return true;
+        }
+        return false;
+    }
+
+    const ArbolGrupos& arbol;
+    const Proceso* base;
+    Tiempo rebanada;
+    bool variosGrupos;
+
+    std::vector<EstadoNodo> estado;
+    std::vector<PoliticaInterna> internas;
+    long long listos = 0;
+
+    // Hoja del proceso en CPU, lo que le falta del tramo que pidió su
+    // política y si la última expropiación la decidió ella
+    int actual = -1;
+    Tiempo planeado = 0;
+    Tiempo pendiente = 0;
+    bool expropiaInterna = false;
+};
+
+#endif
@@ -0,0 +1,273 @@
+#ifndef SERVIDOR_EVENTOS_H
+#define SERVIDOR_EVENTOS_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "estructuras.h"
+#include "receptor_eventos.h"
+#include "protocolo_eventos.h"
+
+// Publica la simulación por un socket Unix a un cliente (la interfaz
+// gráfica) con el protocolo de protocolo_eventos.h. Cada algoritmo se
+// publica con su propio receptor, obtenido con grupo(), que se conecta a
+// la salida del simulador.
+//
+// Los mensajes se acumulan en un buffer que se envía al llenarse, cada
+// INTERVALO_VACIADO o con vaciar(). Sin créditos, la escritura bloquea
+// (y con ella la simulación) hasta que el cliente los devuelve. Si el
+// cliente se desconecta o viola el protocolo (un mensaje truncado o una
+// concesión de créditos no positiva), la simulación sigue sin publicar.
+class ServidorEventos {
+public:
+    explicit ServidorEventos(const std::string& rutaSocket)
+        : ruta(rutaSocket), escucha(-1), cliente(-1), creditos(0),
+          ventanaDesde(0), ventanaHasta(TIEMPO_MAXIMO), ultimoVaciado(std::chrono::steady_clock::now()) {
+        sockaddr_un direccion = direccionDe(ruta);
+        escucha = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (escucha < 0) {
+            throw std::runtime_error(std::string("No se pudo crear el socket: ") + std::strerror(errno));
+        }
+        ::unlink(ruta.c_str());
+        if (::bind(escucha, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 ||
+            ::listen(escucha, 1) < 0) {
+            std::string error = std::strerror(errno);
+            ::close(escucha);
+            throw std::runtime_error("No se pudo escuchar en " + ruta + ": " + error);
+        }
+    }
+
+    ~ServidorEventos() {
+        if (cliente >= 0) ::close(cliente);
+        if (escucha >= 0) ::close(escucha);
+        ::unlink(ruta.c_str());
+    }
+
+    ServidorEventos(const ServidorEventos&) = delete;
+    ServidorEventos& operator=(const ServidorEventos&) = delete;
+
+    // Bloquea hasta que se conecte un cliente
+    void esperarCliente() {
+        while (cliente < 0) {
+            cliente = ::accept(escucha, nullptr, nullptr);
+            if (cliente < 0 && errno != EINTR) {
+                throw std::runtime_error(std::string("Error al aceptar el cliente: ") + std::strerror(errno));
+            }
+        }
+    }
+
+    bool conectado() const { return cliente >= 0; }
+
+    // Anunciar un algoritmo y obtener el receptor que publica sus eventos
+    ReceptorEventos* grupo(const std::string& nombre) {
+        int64_t indice = static_cast<int64_t>(grupos.size());
+        grupos.emplace_back(new ReceptorGrupo(*this, indice));
+        if (gastarCredito()) {
+            EscritorMensajes m(salida);
+            m.iniciar(MENSAJE_GRUPO);
+            m.entero(indice);
+            m.texto(nombre);
+            m.terminar();
+            talVezVaciar();
+        }
+        return grupos.back().get();
+    }
+
+    // Anunciar un proceso (antes de sus eventos)
+    void declararProceso(const Proceso& p) {
+        if (!gastarCredito()) return;
+        EscritorMensajes m(salida);
+        m.iniciar(MENSAJE_PROCESO);
+        m.texto(p.pid);
+        m.entero(p.burstTime);
+        m.entero(p.arrivalTime);
+        m.entero(p.priority);
+        m.terminar();
+        talVezVaciar();
+    }
+
+    // Enviar lo acumulado y atender los mensajes de control pendientes
+    void vaciar() {
+        ultimoVaciado = std::chrono::steady_clock::now();
+        if (cliente < 0) {
+            salida.clear();
+            return;
+        }
+        size_t enviado = 0;
+        while (enviado < salida.size()) {
+            ssize_t n = ::send(cliente, salida.data() + enviado, salida.size() - enviado, MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                desconectar();
+                return;
+            }
+            enviado += static_cast<size_t>(n);
+        }
+        salida.clear();
+        leerControl(false);
+    }
+
+    // Avisar que no habrá más mensajes
+    void terminar() {
+        if (cliente >= 0) {
+            EscritorMensajes m(salida);
+            m.iniciar(MENSAJE_FIN);
+            m.terminar();
+        }
+        vaciar();
+    }
+
+private:
+    static const size_t TAMANO_VACIADO = 64 * 1024;
+    static constexpr std::chrono::milliseconds INTERVALO_VACIADO{50};
+
+    class ReceptorGrupo : public ReceptorEventos {
+    public:
+        ReceptorGrupo(ServidorEventos& s, int64_t i) : servidor(s), indice(i) {}
+        void alEvento(const EventoGantt& e) override { servidor.enviarEvento(indice, e); }
+        void alTerminar(const Proceso& p) override { servidor.enviarTerminado(indice, p); }
+
+    private:
+        ServidorEventos& servidor;
+        int64_t indice;
+    };
+
+    std::string ruta;
+    int escucha;
+    int cliente;
+    long long creditos;
+    Tiempo ventanaDesde;
+    Tiempo ventanaHasta;
+    std::vector<std::unique_ptr<ReceptorGrupo>> grupos;
+    std::vector<char> salida;
+    std::vector<char> entrada;
+    std::chrono::steady_clock::time_point ultimoVaciado;
+
+    static sockaddr_un direccionDe(const std::string& ruta) {
+        sockaddr_un direccion;
+        std::memset(&direccion, 0, sizeof(direccion));
+        direccion.sun_family = AF_UNIX;
+        if (ruta.size() >= sizeof(direccion.sun_path)) {
+            throw std::runtime_error("Ruta de socket demasiado larga: " + ruta);
+        }
+        std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+        return direccion;
+    }
+
+    void enviarEvento(int64_t grupo, const EventoGantt& e) {
+        // Solo los eventos que se cruzan con la ventana [desde, hasta)
+        if (e.fin <= ventanaDesde || e.inicio >= ventanaHasta) return;
+        if (!gastarCredito()) return;
+        EscritorMensajes m(salida);
+        m.iniciar(MENSAJE_EVENTO);
+        m.entero(grupo);
+        m.texto(e.pid);
+        m.entero(e.inicio);
+        m.entero(e.fin);
+        m.texto(e.estado);
+        m.terminar();
+        talVezVaciar();
+    }
+
+    void enviarTerminado(int64_t grupo, const Proceso& p) {
+        if (!gastarCredito()) return;
+        EscritorMensajes m(salida);
+        m.iniciar(MENSAJE_TERMINADO);
+        m.entero(grupo);
+        m.texto(p.pid);
+        m.entero(p.waitingTime);
+        m.entero(p.responseTime);
+        m.entero(p.completionTime);
+        m.terminar();
+        talVezVaciar();
+    }
+
+    void talVezVaciar() {
+        if (salida.size() >= TAMANO_VACIADO ||
+            std::chrono::steady_clock::now() - ultimoVaciado >= INTERVALO_VACIADO) {
+            vaciar();
+        }
+    }
+
+    // false si no hay cliente. Sin créditos, envía lo pendiente y espera
+    // a que el cliente conceda más.
+    bool gastarCredito() {
+        while (cliente >= 0 && creditos <= 0) {
+            vaciar();
+            if (cliente >= 0 && creditos <= 0) leerControl(true);
+        }
+        if (cliente < 0) return false;
+        creditos--;
+        return true;
+    }
+
+    void leerControl(bool bloquear) {
+        if (cliente < 0) return;
+        if (bloquear) {
+            pollfd p{cliente, POLLIN, 0};
+            while (::poll(&p, 1, -1) < 0 && errno == EINTR) {}
+        }
+        char bloque[4096];
+        while (true) {
+            ssize_t n = ::recv(cliente, bloque, sizeof(bloque), MSG_DONTWAIT);
+            if (n > 0) {
+                entrada.insert(entrada.end(), bloque, bloque + n);
+                continue;
+            }
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                desconectar();
+                return;
+            }
+            if (errno != EINTR) break;
+        }
+
+        size_t pos = 0;
+        try {
+            while (size_t largo = mensajeCompleto(entrada, pos)) {
+                LectorMensaje m(entrada.data() + pos + TAMANO_CABECERA, largo - TAMANO_CABECERA);
+                switch (static_cast<TipoMensaje>(entrada[pos])) {
+                    case MENSAJE_CREDITO: {
+                        // Una concesión no positiva (0, o negativa leída con
+                        // signo) es un error del cliente: sumarla dejaría al
+                        // servidor sin crédito o con uno desbordado
+                        int32_t n = static_cast<int32_t>(m.entero32());
+                        if (n <= 0) {
+                            desconectar();
+                            return;
+                        }
+                        creditos += n;
+                        break;
+                    }
+                    case MENSAJE_VENTANA:
+                        ventanaDesde = m.entero();
+                        ventanaHasta = m.entero();
+                        break;
+                    default:
+                        break;
+                }
+                pos += largo;
+            }
+        } catch (const std::runtime_error&) {
+            desconectar();
+            return;
+        }
+        entrada.erase(entrada.begin(), entrada.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+
+    void desconectar() {
+        if (cliente >= 0) ::close(cliente);
+        cliente = -1;
+        salida.clear();
+        entrada.clear();
+    }
+};
+
+#endif
@@ -2,441 +2,886 @@
 #define SIMULADOR_CALENDARIZACION_H
 
 #include <vector>
-#include <queue>
+#include <memory>
 #include <algorithm>
+#include <climits>
+#include <stdexcept>
 #include "estructuras.h"
+#include "politicas.h"
+#include "receptor_eventos.h"
+#include "instrumentacion.h"
+#include "arena.h"
+#include "metricas.h"
+#include "dispositivos_es.h"
+#include "almacen_eventos.h"
+#include "reparto_grupos.h"
+#include "energia_dvfs.h"
 
-enum TipoAlgoritmo {
-    FIFO,
-    SJF,
-    SRTF,
-    ROUND_ROBIN,
-    PRIORITY
+// Carga de trabajo de solo lectura, compartida entre simuladores,
+// resultados y la interfaz sin copiarla
+typedef std::shared_ptr<const std::vector<Proceso>> CargaCompartida;
+
+inline CargaCompartida compartirCarga(std::vector<Proceso> procesos) {
+    return std::make_shared<const std::vector<Proceso>>(std::move(procesos));
+}
+
+// Rendimiento de una corrida, entre la primera llegada y el último fin:
+// fracción del tiempo con la CPU ocupada, procesos terminados por ciclo,
+// el uso de cada dispositivo de E/S (vacío si la carga no tiene E/S), el
+// de cada grupo del reparto justo (vacío si no hay grupos) y la energía
+// consumida (sin gobernador si no hay DVFS)
+struct Rendimiento {
+    Tiempo duracion = 0;
+    double utilizacionCPU = 0.0;
+    double throughput = 0.0;
+    std::vector<UsoDispositivo> dispositivos;
+    std::vector<UsoGrupo> grupos;
+    ConsumoEnergia energia;
+};
+
+// Resultado de ejecutar un algoritmo. Las columnas por proceso siguen el
+// orden de la carga: la fila i corresponde a (*carga)[i].
+struct ResultadoSimulacion {
+    TipoAlgoritmo algoritmo = FIFO;
+    CargaCompartida carga;
+    std::vector<EventoGantt> eventos;
+    
+    // Con setAlmacenEventos los eventos quedan en un archivo mapeado en
+    // memoria (almacen_eventos.h) y "eventos" queda vacío
+    std::shared_ptr<const AlmacenEventos> almacen;
+    
+    std::vector<Tiempo> espera;
+    std::vector<Tiempo> respuesta;
+    std::vector<Tiempo> finalizacion;
+    std::vector<Tiempo> inicio;
+    
+    // Resúmenes de las columnas (suma exacta en 64 bits, mínimo, máximo
+    // y varianza); ver metricas.h
+    ResumenColumna resumenEspera;
+    ResumenColumna resumenRespuesta;
+    ResumenColumna resumenFinalizacion;
+    
+    double avgWaitingTime = 0.0;
+    double avgCompletionTime = 0.0;
+    double avgResponseTime = 0.0;
+    
+    Rendimiento rendimiento;
 };
 
 class SimuladorCalendarizacion {
 protected:
+    // Carga de entrada y copia de trabajo con el estado de cada proceso
+    // (una por simulador, se reutiliza entre algoritmos)
+    CargaCompartida carga;
     std::vector<Proceso> procesos;
     std::vector<EventoGantt> eventos;
-    int tiempoActual;
-    int quantum;
+    Tiempo tiempoActual;
+    Tiempo quantum;
+    TipoAlgoritmo ultimoAlgoritmo;
+    
+    // Salida de eventos: se pueden retener en memoria, enviar a un
+    // receptor mientras se simula, o ambas cosas
+    ReceptorEventos* receptor;
+    bool retenerEventos;
+    
+    // Almacén fuera de memoria de los eventos retenidos (uno nuevo por
+    // corrida, ya que el anterior puede estar en un resultado)
+    bool usarAlmacen;
+    std::string directorioAlmacen;
+    std::shared_ptr<AlmacenEventos> almacen;
+    
+    // Contadores y tiempos por fase de la última ejecución
+    Estadisticas estadisticas;
+    
+    // Memoria de los contenedores de cada corrida; se rebobina en cada
+    // ejecutar() en lugar de liberarse
+    ArenaSimulacion arena;
+    
+    // Memoria de los contenedores de nodos que se insertan y borran en
+    // cada tramo (reparto entre grupos): el pool reutiliza lo liberado,
+    // donde la arena crecería con el largo de la corrida
+    std::pmr::unsynchronized_pool_resource memoriaNodos;
+    
+    // Dispositivos de E/S declarados (vacío: implícitos, ver
+    // BancoDispositivos::configurar) y su estado en la corrida
+    std::vector<Dispositivo> dispositivos;
+    BancoDispositivos banco;
+    bool cargaConES;
+    bool bancoValido;
+    
+    // Grupos del reparto justo declarados (vacío: implícitos, ver
+    // ArbolGrupos::configurar) y la rebanada entre grupos (0: el quantum)
+    std::vector<Grupo> grupos;
+    ArbolGrupos arbol;
+    Tiempo rebanadaGrupos;
+    bool cargaConGrupos;
+    bool arbolValido;
+    std::vector<double> cpuMerecida;    // De la última corrida, por nodo del árbol
+    
+    // Frecuencia de la CPU y energía (inactivo sin setDVFS)
+    ControlDVFS dvfs;
     
 public:
-    SimuladorCalendarizacion() : tiempoActual(0), quantum(2) {}
+    SimuladorCalendarizacion()
+        : tiempoActual(0), quantum(2), ultimoAlgoritmo(FIFO), receptor(nullptr), retenerEventos(true),
+          usarAlmacen(false), cargaConES(false), bancoValido(false),
+          rebanadaGrupos(0), cargaConGrupos(false), arbolValido(false),
+          ordenValido(false), numPuntos(0), intervaloPuntos(INTERVALO_PUNTOS_INICIAL), maximoPuntos(0),
+          corridaValida(false), quantumCorrida(0), procesosCorrida(0),
+          hayEventoAbierto(false), eventoAbierto("", 0, 0), indiceAbierto(-1) {}
     
-    // Cargar procesos
+    virtual ~SimuladorCalendarizacion() {}
+    
+    // Cargar procesos (se copian a una carga compartida nueva)
     void cargarProcesos(const std::vector<Proceso>& procs) {
-        procesos = procs;
+        cargarCarga(compartirCarga(procs));
+    }
+    
+    // Cargar una carga compartida. Si es la misma que ya estaba cargada no
+    // se vuelve a copiar: ejecutar() reinicia el estado de cada proceso
+    void cargarCarga(const CargaCompartida& nueva) {
+        if (nueva != carga) {
+            carga = nueva;
+            procesos = *carga;
+            ordenValido = false;
+            corridaValida = false;
+            cargaConES = std::any_of(procesos.begin(), procesos.end(),
+                                     [](const Proceso& p) { return p.tieneES(); });
+            bancoValido = false;
+            revisarGrupos();
+            alCargarProcesos();
+        }
         eventos.clear();
+        almacen.reset();
         tiempoActual = 0;
     }
     
+    // Agregar un proceso al final de la carga conservando la última
+    // corrida: ejecutarIncremental() la reanuda desde antes de su llegada
+    void agregarProceso(const Proceso& p) {
+        std::vector<Proceso> nueva = carga ? *carga : std::vector<Proceso>();
+        nueva.push_back(p);
+        carga = compartirCarga(std::move(nueva));
+        procesos.push_back(p);
+        
+        // El nuevo índice es el mayor: va después de los que llegan a la vez
+        if (ordenValido) {
+            auto pos = std::upper_bound(ordenLlegada.begin(), ordenLlegada.end(), p.arrivalTime,
+                [this](Tiempo llegada, int i) { return llegada < procesos[i].arrivalTime; });
+            ordenLlegada.insert(pos, static_cast<int>(procesos.size() - 1));
+        }
+        cargaConES = cargaConES || p.tieneES();
+        bancoValido = false;
+        cargaConGrupos = cargaConGrupos || !p.grupo.empty();
+        arbolValido = false;
+        alCargarProcesos();
+    }
+    
+    const CargaCompartida& getCarga() const { return carga; }
+    
+    // Dispositivos de E/S de las ráfagas de la carga
+    void setDispositivos(const std::vector<Dispositivo>& d) {
+        dispositivos = d;
+        bancoValido = false;
+    }
+    
+    // Grupos del reparto justo jerárquico. Con grupos declarados o con
+    // procesos que nombran uno, la CPU se reparte entre grupos según su
+    // peso y el algoritmo de la corrida (o el propio del grupo) ordena los
+    // procesos dentro de cada grupo.
+    void setGrupos(const std::vector<Grupo>& g) {
+        grupos = g;
+        revisarGrupos();
+    }
+    
+    // Ciclos que corre un grupo antes de que otro con menor pase pueda
+    // quitarle la CPU (0: el quantum)
+    void setRebanadaGrupos(Tiempo rebanada) {
+        if (rebanada < 0) {
+            throw std::runtime_error("La rebanada entre grupos no puede ser negativa");
+        }
+        rebanadaGrupos = rebanada;
+    }
+    
+    // Escalar la CPU con un modelo DVFS: antes de cada tramo el gobernador
+    // elige la frecuencia, los tramos duran más a frecuencias menores y la
+    // corrida reporta la energía consumida (ver energia_dvfs.h). Sin
+    // gobernador se desactiva.
+    void setDVFS(const ModeloDVFS& modelo, std::unique_ptr<Gobernador> gobernador) {
+        dvfs.configurar(modelo, std::move(gobernador));
+        corridaValida = false;
+    }
+    
+    void setDVFS(const ModeloDVFS& modelo, TipoGobernador tipo) {
+        setDVFS(modelo, crearGobernador(tipo));
+    }
+    
+    bool conDVFS() const { return dvfs.activo(); }
+    
+    // Modelo DVFS en uso, con los niveles de menor a mayor frecuencia
+    const ModeloDVFS& getDVFS() const { return dvfs.getModelo(); }
+    
     // Configurar quantum para Round Robin
-    void setQuantum(int q) { quantum = q; }
-    int getQuantum() const { return quantum; }
+    void setQuantum(Tiempo q) {
+        if (q <= 0) {
+            throw std::runtime_error("El quantum debe ser positivo");
+        }
+        quantum = q;
+    }
+    Tiempo getQuantum() const { return quantum; }
+    
+    // Enviar cada tramo terminado a un receptor (nullptr para ninguno)
+    void setReceptor(ReceptorEventos* r) { receptor = r; }
+    
+    // Con false los eventos solo llegan al receptor y getEventos() queda
+    // vacío; la memoria ya no crece con el tamaño del diagrama
+    void setRetenerEventos(bool retener) { retenerEventos = retener; }
+    
+    // Retener los eventos en un archivo mapeado en memoria dentro de
+    // "directorio" (vacío: $TMPDIR o /tmp) en lugar de getEventos(); el
+    // diagrama queda limitado por el disco y no por la RAM
+    void setAlmacenEventos(bool activo, const std::string& directorio = "") {
+        if (activo != usarAlmacen) {
+            corridaValida = false;
+        }
+        usarAlmacen = activo;
+        directorioAlmacen = directorio;
+    }
+    
+    // Almacén de la última corrida (nulo sin setAlmacenEventos)
+    std::shared_ptr<const AlmacenEventos> getAlmacen() const { return almacen; }
+    
+    // Guardar hasta "maximo" puntos de control por corrida (0 los
+    // desactiva). Cuando se llenan se descarta uno de cada dos y se
+    // duplica el intervalo, así que quedan repartidos en toda la corrida.
+    void setPuntosControl(size_t maximo) {
+        maximoPuntos = maximo == 0 ? 0 : std::max<size_t>(2, maximo);
+        numPuntos = 0;
+        corridaValida = false;
+    }
     
     // Ejecutar simulación según el algoritmo
     void ejecutar(TipoAlgoritmo tipo) {
-        eventos.clear();
-        tiempoActual = 0;
-        
-        // Resetear valores de los procesos
-        for (auto& p : procesos) {
-            p.remainingTime = p.burstTime;
-            p.waitingTime = 0;
-            p.completionTime = 0;
-            p.startTime = -1;
-            p.started = false;
+        correr(tipo, -1);
+    }
+    
+    // Igual que ejecutar(), pero si solo cambió el quantum o se agregaron
+    // procesos desde la corrida anterior del mismo algoritmo, reanuda desde
+    // el último punto de control previo a la primera diferencia posible.
+    // Las estadísticas y el receptor solo ven la parte re-simulada.
+    void ejecutarIncremental(TipoAlgoritmo tipo) {
+        correr(tipo, puntoReanudacion(tipo));
+    }
+    
+    // Bytes que la arena de las corridas pidió al sistema (no baja al
+    // rebobinarla): depende del máximo de procesos activos, no del largo
+    // de la corrida. El pool de nodos no se cuenta: reutiliza lo liberado.
+    size_t getMemoriaCorrida() const { return arena.capacidad(); }
+    
+    // Instrumentación de la última ejecución (en cero si se compiló sin
+    // SIMULADOR_INSTRUMENTACION)
+    const Estadisticas& getEstadisticas() const { return estadisticas; }
+    
+    // Obtener eventos para el diagrama de Gantt (vacío si se retienen
+    // en un almacén)
+    const std::vector<EventoGantt>& getEventos() const { return eventos; }
+    
+    // Recorrer los eventos retenidos, estén en memoria o en el almacén
+    template <class F>
+    void recorrerEventos(F f) const {
+        if (almacen) {
+            for (size_t k = 0; k < almacen->tamano(); ++k) f(almacen->evento(k));
+        } else {
+            for (const auto& e : eventos) f(e);
+        }
+    }
+    
+    // Entregar el resultado de la última ejecución. Los eventos se mueven
+    // al resultado (getEventos() queda vacío) y la carga se comparte
+    ResultadoSimulacion tomarResultado() {
+        ResultadoSimulacion r;
+        r.algoritmo = ultimoAlgoritmo;
+        r.carga = carga;
+        // Con puntos de control los eventos se copian: la próxima corrida
+        // incremental conserva los anteriores al punto de reanudación
+        if (maximoPuntos > 0) {
+            r.eventos = eventos;
+        } else {
+            r.eventos = std::move(eventos);
+            eventos.clear();
+        }
+        // El almacén se comparte: la próxima corrida escribe en uno nuevo
+        r.almacen = almacen;
+        if (maximoPuntos == 0) {
+            almacen.reset();
         }
         
-        switch(tipo) {
-            case FIFO:
-                ejecutarFIFO();
-                break;
-            case SJF:
-                ejecutarSJF();
-                break;
-            case SRTF:
-                ejecutarSRTF();
-                break;
-            case ROUND_ROBIN:
-                ejecutarRoundRobin();
-                break;
-            case PRIORITY:
-                ejecutarPriority();
-                break;
-        }
-    }
-    
-    // Obtener eventos para el diagrama de Gantt
-    std::vector<EventoGantt> getEventos() const { return eventos; }
-    
-    // Calcular métricas
-    float getAvgWaitingTime() const {
-        float total = 0;
+        r.espera.reserve(procesos.size());
+        r.respuesta.reserve(procesos.size());
+        r.finalizacion.reserve(procesos.size());
+        r.inicio.reserve(procesos.size());
         for (const auto& p : procesos) {
-            total += p.waitingTime;
+            r.espera.push_back(p.waitingTime);
+            r.respuesta.push_back(p.responseTime);
+            r.finalizacion.push_back(p.completionTime);
+            r.inicio.push_back(p.startTime);
         }
-        return procesos.empty() ? 0 : total / procesos.size();
+        
+        r.resumenEspera = resumirColumna(r.espera);
+        r.resumenRespuesta = resumirColumna(r.respuesta);
+        r.resumenFinalizacion = resumirColumna(r.finalizacion);
+        r.avgWaitingTime = r.resumenEspera.media;
+        r.avgCompletionTime = r.resumenFinalizacion.media;
+        r.avgResponseTime = r.resumenRespuesta.media;
+        r.rendimiento = getRendimiento();
+        return r;
     }
     
-    float getAvgCompletionTime() const {
-        float total = 0;
+    // Rendimiento de la última ejecución. Todos los procesos terminan, así
+    // que la CPU estuvo ocupada la suma de sus ciclos en CPU (sus BT, salvo
+    // con DVFS a menor frecuencia).
+    Rendimiento getRendimiento() const {
+        Rendimiento r;
+        if (procesos.empty()) return r;
+        Tiempo primera = TIEMPO_MAXIMO;
+        Tiempo ultima = 0;
+        long long ocupado = 0;
         for (const auto& p : procesos) {
-            total += p.completionTime;
+            primera = std::min(primera, p.arrivalTime);
+            ultima = std::max(ultima, p.completionTime);
+            ocupado += p.tiempoCPU;
+        }
+        r.duracion = std::max<Tiempo>(0, ultima - primera);
+        if (r.duracion > 0) {
+            r.utilizacionCPU = static_cast<double>(ocupado) / static_cast<double>(r.duracion);
+            r.throughput = static_cast<double>(procesos.size()) / static_cast<double>(r.duracion);
+        }
+        if (cargaConES) {
+            r.dispositivos = banco.resumir(r.duracion);
         }
-        return procesos.empty() ? 0 : total / procesos.size();
+        if (cargaConGrupos && arbolValido) {
+            r.grupos = arbol.resumir(procesos, cpuMerecida);
+        }
+        if (dvfs.activo()) {
+            r.energia = dvfs.resumir();
+        }
+        return r;
+    }
+    
+    // Calcular métricas (suma en 64 bits: exacta con cualquier cantidad
+    // de procesos; para columnas completas ver tomarResultado)
+    double getAvgWaitingTime() const {
+        return promedio(&Proceso::waitingTime);
+    }
+    
+    double getAvgCompletionTime() const {
+        return promedio(&Proceso::completionTime);
+    }
+    
+    double getAvgResponseTime() const {
+        return promedio(&Proceso::responseTime);
+    }
+    
+private:
+    // Iteraciones entre puntos de control al iniciar una corrida completa
+    static const long long INTERVALO_PUNTOS_INICIAL = 256;
+    
+    // Estado de un proceso admitido y sin terminar en un punto de control
+    struct EstadoProceso {
+        int indice;
+        Tiempo remainingTime;
+        Tiempo startTime;
+        Tiempo responseTime;
+        Tiempo tiempoCPU;
+        bool started;
+    };
+    
+    // Foto del ciclo de simulación al inicio de una iteración. Los
+    // procesos que ya terminaron no se guardan: sus métricas siguen en
+    // "procesos" desde la corrida anterior.
+    struct PuntoControl {
+        long long iteracion = 0;
+        Tiempo tiempo = 0;
+        size_t siguiente = 0;      // Cursor en ordenLlegada
+        int actual = -1;           // Proceso en CPU, o -1
+        Tiempo maxRestante = 0;    // Mayor tiempo restante al iniciar un tramo antes del punto
+        size_t numEventos = 0;
+        bool hayEventoAbierto = false;
+        EventoGantt eventoAbierto{"", 0, 0};
+        int indiceAbierto = -1;
+        EstadoCola cola;
+        std::vector<EstadoProceso> enVuelo;
+    };
+    
+    // Índices de los procesos por llegada (empates por orden de carga);
+    // se conserva entre corridas mientras la carga no cambie
+    std::vector<int> ordenLlegada;
+    bool ordenValido;
+    
+    // Los objetos de "puntos" se reutilizan entre corridas; solo los
+    // primeros numPuntos son válidos
+    std::vector<PuntoControl> puntos;
+    size_t numPuntos;
+    long long intervaloPuntos;
+    size_t maximoPuntos;
+    
+    // Parámetros de la corrida a la que pertenecen los puntos
+    bool corridaValida;
+    Tiempo quantumCorrida;
+    size_t procesosCorrida;
+    
+    bool admitePuntos() const {
+        return !cargaConES && !cargaConGrupos && !dvfs.activo();
+    }
+    
+    void revisarGrupos() {
+        cargaConGrupos = !grupos.empty() ||
+                         std::any_of(procesos.begin(), procesos.end(),
+                                     [](const Proceso& p) { return !p.grupo.empty(); });
+        arbolValido = false;
+    }
+    
+    size_t eventosRetenidos() const {
+        return almacen ? almacen->tamano() : eventos.size();
     }
     
-    float getAvgResponseTime() const {
-        float total = 0;
+    double promedio(Tiempo Proceso::* campo) const {
+        long long total = 0;
         for (const auto& p : procesos) {
-            total += p.responseTime;
+            total += p.*campo;
         }
-        return procesos.empty() ? 0 : total / procesos.size();
+        return procesos.empty() ? 0.0 : static_cast<double>(total) / static_cast<double>(procesos.size());
     }
     
-private:
-    // Implementación de FIFO (First In First Out)
-    void ejecutarFIFO() {
-        // Ordenar por tiempo de llegada
-        std::sort(procesos.begin(), procesos.end(), 
-            [](const Proceso& a, const Proceso& b) {
-                return a.arrivalTime < b.arrivalTime;
+    static void reiniciarProceso(Proceso& p) {
+        p.remainingTime = p.duracionRafaga(0);
+        p.rafaga = 0;
+        p.tiempoES = 0;
+        p.tiempoCPU = 0;
+        p.waitingTime = 0;
+        p.completionTime = 0;
+        p.startTime = -1;
+        p.responseTime = 0;
+        p.started = false;
+    }
+    
+    void prepararOrden() {
+        if (ordenValido) return;
+        ordenLlegada.resize(procesos.size());
+        for (size_t i = 0; i < ordenLlegada.size(); ++i) {
+            ordenLlegada[i] = static_cast<int>(i);
+        }
+        std::sort(ordenLlegada.begin(), ordenLlegada.end(),
+            [this](int a, int b) {
+                if (procesos[a].arrivalTime != procesos[b].arrivalTime) {
+                    return procesos[a].arrivalTime < procesos[b].arrivalTime;
+                }
+                return a < b;
             });
+        ordenValido = true;
+    }
+    
+    // Último punto de control válido para reanudar con los parámetros
+    // actuales, o -1 si hay que simular desde el inicio. Hasta el punto
+    // elegido la corrida nueva es idéntica a la anterior:
+    //  - un proceso agregado que llega en "a" no cambia ningún tramo que
+    //    termine antes de "a" (los tramos se cortan en la próxima llegada);
+    //  - con Round Robin, un tramo dura min(quantum, restante), que no
+    //    cambia si restante <= min(quantum anterior, quantum nuevo).
+    // Las colas de los dispositivos, el estado del reparto entre grupos y
+    // el del gobernador DVFS no se guardan: una carga con E/S o con grupos,
+    // o una corrida con DVFS, siempre se simula completa.
+    int puntoReanudacion(TipoAlgoritmo tipo) const {
+        if (!corridaValida || !admitePuntos() || tipo != ultimoAlgoritmo || !puedeReanudar()) {
+            return -1;
+        }
         
-        tiempoActual = 0;
+        Tiempo limiteTiempo = TIEMPO_MAXIMO;
+        for (size_t i = procesosCorrida; i < procesos.size(); ++i) {
+            limiteTiempo = std::min(limiteTiempo, procesos[i].arrivalTime);
+        }
+        Tiempo limiteRestante = TIEMPO_MAXIMO;
+        if (tipo == ROUND_ROBIN && quantum != quantumCorrida) {
+            limiteRestante = std::min(quantum, quantumCorrida);
+        }
         
-        for (auto& p : procesos) {
-            // Si el CPU está idle, avanzar al tiempo de llegada
-            if (tiempoActual < p.arrivalTime) {
-                tiempoActual = p.arrivalTime;
+        // Ambas condiciones son monótonas: basta el último que las cumple
+        for (size_t k = numPuntos; k-- > 0;) {
+            const PuntoControl& punto = puntos[k];
+            if (punto.tiempo <= limiteTiempo && punto.maxRestante <= limiteRestante &&
+                punto.numEventos <= eventosRetenidos()) {
+                return static_cast<int>(k);
             }
-            
-            // Marcar inicio
-            p.startTime = tiempoActual;
-            p.responseTime = p.startTime - p.arrivalTime;
-            p.waitingTime = tiempoActual - p.arrivalTime;
-            
-            // Ejecutar proceso completo
-            eventos.push_back(EventoGantt(p.pid, tiempoActual, 
-                                         tiempoActual + p.burstTime));
-            
-            tiempoActual += p.burstTime;
-            p.completionTime = tiempoActual;
-            p.remainingTime = 0;
         }
+        return -1;
     }
     
-    // Implementación de SJF (Shortest Job First)
-    void ejecutarSJF() {
-        std::vector<Proceso*> listos;
-        std::vector<Proceso*> pendientes;
-        
-        // Crear punteros a los procesos
-        for (auto& p : procesos) {
-            pendientes.push_back(&p);
-        }
+    // Ejecutar desde el inicio (desde = -1) o desde el punto de control
+    // "desde" de la corrida anterior
+    void correr(TipoAlgoritmo tipo, int desde) {
+        estadisticas.reiniciar();
+        INSTR_TOTAL(estadisticas);
         
+        ultimoAlgoritmo = tipo;
         tiempoActual = 0;
+        prepararOrden();
         
-        while (!pendientes.empty() || !listos.empty()) {
-            // Mover procesos que han llegado a la cola de listos
-            auto it = pendientes.begin();
-            while (it != pendientes.end()) {
-                if ((*it)->arrivalTime <= tiempoActual) {
-                    listos.push_back(*it);
-                    it = pendientes.erase(it);
-                } else {
-                    ++it;
-                }
+        // Con almacén, uno nuevo con los eventos previos al punto de control
+        std::shared_ptr<AlmacenEventos> anterior = std::move(almacen);
+        almacen.reset();
+        if (usarAlmacen && retenerEventos) {
+            almacen = std::make_shared<AlmacenEventos>(procesos, directorioAlmacen);
+            if (desde >= 0 && anterior) {
+                almacen->agregarPrefijo(*anterior, puntos[desde].numEventos);
             }
+        }
+        anterior.reset();
+        
+        if (desde < 0) {
+            eventos.clear();
+            hayEventoAbierto = false;
             
-            if (listos.empty() && !pendientes.empty()) {
-                // CPU idle - avanzar al siguiente arrival
-                tiempoActual = (*std::min_element(pendientes.begin(), 
-                    pendientes.end(), [](Proceso* a, Proceso* b) {
-                        return a->arrivalTime < b->arrivalTime;
-                    }))->arrivalTime;
-                continue;
-            }
-            
-            // Ordenar por burst time (shortest first)
-            std::sort(listos.begin(), listos.end(), 
-                [](Proceso* a, Proceso* b) {
-                    return a->burstTime < b->burstTime;
-                });
-            
-            // Ejecutar el proceso más corto
-            if (!listos.empty()) {
-                Proceso* p = listos.front();
-                listos.erase(listos.begin());
-                
-                p->startTime = tiempoActual;
-                p->responseTime = p->startTime - p->arrivalTime;
-                p->waitingTime = tiempoActual - p->arrivalTime;
-                
-                eventos.push_back(EventoGantt(p->pid, tiempoActual, 
-                                             tiempoActual + p->burstTime));
-                
-                tiempoActual += p->burstTime;
-                p->completionTime = tiempoActual;
-                p->remainingTime = 0;
+            // Resetear valores de los procesos
+            for (auto& p : procesos) {
+                reiniciarProceso(p);
             }
+        } else {
+            restaurarProcesos(puntos[desde]);
         }
-    }
-    
-    // Implementación de SRTF (Shortest Remaining Time First)
-    void ejecutarSRTF() {
-        std::vector<Proceso*> pendientes;
-        std::vector<Proceso*> listos;
-        Proceso* procesoActual = nullptr;
         
-        // Crear punteros a los procesos
-        for (auto& p : procesos) {
-            pendientes.push_back(&p);
+        if (cargaConES && !bancoValido) {
+            banco.configurar(dispositivos, procesos);
+            bancoValido = true;
         }
+        banco.reiniciar();
+        arena.reiniciar();
+        if (dvfs.activo() && !ordenLlegada.empty()) {
+            dvfs.reiniciar(procesos[ordenLlegada[0]].arrivalTime);
+        }
+        alIniciarCorrida();
         
-        tiempoActual = 0;
-        
-        while (!pendientes.empty() || !listos.empty() || procesoActual) {
-            // Mover procesos que han llegado a la cola de listos
-            auto it = pendientes.begin();
-            while (it != pendientes.end()) {
-                if ((*it)->arrivalTime <= tiempoActual) {
-                    listos.push_back(*it);
-                    it = pendientes.erase(it);
-                } else {
-                    ++it;
-                }
+        if (cargaConGrupos) {
+            if (!arbolValido) {
+                arbol.configurar(grupos, procesos);
+                arbolValido = true;
             }
-            
-            // Si hay un proceso en ejecución, verificar si debe ser reemplazado
-            if (procesoActual && procesoActual->remainingTime > 0) {
-                // Buscar si hay un proceso con menor tiempo restante
-                Proceso* menorTiempo = procesoActual;
-                for (auto* p : listos) {
-                    if (p->remainingTime < menorTiempo->remainingTime) {
-                        menorTiempo = p;
-                    }
+            PoliticaGrupos politica(arbol, tipo, quantum, rebanadaGrupos > 0 ? rebanadaGrupos : quantum,
+                                    procesos.data(), &arena, &memoriaNodos);
+            simular(politica, desde);
+            cpuMerecida = politica.getCpuMerecida();
+        } else {
+            // Cada política instancia su propia versión del ciclo de simulación
+            switch(tipo) {
+                case FIFO: {
+                    PoliticaFIFO politica(&arena);
+                    simular(politica, desde);
+                    break;
                 }
-                
-                // Si hay un proceso con menor tiempo, hacer cambio de contexto
-                if (menorTiempo != procesoActual) {
-                    listos.push_back(procesoActual);
-                    procesoActual = menorTiempo;
-                    listos.erase(std::find(listos.begin(), listos.end(), menorTiempo));
+                case SJF: {
+                    PoliticaSJF politica(&arena);
+                    simular(politica, desde);
+                    break;
                 }
-            }
-            
-            // Si no hay proceso actual, seleccionar el de menor tiempo restante
-            if (!procesoActual && !listos.empty()) {
-                // Ordenar por tiempo restante
-                std::sort(listos.begin(), listos.end(), 
-                    [](Proceso* a, Proceso* b) {
-                        return a->remainingTime < b->remainingTime;
-                    });
-                
-                procesoActual = listos.front();
-                listos.erase(listos.begin());
-            }
-            
-            // Si hay un proceso para ejecutar
-            if (procesoActual) {
-                // Marcar inicio si es la primera vez
-                if (!procesoActual->started) {
-                    procesoActual->startTime = tiempoActual;
-                    procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
-                    procesoActual->started = true;
+                case SRTF: {
+                    PoliticaSRTF politica(&arena);
+                    simular(politica, desde);
+                    break;
                 }
-                
-                // Ejecutar por 1 unidad de tiempo
-                int inicioEvento = tiempoActual;
-                procesoActual->remainingTime--;
-                tiempoActual++;
-                
-                // Registrar evento
-                eventos.push_back(EventoGantt(procesoActual->pid, inicioEvento, tiempoActual));
-                
-                // Si el proceso terminó
-                if (procesoActual->remainingTime == 0) {
-                    procesoActual->completionTime = tiempoActual;
-                    procesoActual->waitingTime = procesoActual->completionTime - 
-                                               procesoActual->arrivalTime - 
-                                               procesoActual->burstTime;
-                    procesoActual = nullptr;
+                case ROUND_ROBIN: {
+                    PoliticaRoundRobin politica(quantum, &arena);
+                    simular(politica, desde);
+                    break;
+                }
+                case PRIORITY: {
+                    PoliticaPriority politica(&arena);
+                    simular(politica, desde);
+                    break;
                 }
-            } else if (!pendientes.empty()) {
-                // CPU idle - avanzar al siguiente arrival
-                tiempoActual = (*std::min_element(pendientes.begin(), 
-                    pendientes.end(), [](Proceso* a, Proceso* b) {
-                        return a->arrivalTime < b->arrivalTime;
-                    }))->arrivalTime;
             }
         }
+        
+        cerrarEvento();
+        
+        corridaValida = maximoPuntos > 0 && admitePuntos();
+        quantumCorrida = quantum;
+        procesosCorrida = procesos.size();
     }
     
-    // Implementación de Round Robin
-    void ejecutarRoundRobin() {
-        std::queue<Proceso*> colaListos;
-        std::vector<Proceso*> pendientes;
-        Proceso* procesoActual = nullptr;
-        int tiempoQuantum = 0;
+    // Dejar procesos y eventos como estaban en el punto de control
+    void restaurarProcesos(const PuntoControl& punto) {
+        // Los que aún no llegaban vuelven a su estado inicial
+        for (size_t i = punto.siguiente; i < ordenLlegada.size(); ++i) {
+            reiniciarProceso(procesos[ordenLlegada[i]]);
+        }
+        for (const auto& e : punto.enVuelo) {
+            Proceso& p = procesos[e.indice];
+            p.remainingTime = e.remainingTime;
+            p.startTime = e.startTime;
+            p.responseTime = e.responseTime;
+            p.tiempoCPU = e.tiempoCPU;
+            p.started = e.started;
+            p.waitingTime = 0;
+            p.completionTime = 0;
+        }
         
-        // Crear punteros a los procesos
-        for (auto& p : procesos) {
-            pendientes.push_back(&p);
+        // (con almacén, correr() ya copió los anteriores al punto)
+        if (!almacen) {
+            eventos.erase(eventos.begin() + static_cast<std::ptrdiff_t>(punto.numEventos), eventos.end());
+        }
+        hayEventoAbierto = punto.hayEventoAbierto;
+        eventoAbierto = punto.eventoAbierto;
+        indiceAbierto = punto.indiceAbierto;
+    }
+    
+    template <class P>
+    void guardarPunto(const P& politica, long long iteracion, size_t siguiente,
+                      const Proceso* actual, Tiempo maxRestante) {
+        if (numPuntos == maximoPuntos) {
+            // Conservar los puntos pares (múltiplos del nuevo intervalo)
+            for (size_t i = 1; 2 * i < numPuntos; ++i) {
+                std::swap(puntos[i], puntos[2 * i]);
+            }
+            numPuntos = (numPuntos + 1) / 2;
+            intervaloPuntos *= 2;
+            if (iteracion % intervaloPuntos != 0) return;
+        }
+        if (numPuntos == puntos.size()) {
+            puntos.emplace_back();
         }
         
-        // Ordenar pendientes por tiempo de llegada
-        std::sort(pendientes.begin(), pendientes.end(), 
-            [](Proceso* a, Proceso* b) {
-                return a->arrivalTime < b->arrivalTime;
-            });
+        PuntoControl& punto = puntos[numPuntos++];
+        punto.iteracion = iteracion;
+        punto.tiempo = tiempoActual;
+        punto.siguiente = siguiente;
+        punto.actual = actual ? static_cast<int>(actual - procesos.data()) : -1;
+        punto.maxRestante = maxRestante;
+        punto.numEventos = eventosRetenidos();
+        punto.hayEventoAbierto = hayEventoAbierto;
+        punto.eventoAbierto = eventoAbierto;
+        punto.indiceAbierto = indiceAbierto;
         
-        tiempoActual = 0;
+        politica.guardar(punto.cola, procesos.data());
+        punto.enVuelo.clear();
+        for (const auto& e : punto.cola.entradas) {
+            const Proceso& p = procesos[e.indice];
+            punto.enVuelo.push_back({e.indice, p.remainingTime, p.startTime, p.responseTime, p.tiempoCPU, p.started});
+        }
+        if (actual) {
+            punto.enVuelo.push_back({punto.actual, actual->remainingTime, actual->startTime,
+                                     actual->responseTime, actual->tiempoCPU, actual->started});
+        }
+    }
+    
+    // Ciclo genérico de simulación, especializado en compilación para
+    // cada política (ver politicas.h). Se encarga de la admisión por
+    // orden de llegada, las ráfagas de E/S, los eventos de Gantt, las
+    // métricas por proceso y los puntos de control.
+    template <class P>
+    void simular(P& politica, int desde) {
+        size_t siguiente = 0;
+        Proceso* procesoActual = nullptr;
+        long long iteracion = 0;
+        Tiempo maxRestante = 0;
         
-        while (!pendientes.empty() || !colaListos.empty() || procesoActual) {
-            // Mover procesos que han llegado a la cola de listos
-            auto it = pendientes.begin();
-            while (it != pendientes.end()) {
-                if ((*it)->arrivalTime <= tiempoActual) {
-                    colaListos.push(*it);
-                    it = pendientes.erase(it);
-                } else {
-                    ++it;
-                }
+        if (desde >= 0) {
+            const PuntoControl& punto = puntos[desde];
+            politica.restaurar(punto.cola, procesos.data());
+            tiempoActual = punto.tiempo;
+            siguiente = punto.siguiente;
+            procesoActual = punto.actual >= 0 ? &procesos[punto.actual] : nullptr;
+            iteracion = punto.iteracion;
+            maxRestante = punto.maxRestante;
+            // Los puntos posteriores se vuelven a tomar (este incluido)
+            numPuntos = static_cast<size_t>(desde);
+        } else {
+            numPuntos = 0;
+            intervaloPuntos = INTERVALO_PUNTOS_INICIAL;
+        }
+        
+        const size_t total = ordenLlegada.size();
+        while (siguiente < total || politica.hayListos() || procesoActual || banco.activo()) {
+            if (maximoPuntos > 0 && admitePuntos() && iteracion % intervaloPuntos == 0) {
+                guardarPunto(politica, iteracion, siguiente, procesoActual, maxRestante);
             }
+            iteracion++;
             
-            // Si el proceso actual agotó su quantum o terminó
-            if (procesoActual && (tiempoQuantum >= quantum || procesoActual->remainingTime == 0)) {
-                if (procesoActual->remainingTime > 0) {
-                    // Volver a la cola si no ha terminado
-                    colaListos.push(procesoActual);
+            // Mover a la cola de listos los procesos que han llegado y los
+            // que volvieron de E/S, en orden de tiempo (en un empate,
+            // primero las llegadas)
+            {
+                INSTR_FASE(estadisticas, FASE_ADMISION);
+                while (true) {
+                    Tiempo llegada = siguiente < total
+                                   ? procesos[ordenLlegada[siguiente]].arrivalTime : TIEMPO_MAXIMO;
+                    Tiempo regreso = banco.proximaFinalizacion();
+                    if (llegada <= tiempoActual && llegada <= regreso) {
+                        Proceso* p = &procesos[ordenLlegada[siguiente]];
+                        politica.alLlegar(p, p->arrivalTime);
+                        siguiente++;
+                    } else if (regreso <= tiempoActual) {
+                        volverDeES(politica, banco.terminar());
+                    } else {
+                        break;
+                    }
                 }
-                procesoActual = nullptr;
-                tiempoQuantum = 0;
             }
             
-            // Seleccionar siguiente proceso si no hay uno actual
-            if (!procesoActual && !colaListos.empty()) {
-                procesoActual = colaListos.front();
-                colaListos.pop();
-                tiempoQuantum = 0;
+            {
+                INSTR_FASE(estadisticas, FASE_SELECCION);
                 
-                // Marcar inicio si es la primera vez
-                if (!procesoActual->started) {
-                    procesoActual->startTime = tiempoActual;
-                    procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
-                    procesoActual->started = true;
+                // Cambio de contexto si la política lo pide
+                if (procesoActual && politica.debeExpropiar(*procesoActual, tiempoActual)) {
+                    politica.alExpropiar(procesoActual, tiempoActual);
+                    procesoActual = nullptr;
+                    INSTR_CONTAR(estadisticas, expropiaciones);
+                }
+                
+                // Seleccionar siguiente proceso si no hay uno actual
+                if (!procesoActual && politica.hayListos()) {
+                    procesoActual = politica.elegirSiguiente(tiempoActual);
+                    INSTR_CONTAR(estadisticas, despachos);
+                    
+                    // Marcar inicio si es la primera vez
+                    if (!procesoActual->started) {
+                        procesoActual->startTime = tiempoActual;
+                        procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
+                        procesoActual->started = true;
+                    }
                 }
             }
             
-            // Ejecutar proceso actual
             if (procesoActual) {
-                int inicioEvento = tiempoActual;
-                int tiempoEjecucion = std::min(quantum - tiempoQuantum, 
-                                              procesoActual->remainingTime);
+                // Un regreso de E/S puede cambiar la decisión igual que una llegada
+                Tiempo proximaLlegada = siguiente < total
+                                      ? procesos[ordenLlegada[siguiente]].arrivalTime : TIEMPO_MAXIMO;
+                proximaLlegada = std::min(proximaLlegada, banco.proximaFinalizacion());
+                maxRestante = std::max(maxRestante, procesoActual->remainingTime);
+                int indice = static_cast<int>(procesoActual - procesos.data());
                 
-                procesoActual->remainingTime -= tiempoEjecucion;
+                // Con DVFS la política decide el tramo en trabajo (ciclos a
+                // la frecuencia más alta) y el reloj avanza lo que tarda al
+                // nivel elegido
+                Tiempo trabajo;
+                Tiempo tiempoEjecucion;
+                if (dvfs.activo()) {
+                    Tiempo cambio = dvfs.antesDeTramo(tiempoActual);
+                    if (cambio > 0) {
+                        cerrarEvento();
+                        publicarEvento(EventoGantt(procesoActual->pid, tiempoActual, tiempoActual + cambio,
+                                                   "OVERHEAD"), indice);
+                        tiempoActual += cambio;
+                        procesoActual->tiempoCPU += cambio;
+                    }
+                    Tiempo limite = proximaLlegada == TIEMPO_MAXIMO
+                                  ? TIEMPO_MAXIMO : tiempoActual + dvfs.trabajoEn(proximaLlegada - tiempoActual);
+                    trabajo = politica.tramo(*procesoActual, tiempoActual, limite);
+                    tiempoEjecucion = dvfs.duracionDe(trabajo);
+                    dvfs.alEjecutar(tiempoEjecucion);
+                } else {
+                    trabajo = tiempoEjecucion = politica.tramo(*procesoActual, tiempoActual, proximaLlegada);
+                }
+                Tiempo inicioEvento = tiempoActual;
+                
+                procesoActual->remainingTime -= trabajo;
+                procesoActual->tiempoCPU += tiempoEjecucion;
                 tiempoActual += tiempoEjecucion;
-                tiempoQuantum += tiempoEjecucion;
+                politica.alAvanzar(*procesoActual, trabajo);
                 
-                // Registrar evento
-                eventos.push_back(EventoGantt(procesoActual->pid, inicioEvento, tiempoActual));
+                registrarEvento(indice, inicioEvento, tiempoActual);
                 
-                // Si el proceso terminó
-                if (procesoActual->remainingTime == 0) {
+                // Si terminó la ráfaga: pasa a su dispositivo, o terminó el proceso
+                if (procesoActual->remainingTime == 0 &&
+                    procesoActual->rafaga + 1 < procesoActual->numRafagas()) {
+                    banco.solicitar(indice, procesoActual->rafaga, *procesoActual, tiempoActual);
+                    procesoActual = nullptr;
+                } else if (procesoActual->remainingTime == 0) {
                     procesoActual->completionTime = tiempoActual;
                     procesoActual->waitingTime = procesoActual->completionTime - 
                                                procesoActual->arrivalTime - 
-                                               procesoActual->burstTime;
+                                               procesoActual->tiempoCPU -
+                                               procesoActual->tiempoES;
+                    if (receptor) {
+                        receptor->alTerminar(*procesoActual);
+                    }
+                    procesoActual = nullptr;
                 }
-            } else if (!pendientes.empty()) {
-                // CPU idle - avanzar al siguiente arrival
-                tiempoActual = pendientes.front()->arrivalTime;
+            } else if (siguiente < total || banco.activo()) {
+                // CPU idle - avanzar al siguiente arrival o fin de E/S
+                Tiempo llegada = siguiente < total
+                               ? procesos[ordenLlegada[siguiente]].arrivalTime : TIEMPO_MAXIMO;
+                Tiempo hasta = std::min(llegada, banco.proximaFinalizacion());
+                if (dvfs.activo()) {
+                    dvfs.alOcioso(tiempoActual, hasta);
+                }
+                tiempoActual = hasta;
             }
         }
     }
     
-    // Implementación de Priority con envejecimiento
-    void ejecutarPriority() {
-        std::vector<Proceso*> pendientes;
-        std::vector<Proceso*> listos;
-        
-        // Crear punteros a los procesos y agregar edad inicial
-        for (auto& p : procesos) {
-            pendientes.push_back(&p);
+    // Un proceso terminó su ráfaga de E/S: se publica el tramo (desde la
+    // solicitud, cola incluida) y vuelve a la cola de listos con su
+    // siguiente ráfaga de CPU
+    template <class P>
+    void volverDeES(P& politica, const BancoDispositivos::Terminada& t) {
+        Proceso* p = &procesos[t.proceso];
+        p->tiempoES += t.fin - t.solicitud;
+        p->rafaga++;
+        p->remainingTime = p->duracionRafaga(p->rafaga);
+        publicarEvento(EventoGantt(p->pid, t.solicitud, t.fin, "IO"), t.proceso);
+        politica.alLlegar(p, t.fin);
+    }
+    
+    // Registrar un tramo de ejecución; si continúa el tramo anterior del
+    // mismo proceso sin interrupción se extiende en lugar de duplicarlo
+    void registrarEvento(int indice, Tiempo inicio, Tiempo fin) {
+        if (hayEventoAbierto && eventoAbierto.fin == inicio && indiceAbierto == indice) {
+            eventoAbierto.fin = fin;
+            return;
         }
-        
-        tiempoActual = 0;
-        int tiempoUltimaActualizacion = 0;
-        
-        while (!pendientes.empty() || !listos.empty()) {
-            // Mover procesos que han llegado a la cola de listos
-            auto it = pendientes.begin();
-            while (it != pendientes.end()) {
-                if ((*it)->arrivalTime <= tiempoActual) {
-                    listos.push_back(*it);
-                    it = pendientes.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-            
-            // Aplicar envejecimiento cada 5 unidades de tiempo
-            if (tiempoActual - tiempoUltimaActualizacion >= 5) {
-                for (auto* p : listos) {
-                    if (p->priority > 1) {
-                        p->priority--;  // Mejorar prioridad (1 es la más alta)
-                    }
-                }
-                tiempoUltimaActualizacion = tiempoActual;
-            }
-            
-            if (listos.empty() && !pendientes.empty()) {
-                // CPU idle - avanzar al siguiente arrival
-                tiempoActual = (*std::min_element(pendientes.begin(), 
-                    pendientes.end(), [](Proceso* a, Proceso* b) {
-                        return a->arrivalTime < b->arrivalTime;
-                    }))->arrivalTime;
-                continue;
-            }
-            
-            // Ordenar por prioridad (1 = más alta prioridad)
-            // En caso de empate, usar FIFO (arrival time)
-            std::sort(listos.begin(), listos.end(), 
-                [](Proceso* a, Proceso* b) {
-                    if (a->priority == b->priority) {
-                        return a->arrivalTime < b->arrivalTime;
-                    }
-                    return a->priority < b->priority;
-                });
-            
-            // Ejecutar el proceso de mayor prioridad
-            if (!listos.empty()) {
-                Proceso* p = listos.front();
-                listos.erase(listos.begin());
-                
-                p->startTime = tiempoActual;
-                p->responseTime = p->startTime - p->arrivalTime;
-                p->waitingTime = tiempoActual - p->arrivalTime;
-                
-                eventos.push_back(EventoGantt(p->pid, tiempoActual, 
-                                             tiempoActual + p->burstTime));
-                
-                tiempoActual += p->burstTime;
-                p->completionTime = tiempoActual;
-                p->remainingTime = 0;
-                
-                // Restaurar prioridad original para futuras simulaciones
-                for (auto& proc : procesos) {
-                    if (proc.pid == p->pid) {
-                        p->priority = proc.priority;
-                        break;
-                    }
-                }
-            }
+        cerrarEvento();
+        eventoAbierto = EventoGantt(procesos[indice].pid, inicio, fin);
+        indiceAbierto = indice;
+        hayEventoAbierto = true;
+    }
+    
+    void cerrarEvento() {
+        if (hayEventoAbierto) {
+            hayEventoAbierto = false;
+            publicarEvento(eventoAbierto, indiceAbierto);
+        }
+    }
+    
+    bool hayEventoAbierto;
+    EventoGantt eventoAbierto;
+    int indiceAbierto;
+    
+protected:
+    // Puntos de extensión para las clases derivadas: tras cargar procesos,
+    // al iniciar cada corrida (la arena ya está rebobinada) y para
+    // posprocesar cada tramo del calendario
+    virtual void alCargarProcesos() {}
+    
+    virtual void alIniciarCorrida() {}
+    
+    // Si la corrida puede reanudarse desde un punto de control (el estado
+    // propio de la clase derivada no se guarda en ellos)
+    virtual bool puedeReanudar() const { return true; }
+    
+    // "proceso" es el índice del proceso del evento en la carga
+    virtual void publicarEvento(const EventoGantt& evento, int proceso) {
+        emitir(evento, proceso);
+    }
+    
+    void emitir(const EventoGantt& evento, int proceso) {
+        INSTR_FASE(estadisticas, FASE_EMISION);
+        INSTR_CONTAR(estadisticas, eventosEmitidos);
+        if (almacen) {
+            almacen->agregar(evento, proceso);
+        } else if (retenerEventos) {
+            eventos.push_back(evento);
+        }
+        if (receptor) {
+            receptor->alEvento(evento);
         }
     }
 };
@@ -0,0 +1,262 @@
+#ifndef SIMULADOR_EN_LINEA_H
+#define SIMULADOR_EN_LINEA_H
+
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "estructuras.h"
+#include "politicas.h"
+#include "receptor_eventos.h"
+#include "simulador_calendarizacion.h"
+
+// Métricas acumuladas de los procesos terminados hasta el momento
+struct MetricasEnLinea {
+    long long terminados = 0;
+    long long activos = 0;    // Llegados y sin terminar
+    long long maxActivos = 0; // Pico de activos (memoria usada)
+    long double sumaEspera = 0;
+    long double sumaRespuesta = 0;
+    long double sumaFinalizacion = 0;
+    Tiempo maxEspera = 0;
+
+    double promedioEspera() const { return promedio(sumaEspera); }
+    double promedioRespuesta() const { return promedio(sumaRespuesta); }
+    double promedioFinalizacion() const { return promedio(sumaFinalizacion); }
+
+private:
+    double promedio(long double suma) const {
+        return terminados == 0 ? 0.0 : static_cast<double>(suma / terminados);
+    }
+};
+
+// ------------------------------------------------------------
+// Simulador en línea
+// ------------------------------------------------------------
+// Calendariza procesos que se entregan de uno en uno con llegada(), en
+// orden de llegada, en lugar de cargar toda la carga antes de ejecutar.
+// Usa las mismas políticas y el mismo ciclo que SimuladorCalendarizacion
+// y produce el mismo calendario que una corrida completa sobre la carga
+// ordenada por llegada.
+//
+// Cada llamada avanza la simulación todo lo posible con lo que se sabe:
+// un tramo solo se decide cuando se conoce la próxima llegada (o cuando
+// finalizar() indica que no habrá más). Los tramos terminados salen por
+// el receptor y los procesos terminados se descartan después de avisar
+// con alTerminar(), así que la memoria depende de los procesos activos,
+// no de la historia.
+class SimuladorEnLinea {
+public:
+    SimuladorEnLinea(TipoAlgoritmo tipo, Tiempo quantum)
+        : algoritmo(tipo), receptor(nullptr), tiempoActual(0), ultimaLlegada(0),
+          finalizado(false), procesoActual(nullptr),
+          hayEventoAbierto(false), eventoAbierto("", 0, 0) {
+        switch (tipo) {
+            case FIFO:        motor.reset(new MotorCon<PoliticaFIFO>(PoliticaFIFO(&memoria))); break;
+            case SJF:         motor.reset(new MotorCon<PoliticaSJF>(PoliticaSJF(&memoria))); break;
+            case SRTF:        motor.reset(new MotorCon<PoliticaSRTF>(PoliticaSRTF(&memoria))); break;
+            case ROUND_ROBIN: motor.reset(new MotorCon<PoliticaRoundRobin>(PoliticaRoundRobin(quantum, &memoria))); break;
+            case PRIORITY:    motor.reset(new MotorCon<PoliticaPriority>(PoliticaPriority(&memoria))); break;
+        }
+    }
+
+    SimuladorEnLinea(const SimuladorEnLinea&) = delete;
+    SimuladorEnLinea& operator=(const SimuladorEnLinea&) = delete;
+
+    void setReceptor(ReceptorEventos* r) { receptor = r; }
+
+    // Entregar el siguiente proceso. Las llegadas deben venir en orden
+    // no decreciente; las que llegan a la vez se atienden en el orden en
+    // que se entregan.
+    void llegada(const Proceso& p) {
+        if (finalizado) {
+            throw std::runtime_error("La simulación en línea ya terminó");
+        }
+        if (p.arrivalTime < ultimaLlegada) {
+            throw std::runtime_error("Llegada fuera de orden: " + p.pid + " llega en " +
+                                     std::to_string(p.arrivalTime) + ", antes de " +
+                                     std::to_string(ultimaLlegada));
+        }
+        if (p.tieneES()) {
+            throw std::runtime_error("El modo en línea no admite ráfagas de E/S: " + p.pid);
+        }
+        if (!p.grupo.empty()) {
+            throw std::runtime_error("El modo en línea no admite grupos: " + p.pid);
+        }
+        ultimaLlegada = p.arrivalTime;
+
+        Proceso* slot = reservar(p);
+        slot->remainingTime = slot->burstTime;
+        pendientes.push_back(slot);
+        metricas.activos++;
+        metricas.maxActivos = std::max(metricas.maxActivos, metricas.activos);
+
+        motor->avanzar(*this);
+    }
+
+    // No habrá más llegadas: simular hasta que terminen todos
+    void finalizar() {
+        if (finalizado) return;
+        finalizado = true;
+        motor->avanzar(*this);
+        cerrarEvento();
+    }
+
+    TipoAlgoritmo getAlgoritmo() const { return algoritmo; }
+    Tiempo getTiempoActual() const { return tiempoActual; }
+    const MetricasEnLinea& getMetricas() const { return metricas; }
+
+private:
+    // El tipo de la política solo se conoce en ejecución; el motor la
+    // guarda y llama a la versión del ciclo especializada para ella
+    struct Motor {
+        virtual ~Motor() {}
+        virtual void avanzar(SimuladorEnLinea& s) = 0;
+    };
+
+    template <class P>
+    struct MotorCon : Motor {
+        explicit MotorCon(P p) : politica(std::move(p)) {}
+        void avanzar(SimuladorEnLinea& s) override { s.avanzar(politica); }
+        P politica;
+    };
+
+    TipoAlgoritmo algoritmo;
+    ReceptorEventos* receptor;
+    MetricasEnLinea metricas;
+
+    // Las colas de las políticas crecen y se vacían durante toda la
+    // corrida: un pool reutiliza los bloques liberados (una arena
+    // monótona crecería con la historia)
+    std::pmr::unsynchronized_pool_resource memoria;
+    std::unique_ptr<Motor> motor;
+
+    // Procesos activos. Los de procesos terminados se reutilizan, así
+    // que el almacén crece hasta el pico de activos; deque no mueve los
+    // elementos y los punteros de las colas siguen siendo válidos.
+    std::deque<Proceso> almacen;
+    std::vector<Proceso*> libres;
+
+    // Entregados que aún no llegan (arrivalTime > tiempoActual)
+    std::deque<Proceso*> pendientes;
+
+    Tiempo tiempoActual;
+    Tiempo ultimaLlegada;
+    bool finalizado;
+    Proceso* procesoActual;
+
+    Proceso* reservar(const Proceso& p) {
+        if (libres.empty()) {
+            almacen.push_back(p);
+            return &almacen.back();
+        }
+        Proceso* slot = libres.back();
+        libres.pop_back();
+        *slot = p;
+        return slot;
+    }
+
+    void terminar(Proceso* p) {
+        p->completionTime = tiempoActual;
+        p->waitingTime = p->completionTime - p->arrivalTime - p->burstTime;
+
+        metricas.terminados++;
+        metricas.activos--;
+        metricas.sumaEspera += p->waitingTime;
+        metricas.sumaRespuesta += p->responseTime;
+        metricas.sumaFinalizacion += p->completionTime;
+        metricas.maxEspera = std::max(metricas.maxEspera, p->waitingTime);
+
+        if (receptor) {
+            receptor->alTerminar(*p);
+        }
+        libres.push_back(p);
+    }
+
+    // El ciclo de SimuladorCalendarizacion::simular con las llegadas
+    // pendientes en lugar del arreglo ordenado de la carga. Se detiene
+    // cuando el siguiente tramo depende de una llegada desconocida.
+    template <class P>
+    void avanzar(P& politica) {
+        while (true) {
+            // Mover procesos que han llegado a la cola de listos
+            while (!pendientes.empty() && pendientes.front()->arrivalTime <= tiempoActual) {
+                Proceso* p = pendientes.front();
+                pendientes.pop_front();
+                politica.alLlegar(p, p->arrivalTime);
+            }
+
+            // Sin llegadas conocidas por delante puede faltar alguna que
+            // llegue ahora o que acorte el próximo tramo
+            if (pendientes.empty() && !finalizado) return;
+            if (pendientes.empty() && !politica.hayListos() && !procesoActual) return;
+
+            // Cambio de contexto si la política lo pide
+            if (procesoActual && politica.debeExpropiar(*procesoActual, tiempoActual)) {
+                politica.alExpropiar(procesoActual, tiempoActual);
+                procesoActual = nullptr;
+            }
+
+            // Seleccionar siguiente proceso si no hay uno actual
+            if (!procesoActual && politica.hayListos()) {
+                procesoActual = politica.elegirSiguiente(tiempoActual);
+
+                // Marcar inicio si es la primera vez
+                if (!procesoActual->started) {
+                    procesoActual->startTime = tiempoActual;
+                    procesoActual->responseTime = procesoActual->startTime - procesoActual->arrivalTime;
+                    procesoActual->started = true;
+                }
+            }
+
+            if (procesoActual) {
+                Tiempo proximaLlegada = pendientes.empty() ? TIEMPO_MAXIMO : pendientes.front()->arrivalTime;
+                Tiempo tiempoEjecucion = politica.tramo(*procesoActual, tiempoActual, proximaLlegada);
+                Tiempo inicioEvento = tiempoActual;
+
+                procesoActual->remainingTime -= tiempoEjecucion;
+                tiempoActual += tiempoEjecucion;
+                politica.alAvanzar(*procesoActual, tiempoEjecucion);
+
+                registrarEvento(procesoActual->pid, inicioEvento, tiempoActual);
+
+                // Si el proceso terminó
+                if (procesoActual->remainingTime == 0) {
+                    terminar(procesoActual);
+                    procesoActual = nullptr;
+                }
+            } else if (!pendientes.empty()) {
+                // CPU idle - avanzar al siguiente arrival
+                tiempoActual = pendientes.front()->arrivalTime;
+            }
+        }
+    }
+
+    // Igual que en SimuladorCalendarizacion: los tramos contiguos del
+    // mismo proceso se fusionan antes de publicarse
+    void registrarEvento(const std::string& pid, Tiempo inicio, Tiempo fin) {
+        if (hayEventoAbierto && eventoAbierto.fin == inicio && eventoAbierto.pid == pid) {
+            eventoAbierto.fin = fin;
+            return;
+        }
+        cerrarEvento();
+        eventoAbierto = EventoGantt(pid, inicio, fin);
+        hayEventoAbierto = true;
+    }
+
+    void cerrarEvento() {
+        if (hayEventoAbierto) {
+            hayEventoAbierto = false;
+            if (receptor) {
+                receptor->alEvento(eventoAbierto);
+            }
+        }
+    }
+
+    bool hayEventoAbierto;
+    EventoGantt eventoAbierto;
+};
+
+#endif
@@ -2,25 +2,168 @@
 #define SIMULADOR_SINCRONIZACION_H
 
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <algorithm>
-#include <queue>
+#include <climits>
+#include <stdexcept>
 #include "estructuras.h"
 #include "simulador_calendarizacion.h"
+#include "perfil_recursos.h"
 
+// Protocolo de acceso a los recursos
+//   ninguno   el primero que reintenta obtiene el recurso
+//   herencia  herencia de prioridad: los recursos liberados van primero
+//             a los procesos de mejor prioridad, y un proceso bloqueado
+//             por otro de peor prioridad le cede sus ciclos de CPU
+//   techo     protocolo de techo de prioridad: además de la herencia, un
+//             proceso solo toma un recurso si su prioridad es mejor que el
+//             techo de todos los recursos ocupados por otros
+enum ProtocoloRecursos {
+    PROTOCOLO_NINGUNO,
+    PROTOCOLO_HERENCIA,
+    PROTOCOLO_TECHO
+};
+
+inline const char* nombreProtocolo(ProtocoloRecursos protocolo) {
+    switch (protocolo) {
+        case PROTOCOLO_NINGUNO:  return "ninguno";
+        case PROTOCOLO_HERENCIA: return "herencia";
+        case PROTOCOLO_TECHO:    return "techo";
+    }
+    return "?";
+}
+
+// Tiempo bloqueado (WAITING) de los procesos de una prioridad
+struct BloqueoPorPrioridad {
+    int prioridad = 0;
+    long long procesos = 0;
+    Tiempo total = 0;
+    Tiempo maximo = 0;   // Mayor bloqueo de un solo proceso
+};
+
+struct ResumenBloqueo {
+    std::vector<BloqueoPorPrioridad> niveles; // De mejor a peor prioridad
+    long long inversiones = 0;  // Bloqueos causados por un proceso de peor prioridad
+    Tiempo ciclosDonados = 0;   // Ciclos cedidos al proceso que bloquea
+};
+
+// Costo y equidad de la contención en la última corrida. Los ciclos de
+// giro y de despertar ocupan la CPU sin avanzar el trabajo (OVERHEAD en el
+// Gantt), así que "trabajo" baja cuando la contención cuesta más.
+struct ResumenContencion {
+    Tiempo trabajo = 0;             // Ciclos de trabajo completados
+    Tiempo trabajoTotal = 0;        // Suma de los burst
+    Tiempo ciclosGiro = 0;
+    Tiempo ciclosDespertar = 0;
+    long long despertares = 0;
+    long long despertaresInutiles = 0; // Despertó y no obtuvo el recurso
+    long long adelantamientos = 0;  // Tomó un recurso con otros esperándolo
+    long long esperas = 0;          // Adquisiciones que tuvieron que esperar
+    Tiempo esperaTotal = 0;         // Desde el bloqueo hasta la adquisición
+    Tiempo esperaMaxima = 0;
+};
+
+// Simula los recursos sobre el calendario de un algoritmo. Cada tramo de
+// CPU del calendario se recorre con el avance propio del proceso (su
+// ciclo); las acciones de acciones.txt ocurren en ese ciclo:
+//   READ / WRITE   toma los recursos durante un ciclo
+//   LOCK           toma los recursos hasta un UNLOCK posterior
+//   UNLOCK         libera los recursos tomados con LOCK
+// El recurso puede ser una lista "r1+r2": se toman todos o ninguno. Lo que
+// un proceso retiene se libera a más tardar cuando termina su trabajo o
+// cuando se agotan sus tramos en el calendario.
+//
+// Cada recurso tiene una política de entrega (ver PoliticaEntrega). Un
+// proceso bloqueado duerme en la cola del recurso; al despertarlo paga
+// costoDespertar ciclos de su propio tramo antes de reintentar. Con fifo y
+// lote nadie adelanta a la cola: las unidades se entregan directamente a
+// los que esperan (con protocolo, primero al de mejor prioridad). Con una
+// lista, la entrega directa puede dejar a un proceso con parte de ella
+// mientras espera el resto.
 class SimuladorSincronizacion : public SimuladorCalendarizacion {
 private:
     std::vector<Recurso> recursos;
     std::vector<Accion> acciones;
-    std::map<std::string, int> estadoProcesos; // Ciclo actual de cada proceso
-    std::map<std::string, std::vector<Accion>> accionesPorProceso;
     
+    // Índice de cada PID en procesos (se recalcula al cargar procesos)
+    std::unordered_map<std::string, int> indiceProceso;
+    
+    enum TipoAccionSync : char {
+        ACCION_OTRA,    // Tipo desconocido: se ignora
+        ACCION_ACCESO,  // READ o WRITE
+        ACCION_TOMAR,   // LOCK
+        ACCION_SOLTAR   // UNLOCK
+    };
+    
+    // Índice de acciones en formato CSR: las acciones del proceso i son
+    // las posiciones [inicioAcciones[i], inicioAcciones[i + 1]), ordenadas
+    // por ciclo (las del mismo ciclo, en el orden del archivo). Los
+    // recursos de la acción k son listaRecursos[inicioRecursos[k] ..
+    // inicioRecursos[k + 1]) como índices en "recursos" (los nombres que no
+    // existen se omiten) y el tipo ya está clasificado. Se rehace al
+    // iniciar una corrida si cambiaron los procesos, los recursos o las
+    // acciones.
+    std::vector<int> inicioAcciones;
+    std::vector<Tiempo> cicloAccion;
+    std::vector<char> tipoAccion;
+    std::vector<int> inicioRecursos;
+    std::vector<int> listaRecursos;
+    bool indiceValido = false;
+    
+    // Techo de cada recurso: la mejor prioridad (el menor número) entre
+    // los procesos que lo usan
+    std::vector<int> techo;
+    
+    // Estado por proceso durante una corrida, respaldado por la arena
+    struct EstadoSincronizacion {
+        Tiempo ciclo;       // Avance del proceso (ciclos ejecutados)
+        Tiempo consumido;   // Tiempo de sus propios tramos ya recorrido
+        int cursor;         // Primera acción con ciclo >= ciclo - 1 (ver simularCiclo)
+        int pendiente;      // Acción que espera recursos, o -1
+        int reanudar;       // Siguiente acción del ciclo tras desbloquearse, o -1
+        int prioridad;      // Prioridad efectiva (con la heredada)
+        int giro;           // Ciclos de giro que le quedan antes de dormirse
+        Tiempo sobrecarga;  // Ciclos de despertar por pagar
+        Tiempo bloqueadoDesde;
+        bool despertado;    // Lo despertaron y aún no reintenta
+        bool terminado;
+    };
+    std::pmr::vector<EstadoSincronizacion> estadoProcesos;
+    
+    // Unidades de recurso retenidas. Hay a lo sumo tantas como la suma de
+    // los contadores, así que se recorren de forma lineal.
+    struct Tenencia {
+        int proceso;
+        int recurso;
+        int accion;     // Acción que la tomó
+        bool candado;   // Tomada con LOCK: dura hasta el UNLOCK
+        Tiempo desde;
+    };
+    std::vector<Tenencia> tenencias;
+    
+    ProtocoloRecursos protocolo = PROTOCOLO_NINGUNO;
+    
+    // Política de entrega de cada recurso (la por defecto ya resuelta)
+    std::vector<PoliticaEntrega> entrega;
+    std::vector<int> parametroEntrega;
+    PoliticaEntrega entregaPorDefecto = ENTREGA_IRRUMPIR;
+    int parametroPorDefecto = 2;
+    Tiempo costoDespertar = 0;
+    
+    // Resultados de la última corrida con sincronización
+    std::vector<Tiempo> tiempoBloqueado;
+    long long inversiones = 0;
+    Tiempo ciclosDonados = 0;
+    ResumenContencion contencion;
+    PerfiladorRecursos perfilador;
+
 public:
-    SimuladorSincronizacion() : SimuladorCalendarizacion() {}
+    SimuladorSincronizacion() : SimuladorCalendarizacion(), estadoProcesos(&arena) {}
     
     // Cargar recursos y acciones
     void cargarRecursos(const std::vector<Recurso>& recs) {
         recursos = recs;
+        indiceValido = false;
         // Resetear contadores
         for (auto& r : recursos) {
             r.contador = r.contadorOriginal;
@@ -30,177 +173,736 @@ public:
     
     void cargarAcciones(const std::vector<Accion>& acts) {
         acciones = acts;
-        accionesPorProceso.clear();
-        
-        // Organizar acciones por proceso
-        for (const auto& a : acciones) {
-            accionesPorProceso[a.pid].push_back(a);
-        }
-        
-        // Ordenar acciones por ciclo para cada proceso
-        for (auto& pair : accionesPorProceso) {
-            std::sort(pair.second.begin(), pair.second.end(),
-                [](const Accion& a, const Accion& b) {
-                    return a.ciclo < b.ciclo;
-                });
+        indiceValido = false;
+    }
+    
+    void setProtocolo(ProtocoloRecursos p) { protocolo = p; }
+    ProtocoloRecursos getProtocolo() const { return protocolo; }
+    
+    // Política de los recursos sin una propia en recursos.txt
+    void setEntregaPorDefecto(PoliticaEntrega politica, int parametro) {
+        entregaPorDefecto = politica == ENTREGA_POR_DEFECTO ? ENTREGA_IRRUMPIR : politica;
+        parametroPorDefecto = parametro;
+    }
+    
+    // Ciclos de CPU que paga un proceso al despertar (cambio de contexto)
+    void setCostoDespertar(Tiempo ciclos) {
+        if (ciclos < 0) {
+            throw std::runtime_error("El costo de despertar no puede ser negativo");
         }
+        costoDespertar = ciclos;
+    }
+    Tiempo getCostoDespertar() const { return costoDespertar; }
+    
+    // Política con la que se simula el recurso r
+    PoliticaEntrega getEntrega(size_t r) const {
+        const Recurso& recurso = recursos[r];
+        return recurso.entrega == ENTREGA_POR_DEFECTO ? entregaPorDefecto : recurso.entrega;
     }
     
     // Override ejecutar para incluir sincronización
     void ejecutar(TipoAlgoritmo tipo) {
-        // Primero ejecutar el algoritmo base
+        // Si hay recursos y acciones, cada tramo del algoritmo base se
+        // simula con sincronización a medida que se produce
+        activarSincronizacion();
         SimuladorCalendarizacion::ejecutar(tipo);
-        
-        // Si hay recursos y acciones, simular sincronización
-        if (!recursos.empty() && !acciones.empty()) {
-            simularSincronizacion();
+    }
+    
+    void ejecutarIncremental(TipoAlgoritmo tipo) {
+        activarSincronizacion();
+        SimuladorCalendarizacion::ejecutarIncremental(tipo);
+    }
+    
+    // Tiempo bloqueado de cada proceso en la última corrida (en el orden
+    // de la carga; vacío si no hubo sincronización)
+    const std::vector<Tiempo>& getTiempoBloqueado() const { return tiempoBloqueado; }
+    
+    ResumenBloqueo getResumenBloqueo() const {
+        ResumenBloqueo r;
+        r.inversiones = inversiones;
+        r.ciclosDonados = ciclosDonados;
+        std::vector<std::pair<int, Tiempo>> filas;
+        for (size_t i = 0; i < tiempoBloqueado.size(); ++i) {
+            filas.push_back({procesos[i].priority, tiempoBloqueado[i]});
+        }
+        std::sort(filas.begin(), filas.end());
+        for (const auto& f : filas) {
+            if (r.niveles.empty() || r.niveles.back().prioridad != f.first) {
+                r.niveles.push_back(BloqueoPorPrioridad());
+                r.niveles.back().prioridad = f.first;
+            }
+            BloqueoPorPrioridad& nivel = r.niveles.back();
+            nivel.procesos++;
+            nivel.total += f.second;
+            nivel.maximo = std::max(nivel.maximo, f.second);
         }
+        return r;
     }
     
+    const ResumenContencion& getResumenContencion() const { return contencion; }
+    
+    // Contención de cada recurso en la última corrida (vacío si no hubo
+    // sincronización)
+    std::vector<PerfilRecurso> getPerfilRecursos() const { return perfilador.resumir(); }
+
+protected:
+    void alCargarProcesos() override {
+        indiceProceso.clear();
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            indiceProceso[procesos[i].pid] = static_cast<int>(i);
+        }
+        indiceValido = false;
+    }
+    
+    void alIniciarCorrida() override {
+        ultimaSincronizada = sincronizar;
+        tiempoBloqueado.clear();
+        inversiones = 0;
+        ciclosDonados = 0;
+        contencion = ResumenContencion();
+        perfilador.reiniciar(sincronizar ? recursos : std::vector<Recurso>());
+        if (sincronizar) {
+            prepararSincronizacion();
+        }
+    }
+    
+    // El estado de recursos y procesos bloqueados no está en los puntos
+    // de control: con sincronización siempre se simula completo
+    bool puedeReanudar() const override {
+        return !sincronizar && !ultimaSincronizada;
+    }
+    
+    // Los tramos de E/S no usan la CPU y pasan sin sincronizar
+    void publicarEvento(const EventoGantt& evento, int proceso) override {
+        if (sincronizar && evento.estado == "RUNNING") {
+            simularSincronizacion(evento, proceso);
+        } else {
+            emitir(evento, proceso);
+        }
+    }
+
 private:
-    void simularSincronizacion() {
-        // Crear nuevo conjunto de eventos con sincronización
-        std::vector<EventoGantt> eventosConSinc;
-        std::map<std::string, bool> procesoBloqueado;
+    bool sincronizar = false;
+    bool ultimaSincronizada = false;
+    
+    // Las acciones se ubican por el ciclo de trabajo del proceso, que se
+    // cuenta sobre los tramos en CPU: con DVFS un tramo ya no equivale a
+    // su trabajo
+    void activarSincronizacion() {
+        sincronizar = !recursos.empty() && !acciones.empty();
+        if (sincronizar && conDVFS()) {
+            throw std::runtime_error("La sincronización no admite DVFS");
+        }
+    }
+    
+    void prepararSincronizacion() {
+        if (!indiceValido) {
+            construirIndiceAcciones();
+        }
         
-        // Inicializar estado
-        for (auto& p : procesos) {
-            estadoProcesos[p.pid] = 0;
-            procesoBloqueado[p.pid] = false;
+        // La arena acaba de rebobinarse: se toma un vector nuevo de ella
+        // (liberar el anterior no hace nada)
+        estadoProcesos = std::pmr::vector<EstadoSincronizacion>(
+            procesos.size(), EstadoSincronizacion{0, 0, 0, -1, -1, 0, 0, 0, 0, false, false}, &arena);
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            estadoProcesos[i].cursor = inicioAcciones[i];
+            estadoProcesos[i].prioridad = procesos[i].priority;
+            contencion.trabajoTotal += procesos[i].burstTime;
         }
+        tiempoBloqueado.assign(procesos.size(), 0);
+        tenencias.clear();
         
         // Resetear recursos
+        entrega.clear();
+        parametroEntrega.clear();
         for (auto& r : recursos) {
             r.contador = r.contadorOriginal;
             r.colaEspera.clear();
+            entrega.push_back(getEntrega(entrega.size()));
+            parametroEntrega.push_back(r.entrega == ENTREGA_POR_DEFECTO ? parametroPorDefecto : r.parametroEntrega);
+        }
+    }
+    
+    static TipoAccionSync clasificar(const std::string& tipo) {
+        if (tipo == "READ" || tipo == "WRITE") return ACCION_ACCESO;
+        if (tipo == "LOCK") return ACCION_TOMAR;
+        if (tipo == "UNLOCK") return ACCION_SOLTAR;
+        return ACCION_OTRA;
+    }
+    
+    void construirIndiceAcciones() {
+        std::unordered_map<std::string, int> indiceRecurso;
+        for (size_t r = 0; r < recursos.size(); ++r) {
+            indiceRecurso.emplace(recursos[r].nombre, static_cast<int>(r));
         }
         
-        // Procesar eventos del Gantt original
-        for (const auto& evento : eventos) {
-            std::string pid = evento.pid;
-            int duracion = evento.fin - evento.inicio;
-            int cicloInicial = estadoProcesos[pid];
+        // Contar por proceso, acumular y repartir (orden estable)
+        std::vector<int> procesoDe(acciones.size(), -1);
+        inicioAcciones.assign(procesos.size() + 1, 0);
+        for (size_t k = 0; k < acciones.size(); ++k) {
+            auto it = indiceProceso.find(acciones[k].pid);
+            if (it != indiceProceso.end()) {
+                procesoDe[k] = it->second;
+                inicioAcciones[it->second + 1]++;
+            }
+        }
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            inicioAcciones[i + 1] += inicioAcciones[i];
+        }
+        
+        std::vector<int> orden(inicioAcciones.back());
+        std::vector<int> cursor(inicioAcciones.begin(), inicioAcciones.end() - 1);
+        for (size_t k = 0; k < acciones.size(); ++k) {
+            if (procesoDe[k] >= 0) {
+                orden[cursor[procesoDe[k]]++] = static_cast<int>(k);
+            }
+        }
+        for (size_t i = 0; i < procesos.size(); ++i) {
+            std::stable_sort(orden.begin() + inicioAcciones[i], orden.begin() + inicioAcciones[i + 1],
+                [this](int a, int b) { return acciones[a].ciclo < acciones[b].ciclo; });
+        }
+        
+        cicloAccion.resize(orden.size());
+        tipoAccion.resize(orden.size());
+        inicioRecursos.assign(1, 0);
+        listaRecursos.clear();
+        techo.assign(recursos.size(), INT_MAX);
+        for (size_t k = 0; k < orden.size(); ++k) {
+            const Accion& a = acciones[orden[k]];
+            cicloAccion[k] = a.ciclo;
+            tipoAccion[k] = clasificar(a.tipo);
             
-            // Para cada ciclo del evento
-            for (int ciclo = 0; ciclo < duracion; ciclo++) {
-                int cicloActual = cicloInicial + ciclo;
-                bool bloqueado = false;
-                
-                // Verificar si hay acciones en este ciclo
-                if (accionesPorProceso.find(pid) != accionesPorProceso.end()) {
-                    for (const auto& accion : accionesPorProceso[pid]) {
-                        if (accion.ciclo == cicloActual) {
-                            // Intentar ejecutar la acción
-                            if (accion.tipo == "READ" || accion.tipo == "WRITE") {
-                                Recurso* recurso = encontrarRecurso(accion.recurso);
-                                if (recurso) {
-                                    if (recurso->contador > 0) {
-                                        // Adquirir recurso
-                                        recurso->contador--;
-                                        
-                                        // Agregar evento de acceso
-                                        eventosConSinc.push_back(
-                                            EventoGantt(pid, evento.inicio + ciclo, 
-                                                      evento.inicio + ciclo + 1, "ACCESSED")
-                                        );
-                                    } else {
-                                        // Bloquear proceso
-                                        bloqueado = true;
-                                        procesoBloqueado[pid] = true;
-                                        recurso->colaEspera.push_back(pid);
-                                        
-                                        // Agregar evento de espera
-                                        eventosConSinc.push_back(
-                                            EventoGantt(pid, evento.inicio + ciclo, 
-                                                      evento.inicio + ciclo + 1, "WAITING")
-                                        );
-                                        break;
-                                    }
-                                }
-                            }
-                        }
-                    }
+            // "r1+r2": varios recursos en una misma acción
+            size_t desde = 0;
+            while (desde <= a.recurso.size()) {
+                size_t hasta = a.recurso.find('+', desde);
+                if (hasta == std::string::npos) hasta = a.recurso.size();
+                std::string nombre = a.recurso.substr(desde, hasta - desde);
+                nombre.erase(0, nombre.find_first_not_of(' '));
+                nombre.erase(nombre.find_last_not_of(' ') + 1);
+                auto r = indiceRecurso.find(nombre);
+                if (r != indiceRecurso.end()) {
+                    listaRecursos.push_back(r->second);
+                    techo[r->second] = std::min(techo[r->second], procesos[procesoDe[orden[k]]].priority);
                 }
-                
-                // Si no está bloqueado, ejecutar normalmente
-                if (!bloqueado && !procesoBloqueado[pid]) {
-                    eventosConSinc.push_back(
-                        EventoGantt(pid, evento.inicio + ciclo, 
-                                  evento.inicio + ciclo + 1, "RUNNING")
-                    );
-                    estadoProcesos[pid]++;
-                } else if (procesoBloqueado[pid]) {
-                    // Verificar si se puede desbloquear
-                    if (intentarDesbloquear(pid)) {
-                        procesoBloqueado[pid] = false;
-                        eventosConSinc.push_back(
-                            EventoGantt(pid, evento.inicio + ciclo, 
-                                      evento.inicio + ciclo + 1, "RUNNING")
-                        );
-                        estadoProcesos[pid]++;
+                desde = hasta + 1;
+            }
+            inicioRecursos.push_back(static_cast<int>(listaRecursos.size()));
+        }
+        indiceValido = true;
+    }
+    
+    // Avanzar un cursor hasta la primera acción con ciclo >= ciclo - 1
+    int avanzarCursor(int& cursor, int fin, Tiempo ciclo) const {
+        while (cursor < fin && cicloAccion[cursor] < ciclo - 1) {
+            cursor++;
+        }
+        return cursor;
+    }
+    
+    // Procesar un tramo del Gantt original. Solo se simulan ciclo a ciclo
+    // los ciclos con acciones del proceso (o que liberan la acción del
+    // ciclo anterior); entre ellos los recursos no cambian, así que el
+    // resto del tramo se emite de una vez sin recorrer cada ciclo.
+    void simularSincronizacion(const EventoGantt& evento, int i) {
+        INSTR_FASE(estadisticas, FASE_SINCRONIZACION);
+        Tiempo tiempo = evento.inicio;
+        while (tiempo < evento.fin) {
+            tiempo += pasoPropio(i, tiempo, evento.fin - tiempo);
+        }
+        
+        // Con sus tramos agotados el proceso ya no vuelve a la CPU
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        estado.consumido += evento.fin - evento.inicio;
+        if (estado.consumido >= procesos[i].burstTime) {
+            finalizarProceso(i, evento.fin);
+        }
+    }
+    
+    // Un paso del proceso i en su propio tramo, desde "tiempo" y con
+    // "disponible" instantes por delante. Devuelve los instantes usados.
+    Tiempo pasoPropio(int i, Tiempo tiempo, Tiempo disponible) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        
+        // Terminó su trabajo con ciclos cedidos: el resto del tramo queda libre
+        if (estado.terminado) return disponible;
+        
+        // Al despertar, el cambio de contexto va antes del reintento
+        if (estado.sobrecarga > 0) {
+            Tiempo largo = std::min(disponible, estado.sobrecarga);
+            emitir(EventoGantt(procesos[i].pid, tiempo, tiempo + largo, "OVERHEAD"), i);
+            estado.sobrecarga -= largo;
+            contencion.ciclosDespertar += largo;
+            return largo;
+        }
+        
+        if (estado.pendiente >= 0 && !reintentar(i, tiempo)) {
+            if (estado.despertado) {
+                contencion.despertaresInutiles++;
+                estado.despertado = false;
+            }
+            if (estado.giro > 0) {
+                girar(i, tiempo);
+                return 1;
+            }
+            
+            // Dentro del propio tramo nadie más usa la CPU, así que los
+            // recursos no cambian salvo que se cedan los ciclos
+            int receptorCiclos = donatario(i);
+            if (receptorCiclos < 0) {
+                esperar(i, tiempo, disponible);
+                return disponible;
+            }
+            Tiempo usado = avanzar(receptorCiclos, tiempo, disponible);
+            ciclosDonados += usado;
+            esperar(i, tiempo, usado);
+            return usado;
+        }
+        return avanzar(i, tiempo, disponible);
+    }
+    
+    // Ejecutar el proceso i (no bloqueado) hasta su próximo ciclo con
+    // acciones o un solo ciclo con acciones. Devuelve los instantes usados.
+    Tiempo avanzar(int i, Tiempo tiempo, Tiempo disponible) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        if (estado.reanudar < 0) {
+            Tiempo proximo = proximoCicloConAcciones(estado.cursor, inicioAcciones[i + 1], estado.ciclo);
+            if (proximo > estado.ciclo) {
+                Tiempo largo = std::min({disponible, proximo - estado.ciclo,
+                                         procesos[i].burstTime - estado.ciclo});
+                emitir(EventoGantt(procesos[i].pid, tiempo, tiempo + largo, "RUNNING"), i);
+                estado.ciclo += largo;
+                contencion.trabajo += largo;
+                if (estado.ciclo >= procesos[i].burstTime) {
+                    finalizarProceso(i, tiempo + largo);
+                }
+                return largo;
+            }
+        }
+        simularCiclo(i, tiempo);
+        return 1;
+    }
+    
+    // Primer ciclo >= ciclo en el que el proceso tiene una acción o
+    // libera la del ciclo anterior
+    Tiempo proximoCicloConAcciones(int& cursor, int fin, Tiempo ciclo) const {
+        int k = avanzarCursor(cursor, fin, ciclo);
+        if (k == fin) return TIEMPO_MAXIMO;
+        return std::max(ciclo, cicloAccion[k]);
+    }
+    
+    // Un ciclo con acciones. Tras desbloquearse, el ciclo continúa con las
+    // acciones que siguen a la que esperaba.
+    void simularCiclo(int i, Tiempo tiempo) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        const std::string& pid = procesos[i].pid;
+        Tiempo cicloActual = estado.ciclo;
+        int fin = inicioAcciones[i + 1];
+        int primera = avanzarCursor(estado.cursor, fin, cicloActual);
+        int k = estado.reanudar >= 0 ? estado.reanudar : primera;
+        estado.reanudar = -1;
+        
+        for (; k < fin && cicloAccion[k] <= cicloActual; ++k) {
+            if (cicloAccion[k] != cicloActual || inicioRecursos[k] == inicioRecursos[k + 1]) continue;
+            if (tipoAccion[k] == ACCION_ACCESO || tipoAccion[k] == ACCION_TOMAR) {
+                if (!adquirir(i, k, tiempo)) {
+                    bloquear(i, k, tiempo);
+                    if (estado.giro > 0) {
+                        girar(i, tiempo);
                     } else {
-                        eventosConSinc.push_back(
-                            EventoGantt(pid, evento.inicio + ciclo, 
-                                      evento.inicio + ciclo + 1, "WAITING")
-                        );
+                        esperar(i, tiempo, 1);
                     }
+                    liberarAccesos(i, primera, fin, cicloActual, tiempo);
+                    return;
+                }
+                emitir(EventoGantt(pid, tiempo, tiempo + 1, "ACCESSED"), i);
+            } else if (tipoAccion[k] == ACCION_SOLTAR) {
+                for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+                    soltar(i, listaRecursos[x], -1, tiempo);
                 }
-                
-                // Liberar recursos al final del ciclo si es necesario
-                liberarRecursosCompletados(pid, cicloActual);
             }
         }
         
-        // Actualizar eventos con la sincronización
-        eventos = eventosConSinc;
+        emitir(EventoGantt(pid, tiempo, tiempo + 1, "RUNNING"), i);
+        estado.ciclo++;
+        contencion.trabajo++;
+        
+        // Los accesos del ciclo anterior se liberan al final de este
+        liberarAccesos(i, primera, fin, cicloActual, tiempo);
+        if (estado.ciclo >= procesos[i].burstTime) {
+            finalizarProceso(i, tiempo + 1);
+        }
     }
     
-    Recurso* encontrarRecurso(const std::string& nombre) {
-        for (auto& r : recursos) {
-            if (r.nombre == nombre) {
-                return &r;
-            }
+    void esperar(int i, Tiempo tiempo, Tiempo largo) {
+        emitir(EventoGantt(procesos[i].pid, tiempo, tiempo + largo, "WAITING"), i);
+        tiempoBloqueado[i] += largo;
+    }
+    
+    // Un ciclo reintentando en CPU en lugar de dormirse
+    void girar(int i, Tiempo tiempo) {
+        emitir(EventoGantt(procesos[i].pid, tiempo, tiempo + 1, "OVERHEAD"), i);
+        estadoProcesos[i].giro--;
+        contencion.ciclosGiro++;
+    }
+    
+    void notificarRecurso(const Recurso& recurso, const std::string& pid, Tiempo tiempo, bool adquirido) {
+        if (receptor) {
+            receptor->alRecurso(recurso.nombre, pid, tiempo, recurso.contador, adquirido);
+        }
+    }
+    
+    // Recurso por su índice
+    Recurso& recursoDe(int indice) {
+        INSTR_CONTAR(estadisticas, busquedasRecurso);
+        return recursos[indice];
+    }
+    
+    Tenencia* tenenciaDe(int i, int r) {
+        for (auto& t : tenencias) {
+            if (t.proceso == i && t.recurso == r) return &t;
         }
         return nullptr;
     }
     
-    bool intentarDesbloquear(const std::string& pid) {
-        // Verificar si el proceso puede adquirir algún recurso esperado
-        for (auto& r : recursos) {
-            auto it = std::find(r.colaEspera.begin(), r.colaEspera.end(), pid);
-            if (it != r.colaEspera.end() && r.contador > 0) {
-                // Puede adquirir el recurso
-                r.contador--;
-                r.colaEspera.erase(it);
-                return true;
-            }
+    // Primer proceso distinto de i que retiene r, o -1
+    int poseedorDe(int r, int i) const {
+        for (const auto& t : tenencias) {
+            if (t.recurso == r && t.proceso != i) return t.proceso;
+        }
+        return -1;
+    }
+    
+    // Con protocolo, un recurso libre no se entrega si espera un proceso
+    // de mejor prioridad efectiva
+    bool esperaOtroMejor(int i, int r) {
+        if (protocolo == PROTOCOLO_NINGUNO) return false;
+        for (const auto& pid : recursos[r].colaEspera) {
+            int j = indiceProceso[pid];
+            if (j != i && estadoProcesos[j].prioridad < estadoProcesos[i].prioridad) return true;
         }
         return false;
     }
     
-    void liberarRecursosCompletados(const std::string& pid, int ciclo) {
-        // Aquí se podría implementar la lógica para liberar recursos
-        // después de cierto tiempo o cuando se complete una operación
-        // Por simplicidad, asumimos que los recursos se liberan después de 1 ciclo
-        
-        // Buscar acciones completadas
-        if (accionesPorProceso.find(pid) != accionesPorProceso.end()) {
-            for (const auto& accion : accionesPorProceso[pid]) {
-                if (accion.ciclo == ciclo - 1) {
-                    Recurso* recurso = encontrarRecurso(accion.recurso);
-                    if (recurso && recurso->contador < recurso->contadorOriginal) {
-                        recurso->contador++;
-                        
-                        // Despertar proceso en espera si hay alguno
-                        if (!recurso->colaEspera.empty()) {
-                            // El siguiente proceso en la cola será desbloqueado
-                            // en la próxima iteración
-                        }
-                    }
+    // Recurso ocupado por otros con el techo más bajo (la mejor
+    // prioridad), o -1. Un recurso cuenta cuando no le quedan unidades.
+    int recursoTecho(int i) const {
+        int elegido = -1;
+        for (const auto& t : tenencias) {
+            if (t.proceso == i || recursos[t.recurso].contador > 0) continue;
+            if (elegido < 0 || techo[t.recurso] < techo[elegido]) elegido = t.recurso;
+        }
+        return elegido;
+    }
+    
+    // Con fifo y lote las unidades libres no se toman mientras haya cola:
+    // se entregan a los que esperan
+    bool libre(int r) {
+        const Recurso& recurso = recursoDe(r);
+        if (recurso.contador <= 0) return false;
+        return recurso.colaEspera.empty() || (entrega[r] != ENTREGA_FIFO && entrega[r] != ENTREGA_LOTE);
+    }
+    
+    // Si r le impide a i completar su acción
+    bool bloqueaRecurso(int i, int r) {
+        return !tenenciaDe(i, r) && (!libre(r) || esperaOtroMejor(i, r));
+    }
+    
+    bool cumpleTecho(int i) const {
+        if (protocolo != PROTOCOLO_TECHO) return true;
+        int r = recursoTecho(i);
+        return r < 0 || estadoProcesos[i].prioridad < techo[r];
+    }
+    
+    bool puedeAdquirir(int i, int k) {
+        for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+            if (bloqueaRecurso(i, listaRecursos[x])) return false;
+        }
+        return cumpleTecho(i);
+    }
+    
+    // Tomar todos los recursos de la acción k o ninguno. Los que el
+    // proceso ya retiene no se vuelven a tomar.
+    bool adquirir(int i, int k, Tiempo tiempo) {
+        if (!puedeAdquirir(i, k)) return false;
+        for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+            int r = listaRecursos[x];
+            Recurso& recurso = recursos[r];
+            Tenencia* t = tenenciaDe(i, r);
+            if (!t && adelanta(i, r)) contencion.adelantamientos++;
+            bool disputada = dejarDeEsperar(i, r);
+            
+            if (t) {
+                // Un LOCK sobre un acceso en curso lo extiende hasta el UNLOCK
+                if (tipoAccion[k] == ACCION_TOMAR) {
+                    t->candado = true;
+                    t->accion = k;
                 }
+                continue;
+            }
+            recurso.contador--;
+            tenencias.push_back({i, r, k, tipoAccion[k] == ACCION_TOMAR, tiempo});
+            notificarRecurso(recurso, procesos[i].pid, tiempo, true);
+            perfilador.adquirido(r, tiempo, recurso.contadorOriginal - recurso.contador, disputada,
+                                 tiempo - estadoProcesos[i].bloqueadoDesde);
+        }
+        return true;
+    }
+    
+    // Proceso que impide la acción pendiente de i: el que retiene un
+    // recurso que falta o, con techo, el que retiene el recurso del techo
+    int bloqueador(int i) {
+        int k = estadoProcesos[i].pendiente;
+        if (k < 0) return -1;
+        for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+            int r = listaRecursos[x];
+            if (!tenenciaDe(i, r) && recursos[r].contador <= 0) return poseedorDe(r, i);
+        }
+        if (protocolo == PROTOCOLO_TECHO) {
+            int r = recursoTecho(i);
+            if (r >= 0) return poseedorDe(r, i);
+        }
+        return -1;
+    }
+    
+    // Si i toma r antes que alguien que lo esperaba desde antes
+    bool adelanta(int i, int r) const {
+        const std::vector<std::string>& cola = recursos[r].colaEspera;
+        return !cola.empty() && cola.front() != procesos[i].pid;
+    }
+    
+    // Encolar a i en los recursos que le faltan. Con girar no se duerme
+    // enseguida: reintenta durante los ciclos de giro del primero de ellos.
+    void bloquear(int i, int k, Tiempo tiempo) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        estado.pendiente = k;
+        estado.bloqueadoDesde = tiempo;
+        estado.giro = 0;
+        bool primero = true;
+        for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+            int r = listaRecursos[x];
+            if (!bloqueaRecurso(i, r)) continue;
+            if (primero && entrega[r] == ENTREGA_GIRAR) {
+                estado.giro = parametroEntrega[r];
+            }
+            primero = false;
+            Recurso& recurso = recursos[r];
+            if (std::find(recurso.colaEspera.begin(), recurso.colaEspera.end(), procesos[i].pid) ==
+                recurso.colaEspera.end()) {
+                recurso.colaEspera.push_back(procesos[i].pid);
+                perfilador.encolado(r, recurso.colaEspera.size());
             }
+            repartir(r, tiempo);
         }
+        int h = bloqueador(i);
+        if (h >= 0 && procesos[h].priority > procesos[i].priority) {
+            inversiones++;
+        }
+        actualizarPrioridad(h);
+    }
+    
+    bool reintentar(int i, Tiempo tiempo) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        int k = estado.pendiente;
+        if (!adquirir(i, k, tiempo)) return false;
+        emitir(EventoGantt(procesos[i].pid, tiempo, tiempo + 1, "ACCESSED"), i);
+        estado.pendiente = -1;
+        estado.reanudar = k + 1;
+        estado.giro = 0;
+        estado.despertado = false;
+        
+        Tiempo espera = tiempo - estado.bloqueadoDesde;
+        contencion.esperas++;
+        contencion.esperaTotal += espera;
+        contencion.esperaMaxima = std::max(contencion.esperaMaxima, espera);
+        return true;
+    }
+    
+    // Proceso que ejecuta en lugar de i mientras i espera: el final de la
+    // cadena de bloqueos, si tiene peor prioridad que la efectiva de i.
+    // -1 sin protocolo, si la cadena se cierra (interbloqueo) o si no hay
+    // inversión.
+    int donatario(int i) {
+        if (protocolo == PROTOCOLO_NINGUNO) return -1;
+        if (estadoProcesos[i].giro > 0) return -1;
+        int h = bloqueador(i);
+        for (size_t pasos = 0; h >= 0 && estadoProcesos[h].pendiente >= 0; ++pasos) {
+            if (pasos == procesos.size()) return -1;
+            h = bloqueador(h);
+        }
+        if (h < 0 || estadoProcesos[h].terminado) return -1;
+        return procesos[h].priority > estadoProcesos[i].prioridad ? h : -1;
+    }
+    
+    // Recalcular la prioridad efectiva de h (la propia o la mejor de los
+    // que esperan recursos que retiene) y propagarla por la cadena de
+    // bloqueos
+    void actualizarPrioridad(int h) {
+        if (protocolo == PROTOCOLO_NINGUNO) return;
+        for (size_t pasos = 0; h >= 0 && pasos <= procesos.size(); ++pasos) {
+            int nueva = procesos[h].priority;
+            for (const auto& t : tenencias) {
+                if (t.proceso != h) continue;
+                for (const auto& pid : recursos[t.recurso].colaEspera) {
+                    nueva = std::min(nueva, estadoProcesos[indiceProceso[pid]].prioridad);
+                }
+            }
+            if (nueva == estadoProcesos[h].prioridad) return;
+            estadoProcesos[h].prioridad = nueva;
+            h = bloqueador(h);
+        }
+    }
+    
+    // Liberar r retenido por i (solo la unidad tomada por "accion" si no
+    // es -1)
+    void soltar(int i, int r, int accion, Tiempo tiempo) {
+        for (size_t x = 0; x < tenencias.size(); ++x) {
+            const Tenencia& t = tenencias[x];
+            if (t.proceso != i || t.recurso != r || (accion >= 0 && t.accion != accion)) continue;
+            Tiempo desde = t.desde;
+            tenencias.erase(tenencias.begin() + static_cast<std::ptrdiff_t>(x));
+            Recurso& recurso = recursoDe(r);
+            recurso.contador++;
+            notificarRecurso(recurso, procesos[i].pid, tiempo, false);
+            perfilador.liberado(r, tiempo, recurso.contadorOriginal - recurso.contador, tiempo - desde);
+            actualizarPrioridad(i);
+            entregarLiberado(r, tiempo);
+            return;
+        }
+    }
+    
+    // Una unidad de r quedó libre: despertar o entregar según la política
+    void entregarLiberado(int r, Tiempo tiempo) {
+        if (entrega[r] == ENTREGA_FIFO || entrega[r] == ENTREGA_LOTE) {
+            repartir(r, tiempo);
+        } else {
+            for (const auto& pid : recursos[r].colaEspera) {
+                despertar(indiceProceso[pid], costoDespertar);
+            }
+        }
+        
+        // Con techo, liberar cualquier recurso puede habilitar una entrega
+        // que el techo impedía
+        if (protocolo == PROTOCOLO_TECHO) {
+            for (size_t otro = 0; otro < recursos.size(); ++otro) {
+                if (static_cast<int>(otro) != r) repartir(static_cast<int>(otro), tiempo);
+            }
+        }
+    }
+    
+    // Los que giran ya están en CPU: no hay que despertarlos
+    void despertar(int j, Tiempo costo) {
+        EstadoSincronizacion& estado = estadoProcesos[j];
+        if (estado.giro > 0 || estado.despertado) return;
+        estado.despertado = true;
+        estado.sobrecarga = std::max(estado.sobrecarga, costo);
+        contencion.despertares++;
+    }
+    
+    // Entregar las unidades libres de r (fifo o lote) a los que esperan.
+    // Con lote se entregan solo cuando alcanzan para un lote completo (o
+    // para toda la cola) o cuando nadie más retiene el recurso, y los del
+    // lote se reparten el costo de un despertar.
+    void repartir(int r, Tiempo tiempo) {
+        if (entrega[r] != ENTREGA_FIFO && entrega[r] != ENTREGA_LOTE) return;
+        Recurso& recurso = recursos[r];
+        std::vector<std::string>& cola = recurso.colaEspera;
+        if (cola.empty() || recurso.contador <= 0) return;
+        
+        Tiempo costo = costoDespertar;
+        if (entrega[r] == ENTREGA_LOTE) {
+            int lote = std::min(parametroEntrega[r], static_cast<int>(cola.size()));
+            if (recurso.contador < lote && recurso.contador < recurso.contadorOriginal) return;
+            int despertados = std::min(recurso.contador, static_cast<int>(cola.size()));
+            costo = (costoDespertar + despertados - 1) / despertados;
+        }
+        
+        while (recurso.contador > 0) {
+            int j = siguienteEnCola(r);
+            if (j < 0) break;
+            cola.erase(std::find(cola.begin(), cola.end(), procesos[j].pid));
+            int k = estadoProcesos[j].pendiente;
+            recurso.contador--;
+            tenencias.push_back({j, r, k, tipoAccion[k] == ACCION_TOMAR, tiempo});
+            notificarRecurso(recurso, procesos[j].pid, tiempo, true);
+            perfilador.adquirido(r, tiempo, recurso.contadorOriginal - recurso.contador, true,
+                                 tiempo - estadoProcesos[j].bloqueadoDesde);
+            despertar(j, costo);
+        }
+        for (size_t x = 0; x < tenencias.size(); ++x) {
+            if (tenencias[x].recurso == r) actualizarPrioridad(tenencias[x].proceso);
+        }
+    }
+    
+    // A quién se entrega r: el primero de la cola o, con protocolo, el de
+    // mejor prioridad efectiva. Con techo se salta a los que el techo aún
+    // bloquea. -1 si no hay a quién.
+    int siguienteEnCola(int r) {
+        int elegido = -1;
+        for (const auto& pid : recursos[r].colaEspera) {
+            int j = indiceProceso[pid];
+            if (!cumpleTecho(j)) continue;
+            if (elegido < 0) {
+                elegido = j;
+                if (protocolo == PROTOCOLO_NINGUNO) break;
+            } else if (estadoProcesos[j].prioridad < estadoProcesos[elegido].prioridad) {
+                elegido = j;
+            }
+        }
+        return elegido;
+    }
+    
+    // Liberar los accesos (READ/WRITE) del ciclo anterior. "primera" es el
+    // cursor del proceso para este ciclo: las acciones del ciclo anterior
+    // empiezan ahí.
+    void liberarAccesos(int i, int primera, int fin, Tiempo ciclo, Tiempo tiempo) {
+        for (int k = primera; k < fin && cicloAccion[k] == ciclo - 1; ++k) {
+            if (tipoAccion[k] != ACCION_ACCESO) continue;
+            for (int x = inicioRecursos[k]; x < inicioRecursos[k + 1]; ++x) {
+                Tenencia* t = tenenciaDe(i, listaRecursos[x]);
+                if (t && t->accion == k && !t->candado) {
+                    soltar(i, listaRecursos[x], k, tiempo);
+                }
+            }
+        }
+    }
+    
+    // El proceso completó su trabajo o ya no tiene tramos: deja de esperar
+    // y libera todo lo que retiene
+    void finalizarProceso(int i, Tiempo tiempo) {
+        EstadoSincronizacion& estado = estadoProcesos[i];
+        if (estado.terminado) return;
+        estado.terminado = true;
+        estado.pendiente = -1;
+        estado.reanudar = -1;
+        for (size_t r = 0; r < recursos.size(); ++r) {
+            dejarDeEsperar(i, static_cast<int>(r));
+            repartir(static_cast<int>(r), tiempo);
+        }
+        while (Tenencia* t = primeraTenencia(i)) {
+            soltar(i, t->recurso, -1, tiempo);
+        }
+    }
+    
+    // Sacar a i de la cola de r; los que retienen r dejan de heredar su
+    // prioridad. Devuelve si estaba en la cola.
+    bool dejarDeEsperar(int i, int r) {
+        std::vector<std::string>& cola = recursos[r].colaEspera;
+        auto it = std::find(cola.begin(), cola.end(), procesos[i].pid);
+        if (it == cola.end()) return false;
+        cola.erase(it);
+        for (size_t x = 0; x < tenencias.size(); ++x) {
+            if (tenencias[x].recurso == r) actualizarPrioridad(tenencias[x].proceso);
+        }
+        return true;
+    }
+    
+    Tenencia* primeraTenencia(int i) {
+        for (auto& t : tenencias) {
+            if (t.proceso == i) return &t;
+        }
+        return nullptr;
     }
 };
 
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,865 @@
+// cli.cpp
+// Simulador sin interfaz gráfica: ejecuta los algoritmos seleccionados sobre
+// los archivos de data/ e imprime las métricas. Permite exportar el
+// resultado como trace de Chrome/Perfetto sin mantenerlo en memoria,
+// dibujar el diagrama de Gantt como SVG o teselas PNG, y calendarizar en
+// línea procesos que llegan por stdin o una tubería.
+// Con --servir publica todo por un socket Unix para la interfaz gráfica.
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include "parser.h"
+#include "simulador_calendarizacion.h"
+#include "simulador_sincronizacion.h"
+#include "exportador_trace.h"
+#include "exportador_imagen.h"
+#include "experimentos.h"
+#include "simulador_en_linea.h"
+#include "lector_llegadas.h"
+#include "servidor_eventos.h"
+
+// ------------------------------------------------------------
+// Opciones de línea de comandos
+// ------------------------------------------------------------
+
+struct Opciones {
+    std::string procesosFile = "procesos.txt";
+    std::string dispositivosFile;
+    std::string gruposFile;
+    Tiempo rebanadaGrupos = 0;  // 0: el quantum
+    std::string dvfsFile;       // Vacío: modelo por defecto (si hay gobernador)
+    bool conDVFS = false;
+    TipoGobernador gobernador = GOBERNADOR_BAJO_DEMANDA;
+    bool compararGobernadores = false;
+    std::string recursosFile;
+    std::string accionesFile;
+    std::vector<TipoAlgoritmo> algoritmos = {FIFO};
+    Tiempo quantum = 2;
+    std::string traceFile;
+    std::string socketFile;
+    std::string svgFile;
+    std::string pngPrefijo;
+    std::string almacenDir;     // Vacío: los tramos se retienen en memoria
+    OpcionesImagen imagen;
+    bool mostrarGantt = false;
+    bool mostrarEstadisticas = false;
+
+    // Sincronización
+    ProtocoloRecursos protocolo = PROTOCOLO_NINGUNO;
+    bool compararProtocolos = false;
+    PoliticaEntrega entrega = ENTREGA_IRRUMPIR;
+    int parametroEntrega = 2;
+    Tiempo costoDespertar = 0;
+    bool compararEntregas = false;
+    bool perfilRecursos = false;
+
+    // Modo experimento (Monte Carlo)
+    bool experimento = false;
+    ConfiguracionExperimento configExperimento;
+
+    // Modo en línea
+    std::string entradaEnLinea; // Ruta o "-" para stdin; vacío = desactivado
+    long long reporteCada = 1000;
+};
+
+void mostrarAyuda() {
+    std::cout <<
+        "Uso: simulador_cli [opciones]\n"
+        "  --procesos <archivo>     Archivo de procesos (por defecto procesos.txt)\n"
+        "  --dispositivos <archivo> Dispositivos de E/S de las ráfagas (por defecto,\n"
+        "                           uno implícito por nombre, con un servidor)\n"
+        "  --grupos <archivo>       Grupos del reparto justo: peso, algoritmo y\n"
+        "                           respuesta objetivo (por defecto, uno implícito\n"
+        "                           de peso 1 por nombre en la carga)\n"
+        "  --rebanada-grupos <n>    Ciclos antes de pasar la CPU a otro grupo\n"
+        "                           (por defecto, el quantum)\n"
+        "  --dvfs <archivo>         Modelo DVFS: niveles de frecuencia con su potencia\n"
+        "                           y costo de cambio (activa el escalado de frecuencia)\n"
+        "  --gobernador <nombre>    Gobernador DVFS: performance, powersave u ondemand\n"
+        "                           (por defecto ondemand; sin --dvfs usa el modelo de\n"
+        "                           cuatro niveles incorporado)\n"
+        "  --comparar-gobernadores  Comparar espera, respuesta y energía de los tres\n"
+        "                           gobernadores en cada algoritmo\n"
+        "  --recursos <archivo>     Archivo de recursos (activa sincronización)\n"
+        "  --acciones <archivo>     Archivo de acciones (activa sincronización)\n"
+        "  --protocolo <nombre>     Protocolo de recursos: ninguno, herencia o techo\n"
+        "                           (por defecto ninguno)\n"
+        "  --comparar-protocolos    Comparar el bloqueo por prioridad de los tres\n"
+        "                           protocolos en cada algoritmo\n"
+        "  --entrega <política>     Entrega de los recursos sin una propia en\n"
+        "                           recursos.txt: irrumpir, fifo, girar[:N] o lote[:N]\n"
+        "                           (por defecto irrumpir)\n"
+        "  --costo-despertar <n>    Ciclos de CPU que paga un proceso al despertar\n"
+        "                           (por defecto 0)\n"
+        "  --comparar-entregas      Comparar trabajo, costo y espera de las cuatro\n"
+        "                           políticas de entrega en cada algoritmo\n"
+        "  --perfil-recursos        Agregar a la tabla de recursos los histogramas de\n"
+        "                           retención y espera y el uso en el tiempo\n"
+        "  --algoritmos <lista>     FIFO,SJF,SRTF,RR,PRIO (por defecto FIFO)\n"
+        "  --quantum <n>            Quantum para Round Robin (por defecto 2)\n"
+        "  --trace <archivo.json>   Exportar trace de Chrome/Perfetto\n"
+        "  --servir <ruta.sock>     Esperar a la interfaz gráfica en un socket Unix\n"
+        "                           y publicarle la simulación en vivo\n"
+        "  --gantt                  Imprimir los tramos del diagrama de Gantt\n"
+        "  --svg <archivo.svg>      Dibujar el diagrama de Gantt como SVG\n"
+        "  --png <prefijo>          Dibujar el diagrama de Gantt como teselas PNG\n"
+        "                           <prefijo>-<banda>-<columna>.png\n"
+        "  --escala <px>            Pixeles por ciclo de la imagen (por defecto 1)\n"
+        "  --tesela <px>            Lado máximo de cada tesela PNG (por defecto 2048)\n"
+        "  --almacen <directorio>   Retener los tramos en un archivo temporal mapeado\n"
+        "                           en memoria dentro de <directorio> en lugar de la\n"
+        "                           RAM; --gantt, --svg y --png los leen de ahí\n"
+        "  --stats                  Imprimir contadores y tiempos por fase\n"
+        "Los archivos se buscan dentro de data/.\n"
+        "\n"
+        "Modo experimento (cargas aleatorias, sin archivos):\n"
+        "  --experimento            Ejecutar réplicas de Monte Carlo\n"
+        "  --replicas <n>           Número de réplicas (por defecto 1000)\n"
+        "  --tamano <n>             Procesos por réplica (por defecto 50)\n"
+        "  --semilla <s>            Semilla (por defecto 1)\n"
+        "  --hilos <n>              Hilos (por defecto, todos los núcleos)\n"
+        "  --confianza <c>          Nivel del intervalo, entre 0 y 1 (por defecto 0.95)\n"
+        "  --llegadas, --rafagas, --prioridades: como en el generador\n"
+        "\n"
+        "Modo en línea (los procesos llegan mientras se simula):\n"
+        "  --en-linea <ruta|->      Leer procesos de una ruta (archivo, FIFO, /dev/fd/N)\n"
+        "                           o de stdin con \"-\", en orden de llegada\n"
+        "  --cada <n>               Imprimir métricas cada n procesos terminados\n"
+        "                           (por defecto 1000; 0 = solo al final)\n";
+}
+
+ProtocoloRecursos parsearProtocolo(const std::string& nombre) {
+    if (nombre == "ninguno") return PROTOCOLO_NINGUNO;
+    if (nombre == "herencia") return PROTOCOLO_HERENCIA;
+    if (nombre == "techo") return PROTOCOLO_TECHO;
+    throw std::runtime_error("Protocolo desconocido: " + nombre);
+}
+
+TipoGobernador parsearGobernador(const std::string& nombre) {
+    if (nombre == "performance") return GOBERNADOR_RENDIMIENTO;
+    if (nombre == "powersave") return GOBERNADOR_AHORRO;
+    if (nombre == "ondemand") return GOBERNADOR_BAJO_DEMANDA;
+    throw std::runtime_error("Gobernador desconocido: " + nombre);
+}
+
+TipoAlgoritmo parsearAlgoritmo(const std::string& nombre) {
+    if (nombre == "FIFO") return FIFO;
+    if (nombre == "SJF") return SJF;
+    if (nombre == "SRTF") return SRTF;
+    if (nombre == "RR") return ROUND_ROBIN;
+    if (nombre == "PRIO" || nombre == "PRIORITY") return PRIORITY;
+    throw std::runtime_error("Algoritmo desconocido: " + nombre);
+}
+
+Opciones parsearOpciones(int argc, char* argv[]) {
+    Opciones op;
+    op.configExperimento.carga.procesos = 50;
+    op.configExperimento.hilos = std::max(1u, std::thread::hardware_concurrency());
+    bool algoritmosExplicitos = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto valor = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Falta el valor de " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--procesos") {
+            op.procesosFile = valor();
+        } else if (arg == "--dispositivos") {
+            op.dispositivosFile = valor();
+        } else if (arg == "--grupos") {
+            op.gruposFile = valor();
+        } else if (arg == "--rebanada-grupos") {
+            op.rebanadaGrupos = std::stoll(valor());
+        } else if (arg == "--dvfs") {
+            op.dvfsFile = valor();
+            op.conDVFS = true;
+        } else if (arg == "--gobernador") {
+            op.gobernador = parsearGobernador(valor());
+            op.conDVFS = true;
+        } else if (arg == "--comparar-gobernadores") {
+            op.compararGobernadores = true;
+            op.conDVFS = true;
+        } else if (arg == "--recursos") {
+            op.recursosFile = valor();
+        } else if (arg == "--acciones") {
+            op.accionesFile = valor();
+        } else if (arg == "--protocolo") {
+            op.protocolo = parsearProtocolo(valor());
+        } else if (arg == "--comparar-protocolos") {
+            op.compararProtocolos = true;
+        } else if (arg == "--entrega") {
+            Parser::parsearEntrega(valor(), op.entrega, op.parametroEntrega);
+        } else if (arg == "--costo-despertar") {
+            op.costoDespertar = std::stoll(valor());
+        } else if (arg == "--comparar-entregas") {
+            op.compararEntregas = true;
+        } else if (arg == "--perfil-recursos") {
+            op.perfilRecursos = true;
+        } else if (arg == "--algoritmos") {
+            op.algoritmos.clear();
+            algoritmosExplicitos = true;
+            std::stringstream ss(valor());
+            std::string nombre;
+            while (std::getline(ss, nombre, ',')) {
+                op.algoritmos.push_back(parsearAlgoritmo(nombre));
+            }
+        } else if (arg == "--quantum") {
+            op.quantum = std::stoll(valor());
+            if (op.quantum < 1) {
+                throw std::runtime_error("El quantum debe ser positivo");
+            }
+        } else if (arg == "--trace") {
+            op.traceFile = valor();
+        } else if (arg == "--servir") {
+            op.socketFile = valor();
+        } else if (arg == "--svg") {
+            op.svgFile = valor();
+        } else if (arg == "--png") {
+            op.pngPrefijo = valor();
+        } else if (arg == "--escala") {
+            op.imagen.pixelesPorCiclo = std::stod(valor());
+        } else if (arg == "--tesela") {
+            op.imagen.tesela = std::stoi(valor());
+        } else if (arg == "--almacen") {
+            op.almacenDir = valor();
+        } else if (arg == "--gantt") {
+            op.mostrarGantt = true;
+        } else if (arg == "--stats") {
+            op.mostrarEstadisticas = true;
+        } else if (arg == "--experimento") {
+            op.experimento = true;
+        } else if (arg == "--replicas") {
+            op.configExperimento.replicas = std::stoll(valor());
+        } else if (arg == "--tamano") {
+            op.configExperimento.carga.procesos = std::stoll(valor());
+        } else if (arg == "--semilla") {
+            op.configExperimento.semilla = std::stoull(valor());
+        } else if (arg == "--hilos") {
+            op.configExperimento.hilos = std::max(1, std::stoi(valor()));
+        } else if (arg == "--confianza") {
+            op.configExperimento.confianza = std::stod(valor());
+            if (!(op.configExperimento.confianza > 0 && op.configExperimento.confianza < 1)) {
+                throw std::runtime_error("El nivel de confianza debe estar entre 0 y 1");
+            }
+        } else if (arg == "--en-linea") {
+            op.entradaEnLinea = valor();
+        } else if (arg == "--cada") {
+            op.reporteCada = std::stoll(valor());
+        } else if (aplicarOpcionCarga(op.configExperimento.carga, arg, valor)) {
+            // Opción de la distribución de cargas
+        } else if (arg == "--ayuda" || arg == "-h" || arg == "--help") {
+            mostrarAyuda();
+            std::exit(0);
+        } else {
+            throw std::runtime_error("Opción desconocida: " + arg);
+        }
+    }
+    op.configExperimento.quantum = op.quantum;
+    op.imagen.hilos = op.configExperimento.hilos;
+    if (algoritmosExplicitos) {
+        op.configExperimento.algoritmos = op.algoritmos;
+    }
+    return op;
+}
+
+void imprimirEstadisticas(const Estadisticas& est) {
+    if (!INSTRUMENTACION_ACTIVA) {
+        std::cout << "Instrumentación deshabilitada (compilar con INSTRUMENTACION=1)\n";
+        return;
+    }
+    std::cout << "Despachos           : " << est.despachos << "\n"
+              << "Expropiaciones      : " << est.expropiaciones << "\n"
+              << "Eventos emitidos    : " << est.eventosEmitidos << "\n"
+              << "Búsquedas recurso   : " << est.busquedasRecurso << "\n";
+    for (int f = 0; f < NUM_FASES; ++f) {
+        std::cout << "  " << nombreFase(f) << ": " << est.nanosFase[f] / 1000.0 << " us\n";
+    }
+    std::cout << "  Total: " << est.nanosTotal / 1000.0 << " us\n";
+}
+
+void imprimirResumen(const char* nombre, const Resumen& r) {
+    std::cout << "  " << std::left << std::setw(14) << nombre << std::right
+              << std::setw(12) << r.media << " ± " << std::setw(8) << r.margen
+              << "  (sd " << r.desviacion << ")\n";
+}
+
+// Una fila por grupo del reparto justo: CPU recibida frente a la
+// merecida por peso, cuota de la corrida frente a la objetivo y latencia
+// frente a la respuesta objetivo
+void imprimirGrupos(const std::vector<UsoGrupo>& grupos) {
+    std::cout << "Grupos:\n"
+              << std::left << std::setw(20) << "  Grupo" << std::right << std::setw(6) << "Peso"
+              << std::setw(10) << "Procesos" << std::setw(12) << "CPU" << std::setw(12) << "Merecida"
+              << std::setw(9) << "Cuota" << std::setw(12) << "Cuota obj." << std::setw(11) << "Espera"
+              << std::setw(11) << "Respuesta" << std::setw(12) << "Resp. obj." << "\n";
+    for (const auto& g : grupos) {
+        std::ostringstream merecida, cuota, objetivo, espera, respuesta, cumple;
+        merecida << std::fixed << std::setprecision(0) << g.cpuMerecida;
+        cuota << std::fixed << std::setprecision(1) << 100.0 * g.cuota << "%";
+        objetivo << std::fixed << std::setprecision(1) << 100.0 * g.cuotaObjetivo << "%";
+        espera << std::fixed << std::setprecision(2) << g.esperaPromedio;
+        respuesta << std::fixed << std::setprecision(2) << g.respuestaPromedio;
+        if (g.respuestaObjetivo > 0) {
+            cumple << g.respuestaObjetivo << (g.respuestaPromedio <= g.respuestaObjetivo ? " ok" : " NO");
+        } else {
+            cumple << "-";
+        }
+        std::cout << std::left << std::setw(20) << "  " + std::string(2 * g.nivel, ' ') + g.nombre << std::right
+                  << std::setw(6) << g.peso << std::setw(10) << g.procesos << std::setw(12) << g.cpu
+                  << std::setw(12) << merecida.str() << std::setw(9) << cuota.str()
+                  << std::setw(12) << objetivo.str() << std::setw(11) << espera.str()
+                  << std::setw(11) << respuesta.str() << std::setw(12) << cumple.str() << "\n";
+    }
+}
+
+// Energía de la corrida por tipo y ciclos ejecutando en cada nivel
+void imprimirEnergia(const ConsumoEnergia& e, const ModeloDVFS& modelo) {
+    std::ostringstream total, frecuencia;
+    total << std::fixed << std::setprecision(2) << e.total << " (activa " << e.activa << ", ociosa "
+          << e.ociosa << ", cambios " << e.cambios << ")";
+    frecuencia << std::fixed << std::setprecision(0) << e.frecuenciaMedia;
+    std::cout << "Energía             : " << total.str() << " con " << e.gobernador << "\n"
+              << "  Frecuencia media " << frecuencia.str() << ", " << e.numCambios << " cambios de nivel ("
+              << e.ciclosCambio << " ciclos)\n  Ciclos por nivel:";
+    for (size_t k = 0; k < e.ciclosPorNivel.size(); ++k) {
+        std::cout << " " << modelo.niveles[k].frecuencia << "=" << e.ciclosPorNivel[k];
+    }
+    std::cout << "\n";
+}
+
+// Utilización de la CPU, throughput, uso de cada dispositivo de E/S y de
+// cada grupo
+void imprimirRendimiento(const Rendimiento& r) {
+    std::ostringstream cpu;
+    cpu << std::fixed << std::setprecision(1) << 100.0 * r.utilizacionCPU << "%";
+    std::cout << "CPU Utilization     : " << cpu.str() << " de " << r.duracion << " ciclos\n"
+              << "Throughput          : " << r.throughput << " procesos/ciclo\n";
+    for (const auto& d : r.dispositivos) {
+        std::ostringstream uso;
+        uso << std::fixed << std::setprecision(1) << 100.0 * d.utilizacion << "%";
+        std::cout << "  " << d.nombre << " (" << d.servidores << (d.servidores == 1 ? " servidor" : " servidores")
+                  << "): " << uso.str() << " ocupado, " << d.solicitudes << " solicitudes, espera en cola "
+                  << d.espera << " (demoradas: " << d.demoradas << ")\n";
+    }
+    if (!r.grupos.empty()) {
+        imprimirGrupos(r.grupos);
+    }
+}
+
+// Una fila por algoritmo: utilización de la CPU y de cada dispositivo,
+// throughput, espera media y energía (con DVFS)
+void compararRendimiento(const std::vector<std::pair<TipoAlgoritmo, Rendimiento>>& filas,
+                         const std::vector<double>& esperas) {
+    bool conEnergia = !filas[0].second.energia.gobernador.empty();
+    std::cout << "== Rendimiento por algoritmo ==\n"
+              << std::left << std::setw(10) << "Algoritmo" << std::right << std::setw(9) << "CPU"
+              << std::setw(13) << "Throughput" << std::setw(12) << "Espera";
+    if (conEnergia) std::cout << std::setw(13) << "Energía";
+    for (const auto& d : filas[0].second.dispositivos) std::cout << std::setw(12) << d.nombre;
+    std::cout << "\n";
+    for (size_t i = 0; i < filas.size(); ++i) {
+        const Rendimiento& r = filas[i].second;
+        std::ostringstream cpu, throughput, espera;
+        cpu << std::fixed << std::setprecision(1) << 100.0 * r.utilizacionCPU << "%";
+        throughput << std::setprecision(4) << r.throughput;
+        espera << std::fixed << std::setprecision(2) << esperas[i];
+        std::cout << std::left << std::setw(10) << nombreAlgoritmo(filas[i].first) << std::right
+                  << std::setw(9) << cpu.str() << std::setw(13) << throughput.str() << std::setw(12) << espera.str();
+        if (conEnergia) {
+            std::ostringstream energia;
+            energia << std::fixed << std::setprecision(2) << r.energia.total;
+            std::cout << std::setw(12) << energia.str();
+        }
+        for (const auto& d : r.dispositivos) {
+            std::ostringstream uso;
+            uso << std::fixed << std::setprecision(1) << 100.0 * d.utilizacion << "%";
+            std::cout << std::setw(12) << uso.str();
+        }
+        std::cout << "\n";
+    }
+}
+
+// Cada algoritmo con los tres gobernadores: espera y respuesta frente a
+// la energía consumida y la frecuencia media
+void compararGobernadores(SimuladorCalendarizacion& simulador, const ModeloDVFS& modelo, const Opciones& op) {
+    const TipoGobernador gobernadores[] = {GOBERNADOR_RENDIMIENTO, GOBERNADOR_AHORRO, GOBERNADOR_BAJO_DEMANDA};
+    simulador.setReceptor(nullptr);
+    simulador.setRetenerEventos(false);
+    std::cout << "== Gobernadores DVFS ==\n"
+              << std::left << std::setw(10) << "Algoritmo" << std::setw(13) << "Gobernador" << std::right
+              << std::setw(11) << "Espera" << std::setw(11) << "Respuesta" << std::setw(14) << "Finalización"
+              << std::setw(13) << "Energía" << std::setw(10) << "Cambios" << std::setw(12) << "Frec. media" << "\n";
+    for (TipoAlgoritmo tipo : op.algoritmos) {
+        for (TipoGobernador g : gobernadores) {
+            simulador.setDVFS(modelo, g);
+            simulador.ejecutar(tipo);
+            ConsumoEnergia e = simulador.getRendimiento().energia;
+            std::ostringstream espera, respuesta, finalizacion, energia, frecuencia;
+            espera << std::fixed << std::setprecision(2) << simulador.getAvgWaitingTime();
+            respuesta << std::fixed << std::setprecision(2) << simulador.getAvgResponseTime();
+            finalizacion << std::fixed << std::setprecision(2) << simulador.getAvgCompletionTime();
+            energia << std::fixed << std::setprecision(2) << e.total;
+            frecuencia << std::fixed << std::setprecision(0) << e.frecuenciaMedia;
+            std::cout << std::left << std::setw(10) << nombreAlgoritmo(tipo) << std::setw(13) << nombreGobernador(g)
+                      << std::right << std::setw(11) << espera.str() << std::setw(11) << respuesta.str()
+                      << std::setw(13) << finalizacion.str() << std::setw(12) << energia.str()
+                      << std::setw(10) << e.numCambios << std::setw(12) << frecuencia.str() << "\n";
+        }
+    }
+    simulador.setDVFS(modelo, op.gobernador);
+}
+
+// ------------------------------------------------------------
+// Sincronización
+// ------------------------------------------------------------
+
+void imprimirBloqueo(const ResumenBloqueo& r) {
+    std::cout << "Tiempo bloqueado por prioridad:\n";
+    for (const auto& nivel : r.niveles) {
+        std::cout << "  Prioridad " << nivel.prioridad << ": " << nivel.total << " ciclos en "
+                  << nivel.procesos << " procesos (máximo " << nivel.maximo << ")\n";
+    }
+    std::cout << "Inversiones de prioridad: " << r.inversiones
+              << ", ciclos cedidos: " << r.ciclosDonados << "\n";
+}
+
+// Cada algoritmo con los tres protocolos: tiempo bloqueado por nivel de
+// prioridad y su reducción respecto de no usar protocolo
+void compararProtocolos(SimuladorSincronizacion& simulador, const Opciones& op) {
+    const ProtocoloRecursos protocolos[] = {PROTOCOLO_NINGUNO, PROTOCOLO_HERENCIA, PROTOCOLO_TECHO};
+    simulador.setReceptor(nullptr);
+    simulador.setRetenerEventos(false);
+    for (TipoAlgoritmo tipo : op.algoritmos) {
+        std::vector<ResumenBloqueo> resumenes;
+        for (ProtocoloRecursos p : protocolos) {
+            simulador.setProtocolo(p);
+            simulador.ejecutar(tipo);
+            resumenes.push_back(simulador.getResumenBloqueo());
+        }
+
+        std::cout << "== Protocolos (" << nombreAlgoritmo(tipo) << ") ==\n";
+        std::cout << std::left << std::setw(16) << "Prioridad" << std::right;
+        for (ProtocoloRecursos p : protocolos) std::cout << std::setw(18) << nombreProtocolo(p);
+        std::cout << "\n";
+        for (size_t n = 0; n < resumenes[0].niveles.size(); ++n) {
+            Tiempo base = resumenes[0].niveles[n].total;
+            std::cout << std::left << std::setw(16) << resumenes[0].niveles[n].prioridad << std::right;
+            for (const auto& r : resumenes) {
+                std::ostringstream celda;
+                celda << r.niveles[n].total;
+                if (&r != &resumenes[0] && base > 0) {
+                    celda << " (" << std::showpos << std::fixed << std::setprecision(1)
+                          << 100.0 * (static_cast<double>(r.niveles[n].total) - base) / base << "%)";
+                }
+                std::cout << std::setw(18) << celda.str();
+            }
+            std::cout << "\n";
+        }
+        std::cout << std::left << std::setw(16) << "Inversiones" << std::right;
+        for (const auto& r : resumenes) std::cout << std::setw(18) << r.inversiones;
+        std::cout << "\n" << std::left << std::setw(16) << "Ciclos cedidos" << std::right;
+        for (const auto& r : resumenes) std::cout << std::setw(18) << r.ciclosDonados;
+        std::cout << "\n";
+    }
+    simulador.setProtocolo(op.protocolo);
+}
+
+void imprimirContencion(const ResumenContencion& c) {
+    std::cout << "Contención: trabajo " << c.trabajo << "/" << c.trabajoTotal
+              << ", giro " << c.ciclosGiro << ", despertar " << c.ciclosDespertar
+              << " (" << c.despertares << " despertares, " << c.despertaresInutiles << " inútiles)\n"
+              << "Adelantamientos: " << c.adelantamientos << ", espera media "
+              << (c.esperas > 0 ? static_cast<double>(c.esperaTotal) / c.esperas : 0.0)
+              << " (máxima " << c.esperaMaxima << ")\n";
+}
+
+// Tabla de contención por recurso, del que más espera causó al que menos.
+// Con "detalle" agrega los histogramas y el uso a lo largo de la corrida
+// (un carácter por ventana, de ' ' = libre a '#' = lleno).
+void imprimirPerfilRecursos(std::vector<PerfilRecurso> perfiles, bool detalle) {
+    std::stable_sort(perfiles.begin(), perfiles.end(), [](const PerfilRecurso& a, const PerfilRecurso& b) {
+        return a.espera.suma > b.espera.suma;
+    });
+    std::cout << std::left << std::setw(14) << "Recurso" << std::right << std::setw(5) << "Cap"
+              << std::setw(10) << "Adquis." << std::setw(10) << "Disput." << std::setw(11) << "Cola máx"
+              << std::setw(18) << "Retención m/máx" << std::setw(17) << "Espera m/máx"
+              << std::setw(14) << "Espera total" << std::setw(8) << "Uso" << "\n";
+    for (const auto& p : perfiles) {
+        std::ostringstream retencion, espera, uso;
+        retencion << std::fixed << std::setprecision(1) << p.retencion.media << "/" << p.retencion.maximo;
+        espera << std::fixed << std::setprecision(1) << p.espera.media << "/" << p.espera.maximo;
+        uso << std::fixed << std::setprecision(1) << 100.0 * p.utilizacion << "%";
+        std::cout << std::left << std::setw(14) << p.nombre << std::right << std::setw(5) << p.capacidad
+                  << std::setw(10) << p.adquisiciones << std::setw(10) << p.disputadas
+                  << std::setw(10) << p.colaMaxima << std::setw(16) << retencion.str()
+                  << std::setw(16) << espera.str() << std::setw(14) << static_cast<long long>(p.espera.suma)
+                  << std::setw(8) << uso.str() << "\n";
+        if (!detalle) continue;
+
+        auto histograma = [](const char* nombre, const ResumenColumna& r, const std::vector<long long>& cubetas) {
+            std::cout << "    " << nombre << " [" << r.minimo << ", " << r.maximo << "]:";
+            for (long long c : cubetas) std::cout << " " << c;
+            std::cout << "\n";
+        };
+        histograma("Retención", p.retencion, p.histogramaRetencion);
+        histograma("Espera   ", p.espera, p.histogramaEspera);
+        const char niveles[] = " .:-=+*%#";
+        std::cout << "    Uso       |";
+        for (float u : p.usoEnElTiempo) {
+            int nivel = static_cast<int>(std::min(1.0f, std::max(0.0f, u)) * 8.0f + 0.5f);
+            std::cout << niveles[nivel];
+        }
+        std::cout << "|\n";
+    }
+}
+
+// Cada algoritmo con las cuatro políticas de entrega aplicadas a todos los
+// recursos: trabajo completado y costo de la contención frente a la espera
+// (equidad)
+void compararEntregas(SimuladorSincronizacion& simulador, const std::vector<Recurso>& recursos,
+                      const Opciones& op) {
+    const PoliticaEntrega politicas[] = {ENTREGA_IRRUMPIR, ENTREGA_FIFO, ENTREGA_GIRAR, ENTREGA_LOTE};
+    simulador.setReceptor(nullptr);
+    simulador.setRetenerEventos(false);
+    for (TipoAlgoritmo tipo : op.algoritmos) {
+        std::cout << "== Entregas (" << nombreAlgoritmo(tipo) << ") ==\n";
+        std::cout << std::left << std::setw(13) << "Política" << std::right
+                  << std::setw(12) << "Trabajo" << std::setw(8) << "Giro" << std::setw(11) << "Despertar"
+                  << std::setw(11) << "Inútiles" << std::setw(10) << "Adelantos"
+                  << std::setw(14) << "Espera media" << std::setw(13) << "Espera máx" << "\n";
+        for (PoliticaEntrega politica : politicas) {
+            std::vector<Recurso> copia = recursos;
+            for (auto& r : copia) {
+                r.entrega = politica;
+                r.parametroEntrega = op.parametroEntrega;
+            }
+            simulador.cargarRecursos(copia);
+            simulador.ejecutar(tipo);
+            const ResumenContencion& c = simulador.getResumenContencion();
+
+            std::string nombre = nombreEntrega(politica);
+            if (politica == ENTREGA_GIRAR || politica == ENTREGA_LOTE) {
+                nombre += ":" + std::to_string(op.parametroEntrega);
+            }
+            std::ostringstream trabajo, espera;
+            trabajo << c.trabajo << "/" << c.trabajoTotal;
+            espera << std::fixed << std::setprecision(2)
+                   << (c.esperas > 0 ? static_cast<double>(c.esperaTotal) / c.esperas : 0.0);
+            std::cout << std::left << std::setw(12) << nombre << std::right
+                      << std::setw(12) << trabajo.str() << std::setw(8) << c.ciclosGiro
+                      << std::setw(11) << c.ciclosDespertar << std::setw(10) << c.despertaresInutiles
+                      << std::setw(10) << c.adelantamientos << std::setw(14) << espera.str()
+                      << std::setw(12) << c.esperaMaxima << "\n";
+        }
+    }
+    simulador.cargarRecursos(recursos);
+}
+
+void ejecutarExperimentos(const Opciones& op) {
+    const ConfiguracionExperimento& config = op.configExperimento;
+    std::cout << "Experimento: " << config.replicas << " réplicas de "
+              << config.carga.procesos << " procesos, semilla " << config.semilla
+              << ", IC " << config.confianza * 100 << "%\n";
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (const auto& res : ejecutarExperimento(config)) {
+        std::cout << "== " << nombreAlgoritmo(res.algoritmo) << " ==\n";
+        imprimirResumen("Waiting", res.espera);
+        imprimirResumen("Response", res.respuesta);
+        imprimirResumen("Completion", res.finalizacion);
+    }
+}
+
+// ------------------------------------------------------------
+// Modo en línea
+// ------------------------------------------------------------
+
+// Imprime los tramos (con --gantt) y las métricas acumuladas de un
+// algoritmo a medida que avanza la simulación en línea
+class ImpresorEnLinea : public ReceptorEventos {
+public:
+    ImpresorEnLinea(const SimuladorEnLinea& s, bool gantt, long long cada)
+        : simulador(s), nombre(nombreAlgoritmo(s.getAlgoritmo())), mostrarGantt(gantt),
+          reporteCada(cada), escribio(false) {}
+
+    void alEvento(const EventoGantt& e) override {
+        if (!mostrarGantt) return;
+        std::cout << "[" << nombre << "] " << e.pid << " [" << e.inicio << ", " << e.fin << ") "
+                  << e.estado << "\n";
+        escribio = true;
+    }
+
+    void alTerminar(const Proceso&) override {
+        const MetricasEnLinea& m = simulador.getMetricas();
+        if (reporteCada > 0 && m.terminados % reporteCada == 0) {
+            std::cout << "[" << nombre << "] t=" << simulador.getTiempoActual()
+                      << " terminados=" << m.terminados << " activos=" << m.activos
+                      << " espera=" << m.promedioEspera() << " respuesta=" << m.promedioRespuesta()
+                      << " finalización=" << m.promedioFinalizacion() << "\n";
+            escribio = true;
+        }
+    }
+
+    // Vaciar la salida si se escribió algo, para que un lector en vivo
+    // la vea sin esperar al buffer
+    void vaciar() {
+        if (escribio) {
+            std::cout.flush();
+            escribio = false;
+        }
+    }
+
+private:
+    const SimuladorEnLinea& simulador;
+    const char* nombre;
+    bool mostrarGantt;
+    long long reporteCada;
+    bool escribio;
+};
+
+void ejecutarEnLinea(const Opciones& op, ServidorEventos* servidor) {
+    if (!op.recursosFile.empty() || !op.accionesFile.empty()) {
+        throw std::runtime_error("El modo en línea no admite sincronización");
+    }
+    if (!op.gruposFile.empty()) {
+        throw std::runtime_error("El modo en línea no admite grupos");
+    }
+    if (op.conDVFS) {
+        throw std::runtime_error("El modo en línea no admite DVFS");
+    }
+    if (!op.traceFile.empty()) {
+        throw std::runtime_error("El modo en línea no admite --trace");
+    }
+    if (!op.svgFile.empty() || !op.pngPrefijo.empty()) {
+        throw std::runtime_error("El modo en línea no admite --svg ni --png");
+    }
+
+    int fd = 0;
+    if (op.entradaEnLinea != "-") {
+        fd = ::open(op.entradaEnLinea.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("No se pudo abrir el archivo: " + op.entradaEnLinea);
+        }
+    }
+
+    // Un simulador por algoritmo; todos reciben cada llegada
+    std::vector<std::unique_ptr<SimuladorEnLinea>> simuladores;
+    std::vector<std::unique_ptr<ImpresorEnLinea>> impresores;
+    std::vector<std::unique_ptr<ReceptoresMultiples>> receptores;
+    for (TipoAlgoritmo tipo : op.algoritmos) {
+        simuladores.emplace_back(new SimuladorEnLinea(tipo, op.quantum));
+        impresores.emplace_back(new ImpresorEnLinea(*simuladores.back(), op.mostrarGantt, op.reporteCada));
+        receptores.emplace_back(new ReceptoresMultiples());
+        receptores.back()->agregar(impresores.back().get());
+        if (servidor) {
+            receptores.back()->agregar(servidor->grupo(nombreAlgoritmo(tipo)));
+        }
+        simuladores.back()->setReceptor(receptores.back().get());
+    }
+
+    LectorLlegadas lector(fd);
+    Proceso p("", 0, 0, 0);
+    try {
+        while (lector.siguiente(p)) {
+            if (servidor) {
+                servidor->declararProceso(p);
+            }
+            for (size_t i = 0; i < simuladores.size(); ++i) {
+                simuladores[i]->llegada(p);
+                impresores[i]->vaciar();
+            }
+            // Antes de esperar más entrada, publicar lo que ya se decidió
+            if (servidor && !lector.hayDatosLeidos()) {
+                servidor->vaciar();
+            }
+        }
+    } catch (...) {
+        if (fd != 0) ::close(fd);
+        throw;
+    }
+    if (fd != 0) ::close(fd);
+
+    for (size_t i = 0; i < simuladores.size(); ++i) {
+        simuladores[i]->finalizar();
+        const MetricasEnLinea& m = simuladores[i]->getMetricas();
+        std::cout << "== " << nombreAlgoritmo(simuladores[i]->getAlgoritmo()) << " ==\n"
+                  << "Procesos terminados : " << m.terminados << "\n"
+                  << "Máximo de activos   : " << m.maxActivos << "\n"
+                  << "Avg Waiting Time    : " << m.promedioEspera() << "\n"
+                  << "Avg Completion Time : " << m.promedioFinalizacion() << "\n"
+                  << "Avg Response Time   : " << m.promedioRespuesta() << "\n";
+    }
+    if (servidor) {
+        servidor->terminar();
+    }
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    try {
+        Opciones op = parsearOpciones(argc, argv);
+        if (op.experimento) {
+            ejecutarExperimentos(op);
+            return 0;
+        }
+
+        // Con --servir no se simula nada hasta que se conecte la interfaz,
+        // para que no se pierda ningún mensaje
+        std::unique_ptr<ServidorEventos> servidor;
+        if (!op.socketFile.empty()) {
+            servidor.reset(new ServidorEventos(op.socketFile));
+            std::cerr << "Esperando a la interfaz en " << op.socketFile << "...\n";
+            servidor->esperarCliente();
+        }
+
+        if (!op.entradaEnLinea.empty()) {
+            ejecutarEnLinea(op, servidor.get());
+            return 0;
+        }
+
+        CargaCompartida carga = compartirCarga(Parser::cargarProcesos(op.procesosFile));
+        SimuladorSincronizacion simulador;
+        simulador.cargarCarga(carga);
+        simulador.setQuantum(op.quantum);
+        if (!op.dispositivosFile.empty()) {
+            simulador.setDispositivos(Parser::cargarDispositivos(op.dispositivosFile));
+        }
+        if (!op.gruposFile.empty()) {
+            simulador.setGrupos(Parser::cargarGrupos(op.gruposFile));
+        }
+        simulador.setRebanadaGrupos(op.rebanadaGrupos);
+        ModeloDVFS modelo = op.dvfsFile.empty() ? modeloDVFSPorDefecto() : Parser::cargarDVFS(op.dvfsFile);
+        if (op.conDVFS) {
+            simulador.setDVFS(modelo, op.gobernador);
+        }
+        if (!op.almacenDir.empty()) {
+            simulador.setAlmacenEventos(true, op.almacenDir);
+        }
+
+        bool conSincronizacion = !op.recursosFile.empty() && !op.accionesFile.empty();
+        std::vector<Recurso> recursos;
+        if (conSincronizacion) {
+            recursos = Parser::cargarRecursos(op.recursosFile);
+            simulador.cargarRecursos(recursos);
+            simulador.cargarAcciones(Parser::cargarAcciones(op.accionesFile));
+            simulador.setProtocolo(op.protocolo);
+            simulador.setEntregaPorDefecto(op.entrega, op.parametroEntrega);
+            simulador.setCostoDespertar(op.costoDespertar);
+        }
+
+        // El trace y el servidor reciben los eventos durante la
+        // simulación; si no se piden los tramos por pantalla no hace falta
+        // retenerlos. Con --almacen la imagen se dibuja desde el almacén
+        // al terminar cada corrida
+        std::unique_ptr<ExportadorTrace> exportador;
+        if (!op.traceFile.empty()) {
+            exportador.reset(new ExportadorTrace(op.traceFile));
+        }
+        std::unique_ptr<ExportadorImagen> imagen;
+        if (!op.svgFile.empty() || !op.pngPrefijo.empty()) {
+            imagen.reset(new ExportadorImagen(carga, op.imagen));
+        }
+        if (servidor) {
+            for (const auto& p : *carga) {
+                servidor->declararProceso(p);
+            }
+        }
+
+        std::vector<std::pair<TipoAlgoritmo, Rendimiento>> rendimientos;
+        std::vector<double> esperas;
+        for (TipoAlgoritmo tipo : op.algoritmos) {
+            ReceptoresMultiples receptores;
+            if (exportador) {
+                exportador->iniciarGrupo(nombreAlgoritmo(tipo));
+                receptores.agregar(exportador.get());
+            }
+            bool imagenDelAlmacen = imagen && !op.almacenDir.empty();
+            if (imagen) {
+                imagen->iniciarGrupo(nombreAlgoritmo(tipo));
+                if (!imagenDelAlmacen) receptores.agregar(imagen.get());
+            }
+            if (servidor) {
+                receptores.agregar(servidor->grupo(nombreAlgoritmo(tipo)));
+            }
+            if (!receptores.vacio()) {
+                simulador.setReceptor(&receptores);
+                simulador.setRetenerEventos(op.mostrarGantt || imagenDelAlmacen);
+            }
+            simulador.ejecutar(tipo);
+            simulador.setReceptor(nullptr);
+            if (imagenDelAlmacen && simulador.getAlmacen()) {
+                simulador.getAlmacen()->reenviar(*imagen);
+            }
+
+            std::cout << "== " << nombreAlgoritmo(tipo) << " ==\n";
+            if (op.mostrarGantt) {
+                simulador.recorrerEventos([](const EventoGantt& e) {
+                    std::cout << e.pid << " [" << e.inicio << ", " << e.fin << ") "
+                              << e.estado << "\n";
+                });
+            }
+            std::cout << "Avg Waiting Time    : " << simulador.getAvgWaitingTime() << "\n"
+                      << "Avg Completion Time : " << simulador.getAvgCompletionTime() << "\n"
+                      << "Avg Response Time   : " << simulador.getAvgResponseTime() << "\n";
+            rendimientos.push_back({tipo, simulador.getRendimiento()});
+            if (op.conDVFS) {
+                imprimirEnergia(rendimientos.back().second.energia, simulador.getDVFS());
+            }
+            esperas.push_back(simulador.getAvgWaitingTime());
+            imprimirRendimiento(rendimientos.back().second);
+            if (conSincronizacion) {
+                imprimirBloqueo(simulador.getResumenBloqueo());
+                imprimirContencion(simulador.getResumenContencion());
+                imprimirPerfilRecursos(simulador.getPerfilRecursos(), op.perfilRecursos);
+            }
+            if (op.mostrarEstadisticas) {
+                imprimirEstadisticas(simulador.getEstadisticas());
+            }
+        }
+        if (rendimientos.size() > 1) {
+            compararRendimiento(rendimientos, esperas);
+        }
+        if (op.compararGobernadores) {
+            compararGobernadores(simulador, modelo, op);
+        }
+        if (conSincronizacion && op.compararProtocolos) {
+            compararProtocolos(simulador, op);
+        }
+        if (conSincronizacion && op.compararEntregas) {
+            compararEntregas(simulador, recursos, op);
+        }
+
+        if (exportador) {
+            exportador->cerrar();
+        }
+        if (imagen && !op.svgFile.empty()) {
+            imagen->escribirSVG(op.svgFile);
+        }
+        if (imagen && !op.pngPrefijo.empty()) {
+            size_t teselas = imagen->escribirPNG(op.pngPrefijo);
+            std::cout << "Teselas PNG escritas: " << teselas << "\n";
+        }
+        if (servidor) {
+            servidor->terminar();
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,864 @@
+// comparador.cpp
+// Pruebas diferenciales de los motores de calendarización. Genera cargas
+// aleatorias pequeñas (con empates, llegadas simultáneas y llegadas justo
+// al terminar otro proceso), las ejecuta con el calendarizador de
+// referencia (include/calendarizador_referencia.h) y con los motores
+// optimizados, y compara eventos y métricas. Con --es las cargas tienen
+// además ráfagas de E/S y dispositivos. Si encuentra una diferencia
+// reduce la carga a un caso mínimo que la reproduce y lo escribe en el
+// formato de procesos.txt. Después compara el motor completo con el
+// simulador original (include/calendarizador_original.h) en cargas sin
+// empates ni E/S, y comprueba las diferencias que se introdujeron a
+// propósito con casos fijos.
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "calendarizador_original.h"
+#include "calendarizador_referencia.h"
+#include "experimentos.h"
+#include "generador_cargas.h"
+#include "parser.h"
+#include "simulador_calendarizacion.h"
+#include "simulador_en_linea.h"
+
+// ------------------------------------------------------------
+// Motores y casos
+// ------------------------------------------------------------
+
+enum Motor {
+    MOTOR_COMPLETO,    // SimuladorCalendarizacion::ejecutar
+    MOTOR_INCREMENTAL, // ejecutarIncremental desde un punto de control
+    MOTOR_EN_LINEA,    // SimuladorEnLinea con las llegadas de una en una
+    MOTOR_ALMACEN,     // Como el incremental, con los eventos en un AlmacenEventos
+    MOTOR_GRUPOS,      // Reparto justo con todos los procesos en un solo grupo
+    MOTOR_DVFS         // DVFS con el gobernador performance (frecuencia nominal)
+};
+
+const char* nombreMotor(Motor motor) {
+    switch (motor) {
+        case MOTOR_COMPLETO:    return "completo";
+        case MOTOR_INCREMENTAL: return "incremental";
+        case MOTOR_EN_LINEA:    return "en-linea";
+        case MOTOR_ALMACEN:     return "almacen";
+        case MOTOR_GRUPOS:      return "grupos";
+        case MOTOR_DVFS:        return "dvfs";
+    }
+    return "?";
+}
+
+// Los motores que hacen una corrida previa con "agregados" y "quantumPrevio"
+bool conCorridaPrevia(Motor motor) {
+    return motor == MOTOR_INCREMENTAL || motor == MOTOR_ALMACEN;
+}
+
+struct Caso {
+    std::vector<Proceso> carga;
+    std::vector<Dispositivo> dispositivos;
+    Tiempo quantum = 2;
+
+    // Solo para los motores incremental y almacen: la corrida previa se
+    // hace sin los últimos "agregados" procesos y con "quantumPrevio"
+    size_t agregados = 0;
+    Tiempo quantumPrevio = 2;
+};
+
+struct Opciones {
+    long long casos = 10000;
+    uint64_t semilla = 1;
+    int maxProcesos = 12;
+    bool conES = false;        // Generar ráfagas de E/S y dispositivos
+    std::vector<TipoAlgoritmo> algoritmos;
+    std::vector<Motor> motores;
+    std::string cargaFile;     // Repetir un caso en lugar de generar
+    std::string dispositivosFile;
+    std::string salida;        // Dónde escribir el caso reducido
+    Caso replica;              // Parámetros del caso a repetir
+};
+
+void mostrarAyuda() {
+    std::cout <<
+        "Uso: comparador [opciones]\n"
+        "  --casos <n>             Cargas aleatorias a probar (por defecto 10000)\n"
+        "  --semilla <s>           Semilla (por defecto 1)\n"
+        "  --procesos <n>          Máximo de procesos por carga (por defecto 12)\n"
+        "  --algoritmo <nombre>    FIFO, SJF, SRTF, RR o PRIO (repetible; por defecto todos)\n"
+        "  --motor <nombre>        completo, incremental, en-linea, almacen, grupos o\n"
+        "                          dvfs (repetible; por defecto todos)\n"
+        "  --es                    Cargas con ráfagas de E/S y dispositivos (sin el motor\n"
+        "                          en línea, que no las admite)\n"
+        "  --salida <archivo>      Escribir ahí el caso reducido si hay una diferencia\n"
+        "Para repetir un caso:\n"
+        "  --carga <archivo>       Procesos en el formato de procesos.txt\n"
+        "  --dispositivos <arch.>  Dispositivos en el formato de dispositivos.txt\n"
+        "  --quantum <n>           Quantum (por defecto 2)\n"
+        "  --agregados <n>         Procesos agregados antes de la corrida incremental\n"
+        "  --quantum-previo <n>    Quantum de la corrida previa a la incremental\n";
+}
+
+TipoAlgoritmo parsearAlgoritmo(const std::string& nombre) {
+    if (nombre == "FIFO") return FIFO;
+    if (nombre == "SJF") return SJF;
+    if (nombre == "SRTF") return SRTF;
+    if (nombre == "RR") return ROUND_ROBIN;
+    if (nombre == "PRIO" || nombre == "PRIORITY") return PRIORITY;
+    throw std::runtime_error("Algoritmo desconocido: " + nombre);
+}
+
+Motor parsearMotor(const std::string& nombre) {
+    if (nombre == "completo") return MOTOR_COMPLETO;
+    if (nombre == "incremental") return MOTOR_INCREMENTAL;
+    if (nombre == "en-linea") return MOTOR_EN_LINEA;
+    if (nombre == "almacen") return MOTOR_ALMACEN;
+    if (nombre == "grupos") return MOTOR_GRUPOS;
+    if (nombre == "dvfs") return MOTOR_DVFS;
+    throw std::runtime_error("Motor desconocido: " + nombre);
+}
+
+// ------------------------------------------------------------
+// Ejecución de los motores
+// ------------------------------------------------------------
+
+// Recoge lo que publica el simulador en línea; las métricas llegan por
+// pid y se ubican en la fila del proceso en la carga
+class ReceptorComparacion : public ReceptorEventos {
+public:
+    ReceptorComparacion(const std::vector<Proceso>& carga, ResultadoSimulacion& r) : resultado(r) {
+        for (size_t i = 0; i < carga.size(); ++i) fila[carga[i].pid] = i;
+        resultado.espera.assign(carga.size(), 0);
+        resultado.respuesta.assign(carga.size(), 0);
+        resultado.finalizacion.assign(carga.size(), 0);
+        resultado.inicio.assign(carga.size(), -1);
+    }
+
+    void alEvento(const EventoGantt& e) override { resultado.eventos.push_back(e); }
+
+    void alTerminar(const Proceso& p) override {
+        size_t i = fila.at(p.pid);
+        resultado.espera[i] = p.waitingTime;
+        resultado.respuesta[i] = p.responseTime;
+        resultado.finalizacion[i] = p.completionTime;
+        resultado.inicio[i] = p.startTime;
+    }
+
+private:
+    ResultadoSimulacion& resultado;
+    std::unordered_map<std::string, size_t> fila;
+};
+
+ResultadoSimulacion correrMotor(Motor motor, TipoAlgoritmo tipo, const Caso& c) {
+    switch (motor) {
+        case MOTOR_COMPLETO: {
+            // Otro algoritmo antes, para ejercitar la reutilización del
+            // simulador entre corridas
+            SimuladorCalendarizacion s;
+            s.setQuantum(c.quantum);
+            s.setDispositivos(c.dispositivos);
+            s.cargarCarga(compartirCarga(c.carga));
+            s.ejecutar(static_cast<TipoAlgoritmo>((tipo + 1) % 5));
+            s.ejecutar(tipo);
+            return s.tomarResultado();
+        }
+        case MOTOR_INCREMENTAL:
+        case MOTOR_ALMACEN: {
+            SimuladorCalendarizacion s;
+            s.setPuntosControl(8);
+            s.setAlmacenEventos(motor == MOTOR_ALMACEN);
+            s.setQuantum(c.quantumPrevio);
+            s.setDispositivos(c.dispositivos);
+            size_t base = c.carga.size() - std::min(c.agregados, c.carga.size());
+            s.cargarProcesos(std::vector<Proceso>(c.carga.begin(), c.carga.begin() + base));
+            s.ejecutar(tipo);
+            s.setQuantum(c.quantum);
+            for (size_t i = base; i < c.carga.size(); ++i) s.agregarProceso(c.carga[i]);
+            s.ejecutarIncremental(tipo);
+            ResultadoSimulacion r = s.tomarResultado();
+            // Se comparan los eventos leídos de vuelta del almacén
+            if (r.almacen) {
+                for (size_t k = 0; k < r.almacen->tamano(); ++k) r.eventos.push_back(r.almacen->evento(k));
+            }
+            return r;
+        }
+        case MOTOR_GRUPOS: {
+            // Un subgrupo con toda la carga y un hermano declarado sin
+            // procesos: el reparto no debe cambiar ningún tramo
+            SimuladorCalendarizacion s;
+            s.setQuantum(c.quantum);
+            s.setDispositivos(c.dispositivos);
+            s.setGrupos({Grupo("todos", 3), Grupo("todos/carga", 2), Grupo("vacio", 1)});
+            std::vector<Proceso> carga = c.carga;
+            for (auto& p : carga) p.grupo = "todos/carga";
+            s.cargarProcesos(carga);
+            s.ejecutar(tipo);
+            return s.tomarResultado();
+        }
+        case MOTOR_DVFS: {
+            // El gobernador performance se queda en el nivel más alto, al
+            // que los tramos duran su trabajo: el calendario no debe cambiar
+            SimuladorCalendarizacion s;
+            s.setQuantum(c.quantum);
+            s.setDispositivos(c.dispositivos);
+            s.setDVFS(modeloDVFSPorDefecto(), GOBERNADOR_RENDIMIENTO);
+            s.cargarCarga(compartirCarga(c.carga));
+            s.ejecutar(tipo);
+            return s.tomarResultado();
+        }
+        case MOTOR_EN_LINEA: {
+            ResultadoSimulacion r;
+            r.algoritmo = tipo;
+            ReceptorComparacion receptor(c.carga, r);
+            SimuladorEnLinea s(tipo, c.quantum);
+            s.setReceptor(&receptor);
+            std::vector<Proceso> llegadas = c.carga;
+            std::stable_sort(llegadas.begin(), llegadas.end(),
+                [](const Proceso& a, const Proceso& b) { return a.arrivalTime < b.arrivalTime; });
+            for (const auto& p : llegadas) s.llegada(p);
+            s.finalizar();
+            return r;
+        }
+    }
+    return ResultadoSimulacion();
+}
+
+std::string describirEvento(const std::vector<EventoGantt>& eventos, size_t i) {
+    if (i >= eventos.size()) return "(ninguno)";
+    const EventoGantt& e = eventos[i];
+    std::string texto = e.pid + " [" + std::to_string(e.inicio) + ", " + std::to_string(e.fin) + ")";
+    return e.estado == "IO" ? texto + " E/S" : texto;
+}
+
+// Los tramos de CPU se comparan en el orden en que salen; los de E/S se
+// publican al volver el proceso, en un orden que depende del motor, así
+// que van al final ordenados por inicio
+std::vector<EventoGantt> normalizarEventos(const std::vector<EventoGantt>& eventos) {
+    std::vector<EventoGantt> cpu, es;
+    for (const auto& e : eventos) {
+        (e.estado == "IO" ? es : cpu).push_back(e);
+    }
+    std::sort(es.begin(), es.end(), [](const EventoGantt& a, const EventoGantt& b) {
+        if (a.inicio != b.inicio) return a.inicio < b.inicio;
+        return a.pid < b.pid;
+    });
+    cpu.insert(cpu.end(), es.begin(), es.end());
+    return cpu;
+}
+
+// Primera diferencia entre el resultado de referencia y el del motor, o
+// una cadena vacía si coinciden
+std::string diferencia(const ResultadoSimulacion& ref, const ResultadoSimulacion& r,
+                       const std::vector<Proceso>& carga, const std::string& nombreRef = "referencia") {
+    const std::vector<EventoGantt> eventosRef = normalizarEventos(ref.eventos);
+    const std::vector<EventoGantt> eventos = normalizarEventos(r.eventos);
+    size_t n = std::max(eventosRef.size(), eventos.size());
+    for (size_t i = 0; i < n; ++i) {
+        bool igual = i < eventosRef.size() && i < eventos.size() &&
+                     eventosRef[i].pid == eventos[i].pid &&
+                     eventosRef[i].inicio == eventos[i].inicio &&
+                     eventosRef[i].fin == eventos[i].fin &&
+                     eventosRef[i].estado == eventos[i].estado;
+        if (!igual) {
+            return "evento " + std::to_string(i) + ": " + nombreRef + " " + describirEvento(eventosRef, i) +
+                   ", motor " + describirEvento(eventos, i);
+        }
+    }
+
+    struct Columna {
+        const char* nombre;
+        const std::vector<Tiempo>& referencia;
+        const std::vector<Tiempo>& motor;
+    };
+    const Columna columnas[] = {
+        {"espera", ref.espera, r.espera},
+        {"respuesta", ref.respuesta, r.respuesta},
+        {"finalización", ref.finalizacion, r.finalizacion},
+        {"inicio", ref.inicio, r.inicio},
+    };
+    for (const auto& col : columnas) {
+        if (col.motor.size() != col.referencia.size()) {
+            return std::string(col.nombre) + ": " + std::to_string(col.motor.size()) +
+                   " filas en lugar de " + std::to_string(col.referencia.size());
+        }
+        for (size_t i = 0; i < col.referencia.size(); ++i) {
+            if (col.referencia[i] != col.motor[i]) {
+                return carga[i].pid + ": " + col.nombre + " " + nombreRef + " " + std::to_string(col.referencia[i]) +
+                       ", motor " + std::to_string(col.motor[i]);
+            }
+        }
+    }
+    return "";
+}
+
+std::string comparar(Motor motor, TipoAlgoritmo tipo, const Caso& c) {
+    CalendarizadorReferencia referencia(c.carga, c.quantum, c.dispositivos);
+    try {
+        return diferencia(referencia.ejecutar(tipo), correrMotor(motor, tipo, c), c.carga);
+    } catch (const std::exception& e) {
+        return std::string("el motor lanzó una excepción: ") + e.what();
+    }
+}
+
+// ------------------------------------------------------------
+// Generación y reducción de casos
+// ------------------------------------------------------------
+
+// Pocos valores distintos de ráfaga y prioridad para forzar empates; las
+// separaciones mezclan llegadas simultáneas, seguidas y con CPU ociosa.
+// Con E/S, la mayoría de los procesos alterna hasta cuatro ráfagas de CPU
+// con otras de E/S sobre uno o dos dispositivos con pocos servidores, de
+// modo que también haya colas y regresos simultáneos.
+Caso generarCaso(GeneradorAleatorio& rng, int maxProcesos, bool conES) {
+    Caso c;
+    long long n = rng.entero(1, maxProcesos);
+    Tiempo maxRafaga = rng.entero(1, 8);
+    Tiempo llegada = rng.uniforme01() < 0.3 ? rng.entero(1, 5) : 0;
+    for (long long i = 0; i < n; ++i) {
+        if (i > 0) {
+            // 40 % simultáneas con la anterior
+            double u = rng.uniforme01();
+            if (u >= 0.85) llegada += rng.entero(4, 15);
+            else if (u >= 0.4) llegada += rng.entero(1, 3);
+        }
+        Tiempo rafaga = rng.uniforme01() < 0.05 ? 0 : rng.entero(1, maxRafaga);
+        int prioridad = static_cast<int>(rng.entero(1, 3));
+        c.carga.push_back(Proceso("", rafaga, llegada, prioridad));
+    }
+
+    if (conES) {
+        long long numDispositivos = rng.entero(1, 2);
+        for (long long d = 0; d < numDispositivos; ++d) {
+            c.dispositivos.push_back(Dispositivo("d" + std::to_string(d + 1), static_cast<int>(rng.entero(1, 2)),
+                                                 rng.entero(0, 2)));
+        }
+        for (auto& p : c.carga) {
+            if (p.burstTime == 0 || rng.uniforme01() < 0.3) continue;
+            long long rafagas = rng.entero(2, 4);
+            p.rafagasCPU.clear();
+            p.rafagasES.clear();
+            p.burstTime = 0;
+            for (long long k = 0; k < rafagas; ++k) {
+                if (k > 0) {
+                    const Dispositivo& d = c.dispositivos[static_cast<size_t>(rng.entero(0, numDispositivos - 1))];
+                    p.rafagasES.push_back({d.nombre, rng.entero(1, 6)});
+                }
+                p.rafagasCPU.push_back(rng.entero(1, maxRafaga));
+                p.burstTime += p.rafagasCPU.back();
+            }
+            p.remainingTime = p.rafagasCPU[0];
+        }
+    }
+
+    // La mitad de las cargas no viene ordenada por llegada
+    if (rng.uniforme01() < 0.5) {
+        for (size_t i = c.carga.size(); i-- > 1;) {
+            std::swap(c.carga[i], c.carga[static_cast<size_t>(rng.entero(0, static_cast<long long>(i)))]);
+        }
+    }
+    for (size_t i = 0; i < c.carga.size(); ++i) {
+        c.carga[i].pid = "P" + std::to_string(i + 1);
+    }
+
+    c.quantum = rng.entero(1, 4);
+    c.quantumPrevio = rng.entero(1, 4);
+    c.agregados = static_cast<size_t>(rng.entero(0, std::min<long long>(n, 3)));
+    return c;
+}
+
+// Reducir el caso mientras siga divergiendo: primero se quitan bloques de
+// procesos cada vez más pequeños y después se simplifica cada campo
+// (ráfagas y llegadas más cortas, prioridad 1, quantum menor)
+Caso reducir(Caso c, Motor motor, TipoAlgoritmo tipo) {
+    auto diverge = [&](const Caso& candidato) { return !comparar(motor, tipo, candidato).empty(); };
+    auto probar = [&](const Caso& candidato) {
+        if (!diverge(candidato)) return false;
+        c = candidato;
+        return true;
+    };
+
+    bool cambio = true;
+    while (cambio) {
+        cambio = false;
+
+        for (size_t tam = std::max<size_t>(1, c.carga.size() / 2); tam >= 1; tam /= 2) {
+            for (size_t inicio = 0; inicio < c.carga.size() && c.carga.size() > 1;) {
+                Caso candidato = c;
+                size_t fin = std::min(inicio + tam, candidato.carga.size());
+                candidato.carga.erase(candidato.carga.begin() + static_cast<std::ptrdiff_t>(inicio),
+                                      candidato.carga.begin() + static_cast<std::ptrdiff_t>(fin));
+                candidato.agregados = std::min(candidato.agregados, candidato.carga.size());
+                if (probar(candidato)) cambio = true;
+                else inicio += tam;
+            }
+            if (tam == 1) break;
+        }
+
+        for (size_t i = 0; i < c.carga.size(); ++i) {
+            const Proceso p = c.carga[i];
+            if (p.tieneES()) {
+                // Sin E/S: una sola ráfaga con el mismo total de CPU
+                Caso candidato = c;
+                candidato.carga[i].rafagasCPU.clear();
+                candidato.carga[i].rafagasES.clear();
+                candidato.carga[i].remainingTime = p.burstTime;
+                if (probar(candidato)) cambio = true;
+            }
+            const Tiempo rafagas[] = {1, p.burstTime / 2, p.burstTime - 1};
+            for (Tiempo v : rafagas) {
+                if (c.carga[i].tieneES()) break;
+                if (v < 1 || v >= c.carga[i].burstTime) continue;
+                Caso candidato = c;
+                candidato.carga[i].burstTime = v;
+                candidato.carga[i].remainingTime = v;
+                if (probar(candidato)) cambio = true;
+            }
+            const Tiempo llegadas[] = {0, p.arrivalTime / 2, p.arrivalTime - 1};
+            for (Tiempo v : llegadas) {
+                if (v < 0 || v >= c.carga[i].arrivalTime) continue;
+                Caso candidato = c;
+                candidato.carga[i].arrivalTime = v;
+                if (probar(candidato)) cambio = true;
+            }
+            if (c.carga[i].priority != 1) {
+                Caso candidato = c;
+                candidato.carga[i].priority = 1;
+                if (probar(candidato)) cambio = true;
+            }
+        }
+
+        const Tiempo quantums[] = {1, c.quantum - 1};
+        for (Tiempo q : quantums) {
+            if (q < 1 || q >= c.quantum) continue;
+            Caso candidato = c;
+            candidato.quantum = q;
+            if (probar(candidato)) cambio = true;
+        }
+        if (c.agregados > 0) {
+            Caso candidato = c;
+            candidato.agregados = 0;
+            if (probar(candidato)) cambio = true;
+        }
+        if (c.quantumPrevio != c.quantum) {
+            Caso candidato = c;
+            candidato.quantumPrevio = c.quantum;
+            if (probar(candidato)) cambio = true;
+        }
+    }
+
+    // Nombres correlativos para que el caso sea fácil de leer
+    for (size_t i = 0; i < c.carga.size(); ++i) {
+        c.carga[i].pid = "P" + std::to_string(i + 1);
+    }
+    return c;
+}
+
+// ------------------------------------------------------------
+// Entrada y salida
+// ------------------------------------------------------------
+
+void escribirCarga(std::ostream& out, const std::vector<Proceso>& carga) {
+    for (const auto& p : carga) {
+        out << p.pid << ", " << p.burstTime << ", " << p.arrivalTime << ", " << p.priority;
+        if (p.tieneES()) {
+            out << ",";
+            for (size_t k = 0; k < p.rafagasCPU.size(); ++k) {
+                if (k > 0) out << " " << p.rafagasES[k - 1].dispositivo << ":" << p.rafagasES[k - 1].duracion;
+                out << " " << p.rafagasCPU[k];
+            }
+        }
+        out << "\n";
+    }
+}
+
+void escribirDispositivos(std::ostream& out, const std::vector<Dispositivo>& dispositivos) {
+    for (const auto& d : dispositivos) {
+        out << d.nombre << ", " << d.servidores << ", " << d.latencia << "\n";
+    }
+}
+
+std::vector<Dispositivo> leerDispositivos(const std::string& ruta) {
+    std::ifstream in(ruta);
+    if (!in.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    }
+    std::vector<Dispositivo> dispositivos;
+    std::string linea;
+    while (std::getline(in, linea)) {
+        if (linea.find_first_not_of(" \r") == std::string::npos) continue;
+        dispositivos.push_back(Parser::parsearDispositivo(linea));
+    }
+    return dispositivos;
+}
+
+std::vector<Proceso> leerCarga(const std::string& ruta) {
+    std::ifstream in(ruta);
+    if (!in.is_open()) {
+        throw std::runtime_error("No se pudo abrir el archivo: " + ruta);
+    }
+    std::vector<Proceso> carga;
+    std::unordered_map<std::string, bool> vistos;
+    std::string linea;
+    while (std::getline(in, linea)) {
+        if (linea.find_first_not_of(" \r") == std::string::npos) continue;
+        carga.push_back(Parser::parsearProceso(linea));
+        if (!vistos.emplace(carga.back().pid, true).second) {
+            throw std::runtime_error("PID repetido en " + ruta + ": " + carga.back().pid);
+        }
+    }
+    return carga;
+}
+
+// Mostrar la diferencia y el caso con el que se repite
+void reportar(const Opciones& op, Motor motor, TipoAlgoritmo tipo, const Caso& c) {
+    std::cout << "Diferencia en " << nombreAlgoritmo(tipo) << " (motor " << nombreMotor(motor) << "): "
+              << comparar(motor, tipo, c) << "\n";
+    std::cout << "Caso (" << c.carga.size() << " procesos, quantum " << c.quantum;
+    if (conCorridaPrevia(motor)) {
+        std::cout << ", agregados " << c.agregados << ", quantum previo " << c.quantumPrevio;
+    }
+    std::cout << "):\n";
+    escribirCarga(std::cout, c.carga);
+    if (!c.dispositivos.empty()) {
+        std::cout << "Dispositivos:\n";
+        escribirDispositivos(std::cout, c.dispositivos);
+    }
+
+    CalendarizadorReferencia referencia(c.carga, c.quantum, c.dispositivos);
+    ResultadoSimulacion ref = referencia.ejecutar(tipo);
+    ResultadoSimulacion r = correrMotor(motor, tipo, c);
+    std::cout << "Referencia:";
+    for (size_t i = 0; i < ref.eventos.size(); ++i) std::cout << " " << describirEvento(ref.eventos, i);
+    std::cout << "\nMotor:     ";
+    for (size_t i = 0; i < r.eventos.size(); ++i) std::cout << " " << describirEvento(r.eventos, i);
+    std::cout << "\n";
+
+    if (!op.salida.empty()) {
+        std::ofstream out(op.salida);
+        escribirCarga(out, c.carga);
+        if (!out) {
+            throw std::runtime_error("Error al escribir en " + op.salida);
+        }
+        const std::string salidaDispositivos = op.salida + ".dispositivos";
+        if (!c.dispositivos.empty()) {
+            std::ofstream disp(salidaDispositivos);
+            escribirDispositivos(disp, c.dispositivos);
+            if (!disp) {
+                throw std::runtime_error("Error al escribir en " + salidaDispositivos);
+            }
+        }
+        std::cout << "Repetir con: comparador --carga " << op.salida << " --algoritmo " << nombreAlgoritmo(tipo)
+                  << " --motor " << nombreMotor(motor) << " --quantum " << c.quantum;
+        if (!c.dispositivos.empty()) {
+            std::cout << " --dispositivos " << salidaDispositivos;
+        }
+        if (conCorridaPrevia(motor)) {
+            std::cout << " --agregados " << c.agregados << " --quantum-previo " << c.quantumPrevio;
+        }
+        std::cout << "\n";
+    }
+}
+
+Opciones parsearOpciones(int argc, char* argv[]) {
+    Opciones op;
+    bool quantumPrevioExplicito = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto valor = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Falta el valor de " + arg);
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--casos") op.casos = std::stoll(valor());
+        else if (arg == "--semilla") op.semilla = std::stoull(valor());
+        else if (arg == "--procesos") op.maxProcesos = std::max(1, std::stoi(valor()));
+        else if (arg == "--algoritmo") op.algoritmos.push_back(parsearAlgoritmo(valor()));
+        else if (arg == "--motor") op.motores.push_back(parsearMotor(valor()));
+        else if (arg == "--es") op.conES = true;
+        else if (arg == "--salida") op.salida = valor();
+        else if (arg == "--carga") op.cargaFile = valor();
+        else if (arg == "--dispositivos") op.dispositivosFile = valor();
+        else if (arg == "--quantum") op.replica.quantum = std::stoll(valor());
+        else if (arg == "--agregados") op.replica.agregados = static_cast<size_t>(std::stoull(valor()));
+        else if (arg == "--quantum-previo") {
+            op.replica.quantumPrevio = std::stoll(valor());
+            quantumPrevioExplicito = true;
+        } else if (arg == "--ayuda" || arg == "-h" || arg == "--help") {
+            mostrarAyuda();
+            std::exit(0);
+        } else {
+            throw std::runtime_error("Opción desconocida: " + arg);
+        }
+    }
+
+    if (op.algoritmos.empty()) op.algoritmos = {FIFO, SJF, SRTF, ROUND_ROBIN, PRIORITY};
+    if (op.motores.empty()) {
+        op.motores = {MOTOR_COMPLETO, MOTOR_INCREMENTAL, MOTOR_ALMACEN, MOTOR_GRUPOS, MOTOR_DVFS};
+        if (!op.conES) op.motores.push_back(MOTOR_EN_LINEA);
+    }
+    if (op.conES && std::find(op.motores.begin(), op.motores.end(), MOTOR_EN_LINEA) != op.motores.end()) {
+        throw std::runtime_error("El motor en línea no admite ráfagas de E/S");
+    }
+    if (op.replica.quantum <= 0 || op.replica.quantumPrevio <= 0) {
+        throw std::runtime_error("El quantum debe ser positivo");
+    }
+    if (!quantumPrevioExplicito) op.replica.quantumPrevio = op.replica.quantum;
+    return op;
+}
+
+// ------------------------------------------------------------
+// Comparación con el simulador original
+// ------------------------------------------------------------
+
+// Cargas sin E/S en las que el original está bien definido: llegadas y
+// ráfagas distintas (el original deja los empates a std::sort) y ráfagas
+// de al menos un ciclo. Priority no se compara al azar porque su
+// envejecimiento cambió a propósito; ver diferenciasEsperadas.
+Caso generarCasoSinEmpates(GeneradorAleatorio& rng, int maxProcesos) {
+    Caso c;
+    long long n = rng.entero(1, maxProcesos);
+    std::vector<Tiempo> rafagas;
+    Tiempo llegada = rng.uniforme01() < 0.3 ? rng.entero(1, 5) : 0;
+    for (long long i = 0; i < n; ++i) {
+        if (i > 0) llegada += rng.uniforme01() < 0.15 ? rng.entero(4, 15) : rng.entero(1, 3);
+        Tiempo rafaga;
+        do {
+            rafaga = rng.entero(1, 4 * n);
+        } while (std::find(rafagas.begin(), rafagas.end(), rafaga) != rafagas.end());
+        rafagas.push_back(rafaga);
+        c.carga.push_back(Proceso("", rafaga, llegada, static_cast<int>(rng.entero(1, 3))));
+    }
+    if (rng.uniforme01() < 0.5) {
+        for (size_t i = c.carga.size(); i-- > 1;) {
+            std::swap(c.carga[i], c.carga[static_cast<size_t>(rng.entero(0, static_cast<long long>(i)))]);
+        }
+    }
+    for (size_t i = 0; i < c.carga.size(); ++i) {
+        c.carga[i].pid = "P" + std::to_string(i + 1);
+    }
+    c.quantum = rng.entero(1, 4);
+    return c;
+}
+
+std::string compararConOriginal(TipoAlgoritmo tipo, const Caso& c) {
+    CalendarizadorOriginal original(c.carga, c.quantum);
+    try {
+        return diferencia(original.ejecutar(tipo), correrMotor(MOTOR_COMPLETO, tipo, c), c.carga, "original");
+    } catch (const std::exception& e) {
+        return std::string("el motor lanzó una excepción: ") + e.what();
+    }
+}
+
+std::string describirTramos(const std::vector<EventoGantt>& eventos) {
+    std::string texto;
+    for (size_t i = 0; i < eventos.size(); ++i) {
+        if (i > 0) texto += " ";
+        texto += describirEvento(eventos, i);
+    }
+    return texto;
+}
+
+// Cambios de comportamiento respecto del original, cada uno con un caso
+// cuyo resultado en ambos se conoce
+struct DiferenciaEsperada {
+    const char* descripcion;
+    TipoAlgoritmo tipo;
+    std::vector<Proceso> carga;
+    const char* original;
+    const char* motor;
+};
+
+std::vector<DiferenciaEsperada> diferenciasEsperadas() {
+    return {
+        // En t = 12 el original envejece a todos los listos con su reloj
+        // común: P3, listo desde 9, mejora a 1. En los motores P3 lleva 3
+        // ciclos listo (sin pasos) y P2 lleva 11 (dos pasos, de 3 a 1).
+        {"Priority cuenta el envejecimiento desde que cada proceso está listo", PRIORITY,
+         {Proceso("P1", 12, 0, 1), Proceso("P2", 1, 1, 3), Proceso("P3", 1, 9, 2)},
+         "P1 [0, 12) P3 [12, 13) P2 [13, 14)",
+         "P1 [0, 12) P2 [12, 13) P3 [13, 14)"},
+        // El original da un solo paso por despacho: en t = 40 P3 y P4
+        // mejoran apenas a 5 y 4. En los motores ambos llegaron al piso
+        // (31 y 25 ciclos listos) y desempata la llegada.
+        {"Priority da un paso por cada intervalo completo, no uno por despacho", PRIORITY,
+         {Proceso("P1", 5, 0, 7), Proceso("P2", 35, 4, 10), Proceso("P3", 23, 9, 6), Proceso("P4", 4, 15, 5)},
+         "P1 [0, 5) P2 [5, 40) P4 [40, 44) P3 [44, 67)",
+         "P1 [0, 5) P2 [5, 40) P3 [40, 63) P4 [63, 67)"},
+    };
+}
+
+std::string verificarDiferenciasEsperadas() {
+    for (const auto& d : diferenciasEsperadas()) {
+        Caso c;
+        c.carga = d.carga;
+        std::string original = describirTramos(CalendarizadorOriginal(c.carga, c.quantum).ejecutar(d.tipo).eventos);
+        std::string motor = describirTramos(normalizarEventos(correrMotor(MOTOR_COMPLETO, d.tipo, c).eventos));
+        if (original != d.original || motor != d.motor) {
+            return std::string(d.descripcion) + ": original " + original + " (se esperaba " + d.original +
+                   "), motor " + motor + " (se esperaba " + d.motor + ")";
+        }
+    }
+    return "";
+}
+
+// ------------------------------------------------------------
+// Memoria de las corridas
+// ------------------------------------------------------------
+
+// La arena de un simulador (arena.h) no libera nada hasta la próxima
+// corrida, así que una cola que reserve memoria en cada despacho la haría
+// crecer con el largo de la corrida. Cargas con muchos despachos (Round
+// Robin con quantum 1, o dos grupos que se turnan la CPU) deben quedarse
+// en un tamaño que solo depende de los procesos activos.
+const size_t LIMITE_MEMORIA_CORRIDA = 256 * 1024;
+
+std::string memoriaAcotada(TipoAlgoritmo tipo, bool conGrupos) {
+    std::vector<Proceso> carga;
+    for (int i = 0; i < 100; ++i) {
+        carga.push_back(Proceso("P" + std::to_string(i + 1), 20000, i % 7, 1 + i % 4));
+        if (conGrupos) carga.back().grupo = i % 2 ? "a" : "b";
+    }
+    SimuladorCalendarizacion s;
+    s.setQuantum(1);
+    s.setRetenerEventos(false);
+    s.cargarProcesos(carga);
+    for (int corrida = 0; corrida < 2; ++corrida) {
+        s.ejecutar(tipo);
+    }
+    if (s.getMemoriaCorrida() > LIMITE_MEMORIA_CORRIDA) {
+        return "la arena creció a " + std::to_string(s.getMemoriaCorrida()) + " bytes (límite " +
+               std::to_string(LIMITE_MEMORIA_CORRIDA) + ")";
+    }
+    return "";
+}
+
+// ------------------------------------------------------------
+// Intervalos de confianza
+// ------------------------------------------------------------
+
+// Valores críticos de experimentos.h frente a cuantiles normales
+// conocidos (con muchos grados de libertad la t coincide con la normal),
+// y rechazo de niveles fuera de (0, 1)
+std::string valoresCriticos() {
+    const std::pair<double, double> conocidos[] = {
+        {0.50, 0.6745}, {0.80, 1.2816}, {0.90, 1.6449}, {0.95, 1.9600}, {0.99, 2.5758}, {0.999, 3.2905}};
+    for (const auto& c : conocidos) {
+        double v = valorCritico(c.first, 1000000000LL);
+        if (std::abs(v - c.second) > 1e-4) {
+            return "nivel " + std::to_string(c.first) + ": " + std::to_string(v) + " en lugar de " +
+                   std::to_string(c.second);
+        }
+    }
+    // t con 9 grados de libertad al 95 %: 2.2622 (la aproximación queda a menos de 0.01)
+    if (std::abs(valorCritico(0.95, 9) - 2.2622) > 0.01) {
+        return "t(9) al 95%: " + std::to_string(valorCritico(0.95, 9));
+    }
+    for (double invalido : {0.0, 1.0, 1.5, -0.2}) {
+        try {
+            valorCritico(invalido, 100);
+            return "se aceptó el nivel " + std::to_string(invalido);
+        } catch (const std::runtime_error&) {
+        }
+    }
+    return "";
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    try {
+        Opciones op = parsearOpciones(argc, argv);
+
+        // Repetir un caso guardado
+        if (!op.cargaFile.empty()) {
+            Caso c = op.replica;
+            c.carga = leerCarga(op.cargaFile);
+            if (!op.dispositivosFile.empty()) {
+                c.dispositivos = leerDispositivos(op.dispositivosFile);
+            }
+            bool iguales = true;
+            for (TipoAlgoritmo tipo : op.algoritmos) {
+                for (Motor motor : op.motores) {
+                    std::string d = comparar(motor, tipo, c);
+                    std::cout << nombreAlgoritmo(tipo) << " (" << nombreMotor(motor) << "): "
+                              << (d.empty() ? "igual a la referencia" : d) << "\n";
+                    iguales = iguales && d.empty();
+                }
+            }
+            return iguales ? 0 : 1;
+        }
+
+        GeneradorAleatorio rng(op.semilla);
+        for (long long k = 0; k < op.casos; ++k) {
+            Caso c = generarCaso(rng, op.maxProcesos, op.conES);
+            for (TipoAlgoritmo tipo : op.algoritmos) {
+                for (Motor motor : op.motores) {
+                    if (comparar(motor, tipo, c).empty()) continue;
+                    std::cout << "Caso " << k << " de la semilla " << op.semilla << " diverge; reduciendo...\n";
+                    reportar(op, motor, tipo, reducir(c, motor, tipo));
+                    return 1;
+                }
+            }
+        }
+        std::cout << op.casos << " casos x " << op.algoritmos.size() << " algoritmos x "
+                  << op.motores.size() << " motores: sin diferencias con la referencia\n";
+
+        std::vector<TipoAlgoritmo> sinCambios;
+        for (TipoAlgoritmo tipo : op.algoritmos) {
+            if (tipo != PRIORITY) sinCambios.push_back(tipo);
+        }
+        GeneradorAleatorio rngOriginal(op.semilla);
+        for (long long k = 0; k < op.casos; ++k) {
+            Caso c = generarCasoSinEmpates(rngOriginal, op.maxProcesos);
+            for (TipoAlgoritmo tipo : sinCambios) {
+                std::string d = compararConOriginal(tipo, c);
+                if (d.empty()) continue;
+                std::cout << "Diferencia con el original en " << nombreAlgoritmo(tipo) << " (caso " << k
+                          << ", quantum " << c.quantum << "): " << d << "\n";
+                escribirCarga(std::cout, c.carga);
+                return 1;
+            }
+        }
+        std::cout << op.casos << " casos sin empates x " << sinCambios.size()
+                  << " algoritmos: iguales al simulador original\n";
+
+        std::string esperadas = verificarDiferenciasEsperadas();
+        if (!esperadas.empty()) {
+            std::cout << "Diferencia esperada con el original: " << esperadas << "\n";
+            return 1;
+        }
+        std::cout << "Diferencias a propósito con el original: " << diferenciasEsperadas().size()
+                  << " casos comprobados\n";
+
+        for (TipoAlgoritmo tipo : op.algoritmos) {
+            for (bool conGrupos : {false, true}) {
+                std::string d = memoriaAcotada(tipo, conGrupos);
+                if (!d.empty()) {
+                    std::cout << "Memoria de " << nombreAlgoritmo(tipo) << (conGrupos ? " con grupos" : "")
+                              << ": " << d << "\n";
+                    return 1;
+                }
+            }
+        }
+        std::cout << "Memoria por corrida acotada en " << op.algoritmos.size() << " algoritmos\n";
+
+        std::string d = valoresCriticos();
+        if (!d.empty()) {
+            std::cout << "Valores críticos: " << d << "\n";
+            return 1;
+        }
+        std::cout << "Valores críticos de los intervalos de confianza correctos\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
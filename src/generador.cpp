@@ -0,0 +1,188 @@
+// generador.cpp
+// Generador de cargas de trabajo sintéticas en el formato de data/
+// (procesos.txt, recursos.txt y acciones.txt). Genera por bloques en
+// paralelo; la salida depende solo de la semilla y de la especificación,
+// no del número de hilos.
+
+#include <atomic>
+#include <charconv>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "generador_cargas.h"
+
+// ------------------------------------------------------------
+// Helper Functions
+// ------------------------------------------------------------
+
+void mostrarAyuda() {
+    std::cout <<
+        "Uso: generador [opciones]\n"
+        "  --procesos <n>         Número de procesos (por defecto 1000)\n"
+        "  --semilla <s>          Semilla (por defecto 1)\n"
+        "  --llegadas <dist>      Separación entre llegadas (por defecto exponencial:4)\n"
+        "  --rafagas <dist>       Burst time (por defecto uniforme:1:20)\n"
+        "  --prioridades <mezcla> Pesos por prioridad, p. ej. 1:1,2:3,3:1\n"
+        "  --recursos <n>         Número de recursos (por defecto 4)\n"
+        "  --contador-max <n>     Contador máximo de los semáforos (por defecto 3)\n"
+        "  --densidad <d>         Acciones por ciclo de CPU (por defecto 0.1)\n"
+        "  --bloque <n>           Procesos por bloque (por defecto 65536)\n"
+        "  --hilos <n>            Hilos de generación (por defecto, todos los núcleos)\n"
+        "  --salida <directorio>  Directorio de salida (obligatorio; los archivos que\n"
+        "                         ya existan ahí se sobrescriben)\n"
+        "Distribuciones: fija:v, uniforme:a:b, exponencial:media, bimodal:a:b:p\n";
+}
+
+// Ejecuta tarea(i) para i en [0, n) repartiendo el trabajo entre hilos
+template <class F>
+void paraCadaEnParalelo(size_t n, unsigned hilos, F tarea) {
+    std::atomic<size_t> siguiente(0);
+    auto trabajador = [&]() {
+        for (size_t i = siguiente++; i < n; i = siguiente++) {
+            tarea(i);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned h = 1; h < hilos && h < n; ++h) {
+        pool.emplace_back(trabajador);
+    }
+    trabajador();
+    for (auto& t : pool) t.join();
+}
+
+void agregarEntero(std::string& s, long long v) {
+    char buf[24];
+    auto r = std::to_chars(buf, buf + sizeof(buf), v);
+    s.append(buf, r.ptr);
+}
+
+// Convertir un bloque a las líneas de procesos.txt y acciones.txt
+void formatearBloque(const EspecificacionCarga& spec, const BloqueCarga& b, long long desplazamiento,
+                     std::string& procesos, std::string& acciones) {
+    procesos.reserve(b.rafaga.size() * 24);
+    acciones.reserve(b.cicloAccion.size() * 32);
+    std::vector<std::string> nombres;
+    for (int r = 0; r < spec.recursos; ++r) {
+        nombres.push_back(nombreRecurso(spec, r));
+    }
+
+    for (size_t i = 0; i < b.rafaga.size(); ++i) {
+        std::string pid = "P";
+        agregarEntero(pid, b.primerIndice + static_cast<long long>(i) + 1);
+
+        // <PID>, <BT>, <AT>, <Priority>
+        procesos += pid;
+        procesos += ", ";
+        agregarEntero(procesos, b.rafaga[i]);
+        procesos += ", ";
+        agregarEntero(procesos, desplazamiento + b.llegadaRelativa[i]);
+        procesos += ", ";
+        agregarEntero(procesos, b.prioridad[i]);
+        procesos += '\n';
+
+        // <PID>, <ACCION>, <RECURSO>, <CICLO>
+        for (long long k = b.inicioAcciones[i]; k < b.inicioAcciones[i + 1]; ++k) {
+            acciones += pid;
+            acciones += b.escrituraAccion[k] ? ", WRITE, " : ", READ, ";
+            acciones += nombres[b.recursoAccion[k]];
+            acciones += ", ";
+            agregarEntero(acciones, b.cicloAccion[k]);
+            acciones += '\n';
+        }
+    }
+}
+
+std::ofstream abrirSalida(const std::string& ruta) {
+    std::ofstream out(ruta, std::ios::binary);
+    if (!out.is_open()) {
+        throw std::runtime_error("No se pudo crear el archivo: " + ruta);
+    }
+    return out;
+}
+
+// ------------------------------------------------------------
+// Main
+// ------------------------------------------------------------
+
+int main(int argc, char* argv[]) {
+    try {
+        EspecificacionCarga spec;
+        uint64_t semilla = 1;
+        unsigned hilos = std::max(1u, std::thread::hardware_concurrency());
+        std::string salida;     // Obligatoria: data/ trae los ejemplos del repositorio
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto valor = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("Falta el valor de " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (aplicarOpcionCarga(spec, arg, valor)) continue;
+
+            if (arg == "--procesos") spec.procesos = std::stoll(valor());
+            else if (arg == "--semilla") semilla = std::stoull(valor());
+            else if (arg == "--hilos") hilos = std::max(1, std::stoi(valor()));
+            else if (arg == "--salida") salida = valor();
+            else if (arg == "--ayuda" || arg == "-h" || arg == "--help") {
+                mostrarAyuda();
+                return 0;
+            } else {
+                throw std::runtime_error("Opción desconocida: " + arg);
+            }
+        }
+
+        if (salida.empty()) {
+            throw std::runtime_error("Falta --salida <directorio> (p. ej. --salida data para reemplazar los ejemplos)");
+        }
+
+        std::ofstream recursosOut = abrirSalida(salida + "/recursos.txt");
+        for (int r = 0; r < spec.recursos; ++r) {
+            recursosOut << nombreRecurso(spec, r) << ", " << contadorRecurso(spec, r) << "\n";
+        }
+
+        std::ofstream procesosOut = abrirSalida(salida + "/procesos.txt");
+        std::ofstream accionesOut = abrirSalida(salida + "/acciones.txt");
+
+        // Se procesa por oleadas de "hilos" bloques para acotar la memoria:
+        // generar en paralelo, fijar desplazamientos en orden, formatear en
+        // paralelo y escribir en orden
+        long long totalBloques = numeroBloques(spec);
+        long long desplazamiento = 0;
+        for (long long primero = 0; primero < totalBloques; primero += hilos) {
+            size_t cantidad = static_cast<size_t>(std::min<long long>(hilos, totalBloques - primero));
+            std::vector<BloqueCarga> bloques(cantidad);
+            std::vector<long long> desplazamientos(cantidad);
+            std::vector<std::string> textoProcesos(cantidad), textoAcciones(cantidad);
+
+            paraCadaEnParalelo(cantidad, hilos, [&](size_t i) {
+                bloques[i] = generarBloque(spec, semilla, primero + static_cast<long long>(i));
+            });
+            for (size_t i = 0; i < cantidad; ++i) {
+                desplazamientos[i] = desplazamiento;
+                desplazamiento += bloques[i].duracion;
+            }
+            paraCadaEnParalelo(cantidad, hilos, [&](size_t i) {
+                formatearBloque(spec, bloques[i], desplazamientos[i], textoProcesos[i], textoAcciones[i]);
+            });
+            for (size_t i = 0; i < cantidad; ++i) {
+                procesosOut.write(textoProcesos[i].data(), textoProcesos[i].size());
+                accionesOut.write(textoAcciones[i].data(), textoAcciones[i].size());
+            }
+        }
+
+        if (!procesosOut || !accionesOut || !recursosOut) {
+            throw std::runtime_error("Error al escribir en " + salida);
+        }
+        std::cout << "Generados " << spec.procesos << " procesos en " << salida << "/\n";
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -6,13 +6,16 @@
 #include <imgui.h>
 #include <imgui-SFML.h>
 #include <filesystem>
-#include <unordered_map>
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cfloat>
+#include <algorithm>
 #include "parser.h"
 #include "simulador_calendarizacion.h"
 #include "simulador_sincronizacion.h"
+#include "linea_tiempo.h"
+#include "cliente_eventos.h"
 
 // ------------------------------------------------------------
 // Helper Functions
@@ -28,9 +31,26 @@ ImU32 ColorFromPID(const std::string& pid) {
     return IM_COL32(r, g, b, 255);
 }
 
-// Convierte ciclos en coordenadas X en pantalla
-float CycleToX(int ciclo, float pixelsPerCycle) {
-    return static_cast<float>(ciclo) * pixelsPerCycle;
+// Color de ImGui a color de SFML
+sf::Color ColorSFML(ImU32 c) {
+    return sf::Color(static_cast<uint8_t>(c & 0xFF), static_cast<uint8_t>((c >> 8) & 0xFF),
+                     static_cast<uint8_t>((c >> 16) & 0xFF), static_cast<uint8_t>((c >> 24) & 0xFF));
+}
+
+// Agrega un rectángulo (dos triángulos) a un arreglo de vértices
+void AgregarRectangulo(sf::VertexArray& v, float x0, float y0, float x1, float y1, sf::Color color) {
+    v.append(sf::Vertex(sf::Vector2f(x0, y0), color));
+    v.append(sf::Vertex(sf::Vector2f(x1, y0), color));
+    v.append(sf::Vertex(sf::Vector2f(x1, y1), color));
+    v.append(sf::Vertex(sf::Vector2f(x0, y0), color));
+    v.append(sf::Vertex(sf::Vector2f(x1, y1), color));
+    v.append(sf::Vertex(sf::Vector2f(x0, y1), color));
+}
+
+// Convierte una posición del eje (ciclos con los huecos comprimidos, ver
+// EjeTiempo) en coordenadas X en pantalla
+float CycleToX(double posicion, float pixelsPerCycle) {
+    return static_cast<float>(posicion * pixelsPerCycle);
 }
 
 // ------------------------------------------------------------
@@ -39,7 +59,8 @@ float CycleToX(int ciclo, float pixelsPerCycle) {
 
 enum class SimulationType {
     Calendarizacion,
-    Sincronizacion
+    Sincronizacion,
+    Remota          // Eventos de un simulador_cli --servir
 };
 
 enum class SyncMode {
@@ -47,6 +68,31 @@ enum class SyncMode {
     Semaforo
 };
 
+// Texto del Gantt, en coordenadas de la parte visible del diagrama
+struct EtiquetaGantt {
+    ImVec2 posicion;
+    ImU32 color;
+    std::string texto;
+};
+
+// Lo que determina el contenido de la caché del Gantt: si nada de esto
+// cambia, las texturas del cuadro anterior siguen siendo válidas
+struct ClaveGantt {
+    unsigned long version = 0;   // Cambia con cada vista nueva
+    float pixelsPerCycle = 0.0f;
+    float scrollX = -1.0f;
+    float scrollY = -1.0f;
+    unsigned ancho = 0;
+    unsigned alto = 0;
+
+    bool operator==(const ClaveGantt& o) const {
+        return version == o.version && pixelsPerCycle == o.pixelsPerCycle &&
+               scrollX == o.scrollX && scrollY == o.scrollY &&
+               ancho == o.ancho && alto == o.alto;
+    }
+    bool operator!=(const ClaveGantt& o) const { return !(*this == o); }
+};
+
 // ------------------------------------------------------------
 // Main
 // ------------------------------------------------------------
@@ -57,12 +103,22 @@ int main() {
     window.setFramerateLimit(60);
     ImGui::SFML::Init(window);
 
+    // Sin animación ni entrada la interfaz no cambia: el ciclo principal
+    // espera eventos en lugar de redibujar. Tras cada entrada se dibujan
+    // CUADROS_TRAS_ENTRADA cuadros para que ImGui asiente hover y foco.
+    const int CUADROS_TRAS_ENTRADA = 3;
+    const int ESPERA_REMOTA_MS = 20;       // Revisión de la ventana mientras llega la simulación remota
+    int cuadrosPendientes = CUADROS_TRAS_ENTRADA;
+
     // Variables de GUI
     SimulationType simType = SimulationType::Calendarizacion;
     SyncMode syncMode = SyncMode::Mutex;
 
     // Archivos de entrada (por defecto dentro de data/)
     char procesosFile[256]    = "data/procesos.txt";
+    char dispositivosFile[256] = "";   // Opcional: dispositivos de E/S
+    char gruposFile[256]      = "";    // Opcional: grupos del reparto justo
+    char dvfsFile[256]        = "";    // Opcional: modelo DVFS (vacío: el incorporado)
     char recursosFile[256]    = "data/recursos.txt";
     char accionesFile[256]    = "data/acciones.txt";
 
@@ -74,36 +130,213 @@ int main() {
     bool algoPRIO   = false;
     int  quantum    = 2;  // Valor por defecto
 
-    // Contenedor de procesos, recursos y acciones
-    std::vector<Proceso> procesos;
+    // Gobernador DVFS (0 = sin DVFS; si no, TipoGobernador + 1)
+    int  gobernador = 0;
+
+    // Protocolo contra la inversión de prioridad (índice de ProtocoloRecursos)
+    int  protocolo  = PROTOCOLO_NINGUNO;
+
+    // Entrega de los recursos sin política propia (0 = irrumpir, 1 = fifo,
+    // 2 = girar, 3 = lote; es PoliticaEntrega - 1), su parámetro y el
+    // costo de despertar en ciclos
+    int  entrega           = 0;
+    int  parametroEntrega  = 2;
+    int  costoDespertar    = 0;
+
+    // Carga de procesos (compartida, de solo lectura), dispositivos de
+    // E/S, grupos, modelo DVFS, recursos y acciones
+    CargaCompartida carga;
+    std::vector<Dispositivo> dispositivos;
+    std::vector<Grupo> grupos;
+    ModeloDVFS modeloDVFS;
     std::vector<Recurso> recursos;
     std::vector<Accion> acciones;
 
-    // Instancias de simuladores
-    SimuladorCalendarizacion simuladorCal;
+    // Instancias de simuladores: uno por algoritmo, con puntos de control,
+    // para que cambiar el quantum no repita la corrida desde el inicio
+    SimuladorCalendarizacion simuladoresCal[5];
+    for (auto& s : simuladoresCal) {
+        s.setPuntosControl(64);
+        s.setAlmacenEventos(true);
+    }
     SimuladorSincronizacion simuladorSync;
+    simuladorSync.setAlmacenEventos(true);
+
+    // Un resultado por algoritmo ejecutado (métricas y el almacén con sus
+    // eventos) y el índice de su línea de tiempo para saltar a cualquier
+    // ciclo; el Gantt y el estado por ciclo leen los eventos del almacén
+    std::vector<ResultadoSimulacion> resultados;
+    std::vector<LineaTiempo> lineas;
+
+    // Histograma del tiempo de espera de cada resultado (para PlotHistogram)
+    const size_t CUBETAS_HISTOGRAMA = 20;
+    std::vector<std::vector<float>> histogramasEspera;
 
-    // Eventos de Gantt resultantes
-    std::vector<EventoGantt> eventosGantt;
+    // Instrumentación acumulada de la última simulación
+    Estadisticas estadisticas;
 
-    // Métricas (tras simulación)
-    float avgWaitingTime    = 0.0f;
-    float avgCompletionTime = 0.0f;
-    float avgResponseTime   = 0.0f;
+    // Contención por recurso de la última simulación de sincronización,
+    // en el orden de la tabla, y el recurso cuyo detalle se muestra
+    std::vector<PerfilRecurso> perfilesRecursos;
+    int recursoSeleccionado = 0;
+    bool reordenarRecursos = false;
 
     // Estados de animación
     bool datosCargados      = false;
     bool simulacionListo    = false;
     bool corriendo           = false;
     float velocidad          = 1.0f;       // Factor de velocidad (1.0 = normal)
-    float tiempoSimulacion   = 0.0f;       // Tiempo acumulado en segundos
-    int   currentCycle       = 0;          // Ciclo actual de la animación
-    int   maxCycle           = 0;          // Ciclo máximo de la simulación
+    double tiempoSimulacion  = 0.0;        // Tiempo acumulado en segundos
+    Tiempo currentCycle      = 0;          // Ciclo actual de la animación
+    Tiempo maxCycle          = 0;          // Ciclo máximo de la simulación
+    int   direccion          = 1;          // 1 hacia adelante, -1 en reversa
+    Tiempo cicloDestino      = 0;          // Ciclo del campo "Ir a"
+    bool  centrarCursor      = false;      // Desplazar el Gantt hasta el cursor
+    int   resultadoEstado    = 0;          // Resultado mostrado en la tabla de estado
     const float segundosPorCiclo = 0.1f;   // 0.1 seg = 1 ciclo (ajustable)
     float pixelsPerCycle     = 20.0f;      // Zoom horizontal (20 pixeles = 1 ciclo)
+    const float rowHeight    = 24.0f;      // Alto de cada fila del Gantt
+    const float labelWidth   = 60.0f;      // Columna de las etiquetas de fila
+
+    // Eje del Gantt: los huecos sin eventos de más de UMBRAL_HUECO ciclos
+    // se dibujan con ANCHO_HUECO ciclos de ancho
+    const Tiempo UMBRAL_HUECO = 50;
+    const Tiempo ANCHO_HUECO  = 3;
+    EjeTiempo eje;
+
+    // Simulación remota: se procesan como máximo MENSAJES_POR_CUADRO
+    // mensajes por cuadro (el resto espera en el servidor) y la vista se
+    // rehace a lo sumo cada SEGUNDOS_ENTRE_VISTAS
+    char socketFile[256] = "/tmp/simulador.sock";
+    ClienteEventos cliente;
+    Tiempo ventanaDesde = 0;
+    Tiempo ventanaHasta = TIEMPO_MAXIMO;
+    bool seguirRemota = true;                   // Cursor al final de lo recibido
+    const size_t MENSAJES_POR_CUADRO = 20000;
+    const float SEGUNDOS_ENTRE_VISTAS = 0.25f;
+    sf::Clock relojVista;
+
+    // Caché del Gantt: la parte visible se dibuja en dos texturas, el
+    // fondo (filas y huecos) y las barras, que solo se rehacen cuando
+    // cambia la clave. Cada cuadro las muestra y recorta las barras y
+    // sus etiquetas en el cursor.
+    sf::RenderTexture lienzoFondo;
+    sf::RenderTexture lienzoBarras;
+    std::vector<EtiquetaGantt> etiquetasFondo;   // PIDs y duración de los huecos
+    std::vector<EtiquetaGantt> etiquetasBarras;  // Ciclo de inicio de cada barra
+    ClaveGantt claveGantt;
+    unsigned long versionVista = 0;
+
+    // Preparar la vista de "resultados": ciclo máximo, índices de la
+    // línea de tiempo, histogramas y eje del Gantt
+    auto prepararVista = [&]() {
+        // Índices de la línea de tiempo (se rehacen cada vez que cambia
+        // "resultados") y ciclo máximo
+        lineas.clear();
+        histogramasEspera.clear();
+        lineas.reserve(resultados.size());
+        maxCycle = 0;
+        for (const auto& r : resultados) {
+            lineas.emplace_back(r);
+            maxCycle = std::max(maxCycle, lineas.back().getFin());
+
+            std::vector<long long> cubetas = histogramaColumna(r.espera, r.resumenEspera, CUBETAS_HISTOGRAMA);
+            histogramasEspera.emplace_back(cubetas.begin(), cubetas.end());
+        }
+        resultadoEstado = std::min<int>(resultadoEstado, static_cast<int>(resultados.size()) - 1);
+        resultadoEstado = std::max(resultadoEstado, 0);
+
+        eje.construir(lineas, UMBRAL_HUECO, ANCHO_HUECO);
+        versionVista++;
+    };
+
+    // Dibujar en la caché la parte visible del Gantt: la que empieza en
+    // (scrollX, scrollY) del contenido y mide ancho x alto pixeles
+    auto dibujarGantt = [&](const ClaveGantt& clave) {
+        if (lienzoFondo.getSize().x != clave.ancho || lienzoFondo.getSize().y != clave.alto) {
+            lienzoFondo.create(clave.ancho, clave.alto);
+            lienzoBarras.create(clave.ancho, clave.alto);
+        }
+        etiquetasFondo.clear();
+        etiquetasBarras.clear();
+        float scrollX = clave.scrollX;
+        float scrollY = clave.scrollY;
+        float ppc = clave.pixelsPerCycle;
+
+        size_t numProcesos = carga->size();
+        size_t numFilas = resultados.size() * numProcesos;
+        float contentHeight = (static_cast<float>(numFilas) * rowHeight) + 30.0f;
+        float contentWidth = CycleToX(eje.aEje(maxCycle + 1), ppc) + labelWidth + 50.0f;
+
+        // Solo las filas y los ciclos que caben en la vista
+        size_t primeraFila = static_cast<size_t>(std::max(0.0f, scrollY / rowHeight - 1));
+        size_t ultimaFila = std::min(numFilas, static_cast<size_t>((scrollY + clave.alto) / rowHeight) + 2);
+        Tiempo primerCiclo = std::max<Tiempo>(0, eje.aTiempo((scrollX - labelWidth) / ppc) - 1);
+        Tiempo ultimoCiclo = eje.aTiempo((scrollX + clave.ancho) / ppc) + 1;
+
+        // Fondo: líneas horizontales por fila y huecos comprimidos
+        sf::VertexArray fondo(sf::Triangles);
+        for (size_t i = primeraFila; i < ultimaFila; ++i) {
+            float y = 5 + i * rowHeight - scrollY;
+            const ResultadoSimulacion& r = resultados[i / numProcesos];
+            std::string etiqueta = (*carga)[i % numProcesos].pid;
+            if (simType != SimulationType::Sincronizacion) {
+                etiqueta += std::string("|") + nombreAlgoritmo(r.algoritmo);
+            }
+            AgregarRectangulo(fondo, labelWidth - scrollX, y - 0.5f, contentWidth - scrollX, y + 0.5f,
+                              sf::Color(70, 70, 70, 255));
+            // Etiqueta de PID
+            etiquetasFondo.push_back({ImVec2(2 - scrollX, y - (rowHeight / 2) + 6),
+                                      IM_COL32(200, 200, 200, 255), etiqueta});
+        }
+        // Marcar los huecos comprimidos con su duración real
+        for (const auto& h : eje.getHuecos()) {
+            if (h.fin < primerCiclo || h.inicio > ultimoCiclo) continue;
+            float hx0 = labelWidth + CycleToX(h.eje, ppc) - scrollX;
+            float hx1 = labelWidth + CycleToX(h.eje + eje.getAnchoHueco(), ppc) - scrollX;
+            AgregarRectangulo(fondo, hx0, -scrollY, hx1, contentHeight - scrollY, sf::Color(60, 60, 90, 120));
+            etiquetasFondo.push_back({ImVec2(hx0 + 2, contentHeight - 14 - scrollY),
+                                      IM_COL32(160, 160, 220, 255), "+" + std::to_string(h.fin - h.inicio)});
+        }
 
-    // Mapear PID a índice de fila (para dibujar cada proceso en su propia fila)
-    std::unordered_map<std::string, int> pidToRow;
+        // Barras de todos los eventos visibles (el índice del almacén lee
+        // solo los bloques que los contienen); el cursor las recorta al
+        // mostrarlas. El proceso de cada registro es su fila en la carga
+        sf::VertexArray barras(sf::Triangles);
+        for (size_t r = 0; r < resultados.size(); ++r) {
+          lineas[r].recorrerEn(primerCiclo, ultimoCiclo, [&](const RegistroEvento& e) {
+            if (static_cast<size_t>(e.proceso) >= numProcesos) return;
+            size_t fila = r * numProcesos + e.proceso;
+            if (fila < primeraFila || fila >= ultimaFila) return;
+            float y = 5 + fila * rowHeight - scrollY;
+            float x0 = labelWidth + CycleToX(eje.aEje(e.inicio), ppc) - scrollX;
+            float x1 = labelWidth + CycleToX(eje.aEje(e.fin), ppc) - scrollX;
+
+            ImU32 col;
+            if (e.estado == EVENTO_WAITING) {
+                col = IM_COL32(200, 50, 50, 200);
+            } else if (e.estado == EVENTO_ACCESSED) {
+                col = IM_COL32(50, 200, 50, 200);
+            } else if (e.estado == EVENTO_OVERHEAD) {
+                col = IM_COL32(230, 150, 40, 200);
+            } else if (e.estado == EVENTO_IO) {
+                col = IM_COL32(90, 140, 220, 200);
+            } else {
+                col = ColorFromPID((*carga)[e.proceso].pid);
+            }
+
+            AgregarRectangulo(barras, x0, y - (rowHeight / 2) + 4, x1, y + (rowHeight / 2) - 4, ColorSFML(col));
+            etiquetasBarras.push_back({ImVec2(x0 + 2, y - 5), IM_COL32(0, 0, 0, 255), std::to_string(e.inicio)});
+          });
+        }
+
+        lienzoFondo.clear(sf::Color::Transparent);
+        lienzoFondo.draw(fondo);
+        lienzoFondo.display();
+        lienzoBarras.clear(sf::Color::Transparent);
+        lienzoBarras.draw(barras);
+        lienzoBarras.display();
+    };
 
     // Temporizador SFML para ImGui-SFML
     sf::Clock deltaClock;
@@ -111,16 +344,64 @@ int main() {
     while (window.isOpen()) {
         // 1) Procesar eventos SFML
         sf::Event event;
-        while (window.pollEvent(event)) {
+        auto procesarEvento = [&]() {
             ImGui::SFML::ProcessEvent(event);
             if (event.type == sf::Event::Closed) {
                 window.close();
             }
+            cuadrosPendientes = CUADROS_TRAS_ENTRADA;
+        };
+
+        // Sin nada que animar, esperar la próxima entrada. Con una
+        // simulación remota en curso se despierta también cuando llegan
+        // datos del servidor.
+        bool remotaPendiente = simType == SimulationType::Remota &&
+                               (cliente.hayCambios() || cliente.quedanMensajes());
+        if (!corriendo && cuadrosPendientes == 0 && !remotaPendiente) {
+            if (simType == SimulationType::Remota && cliente.conectado()) {
+                bool hayEvento = false;
+                while (!(hayEvento = window.pollEvent(event)) && !cliente.esperar(ESPERA_REMOTA_MS)) {}
+                if (hayEvento) procesarEvento();
+            } else if (window.waitEvent(event)) {
+                procesarEvento();
+            }
+        }
+        while (window.pollEvent(event)) {
+            procesarEvento();
         }
+        if (!window.isOpen()) break;
+        if (cuadrosPendientes > 0) cuadrosPendientes--;
 
         // 2) Actualizar ImGui-SFML
         ImGui::SFML::Update(window, deltaClock.restart());
 
+        // Mensajes de la simulación remota. La vista se rehace con lo
+        // recibido hasta ahora; cada cuadro procesa una cantidad acotada,
+        // así que un servidor rápido espera en lugar de frenar la interfaz
+        if (simType == SimulationType::Remota) {
+            cliente.recibir(MENSAJES_POR_CUADRO);
+            bool pendiente = cliente.conectado() && !cliente.terminado();
+            if (cliente.hayCambios() &&
+                (!pendiente || relojVista.getElapsedTime().asSeconds() >= SEGUNDOS_ENTRE_VISTAS)) {
+                relojVista.restart();
+                std::vector<ResultadoSimulacion> recibidos = cliente.armarResultados();
+                if (!recibidos.empty()) {
+                    resultados = std::move(recibidos);
+                    carga = resultados.front().carga;
+                    prepararVista();
+                    if (seguirRemota) {
+                        currentCycle = maxCycle;
+                        tiempoSimulacion = eje.aEje(currentCycle) * segundosPorCiclo;
+                        centrarCursor = true;
+                    } else {
+                        currentCycle = std::min(currentCycle, maxCycle);
+                    }
+                    datosCargados = true;
+                    simulacionListo = true;
+                }
+            }
+        }
+
         // ----------------------------------------
         // 3) VENTANA DE CONTROLES (25% DERECHO)
         // ----------------------------------------
@@ -146,6 +427,13 @@ int main() {
             simulacionListo = false;
             corriendo = false;
         }
+        ImGui::SameLine();
+        if (ImGui::RadioButton("Remota", simType == SimulationType::Remota)) {
+            simType = SimulationType::Remota;
+            datosCargados = false;
+            simulacionListo = false;
+            corriendo = false;
+        }
 
         ImGui::Separator();
 
@@ -163,9 +451,14 @@ int main() {
                 ImGui::SameLine();
                 ImGui::PushItemWidth(50);
                 ImGui::SliderInt("##quantum_rr", &quantum, 1, 10);
+                quantum = std::max(1, quantum);  // Ctrl+clic permite escribir cualquier valor
                 ImGui::PopItemWidth();
             }
             ImGui::Checkbox("Priority (Envejecimiento)", &algoPRIO);
+            const char* gobernadores[] = {"sin DVFS", nombreGobernador(GOBERNADOR_RENDIMIENTO),
+                                          nombreGobernador(GOBERNADOR_AHORRO),
+                                          nombreGobernador(GOBERNADOR_BAJO_DEMANDA)};
+            ImGui::Combo("Gobernador DVFS", &gobernador, gobernadores, IM_ARRAYSIZE(gobernadores));
 
             ImGui::Separator();
             // Archivo de procesos
@@ -174,6 +467,67 @@ int main() {
             ImGui::InputText("##procesosPath", procesosFile, IM_ARRAYSIZE(procesosFile));
             ImGui::PopItemWidth();
 
+            ImGui::Text("Archivo de Dispositivos (.txt, opcional):");
+            ImGui::PushItemWidth(-1);
+            ImGui::InputText("##dispositivosPath", dispositivosFile, IM_ARRAYSIZE(dispositivosFile));
+            ImGui::PopItemWidth();
+
+            ImGui::Text("Archivo de Grupos (.txt, opcional):");
+            ImGui::PushItemWidth(-1);
+            ImGui::InputText("##gruposPath", gruposFile, IM_ARRAYSIZE(gruposFile));
+            ImGui::PopItemWidth();
+
+            ImGui::Text("Archivo DVFS (.txt, opcional):");
+            ImGui::PushItemWidth(-1);
+            ImGui::InputText("##dvfsPath", dvfsFile, IM_ARRAYSIZE(dvfsFile));
+            ImGui::PopItemWidth();
+
+        } else if (simType == SimulationType::Remota) {
+            // Conexión a un simulador_cli --servir
+            ImGui::Text("Socket del simulador:");
+            ImGui::PushItemWidth(-1);
+            ImGui::InputText("##socketPath", socketFile, IM_ARRAYSIZE(socketFile));
+            ImGui::PopItemWidth();
+            if (!cliente.conectado()) {
+                if (ImGui::Button("Conectar")) {
+                    try {
+                        cliente.conectar(socketFile);
+                        cliente.suscribir(ventanaDesde, ventanaHasta);
+                        simulacionListo = false;
+                        corriendo = false;
+                        currentCycle = 0;
+                    } catch (const std::exception& e) {
+                        ImGui::OpenPopup("ErrorRemota");
+                    }
+                }
+            } else if (ImGui::Button("Desconectar")) {
+                cliente.desconectar();
+            }
+
+            // Ventana de tiempo suscrita (aplica a los eventos que se
+            // produzcan desde ahora)
+            ImGui::Text("Ventana [desde, hasta):");
+            ImGui::PushItemWidth(100);
+            ImGui::InputScalar("##ventanaDesde", ImGuiDataType_S64, &ventanaDesde);
+            ImGui::SameLine();
+            ImGui::InputScalar("##ventanaHasta", ImGuiDataType_S64, &ventanaHasta);
+            ImGui::PopItemWidth();
+            ImGui::SameLine();
+            if (ImGui::Button("Suscribir") && cliente.conectado()) {
+                cliente.suscribir(ventanaDesde, ventanaHasta);
+            }
+            ImGui::Checkbox("Seguir el final", &seguirRemota);
+            ImGui::Text("Mensajes: %lld (%s)", cliente.getMensajes(),
+                        cliente.terminado() ? "terminada" : cliente.conectado() ? "en curso" : "desconectado");
+
+            if (ImGui::BeginPopupModal("ErrorRemota", nullptr, ImGuiWindowFlags_AlwaysAutoResize)) {
+                ImGui::TextUnformatted("No se pudo conectar. ¿Está corriendo simulador_cli --servir?");
+                if (ImGui::Button("OK")) {
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::EndPopup();
+            }
+
         } else {
             // Simulador de Sincronización
             ImGui::Text("Modo de Sincronización:");
@@ -185,6 +539,18 @@ int main() {
             if (ImGui::RadioButton("Semáforo", syncMode == SyncMode::Semaforo)) {
                 syncMode = SyncMode::Semaforo;
             }
+            const char* protocolos[] = {nombreProtocolo(PROTOCOLO_NINGUNO),
+                                        nombreProtocolo(PROTOCOLO_HERENCIA),
+                                        nombreProtocolo(PROTOCOLO_TECHO)};
+            ImGui::Combo("Protocolo", &protocolo, protocolos, IM_ARRAYSIZE(protocolos));
+            const char* entregas[] = {nombreEntrega(ENTREGA_IRRUMPIR), nombreEntrega(ENTREGA_FIFO),
+                                      nombreEntrega(ENTREGA_GIRAR), nombreEntrega(ENTREGA_LOTE)};
+            ImGui::Combo("Entrega", &entrega, entregas, IM_ARRAYSIZE(entregas));
+            if (entrega + 1 == ENTREGA_GIRAR || entrega + 1 == ENTREGA_LOTE) {
+                ImGui::SliderInt(entrega + 1 == ENTREGA_GIRAR ? "Ciclos de giro" : "Tamaño del lote",
+                                 &parametroEntrega, 1, 10);
+            }
+            ImGui::SliderInt("Costo de despertar", &costoDespertar, 0, 10);
             ImGui::Separator();
             // Archivos de recursos y acciones
             ImGui::Text("Archivo de Procesos (.txt):");
@@ -206,10 +572,23 @@ int main() {
         ImGui::Separator();
 
         // Botón para cargar datos
-        if (ImGui::Button("Cargar Archivos")) {
+        if (simType != SimulationType::Remota && ImGui::Button("Cargar Archivos")) {
             try {
                 // Cargar procesos
-                procesos = Parser::cargarProcesos(procesosFile);
+                carga = compartirCarga(Parser::cargarProcesos(procesosFile));
+                dispositivos.clear();
+                if (simType == SimulationType::Calendarizacion && dispositivosFile[0] != '\0') {
+                    dispositivos = Parser::cargarDispositivos(dispositivosFile);
+                }
+                grupos.clear();
+                if (simType == SimulationType::Calendarizacion && gruposFile[0] != '\0') {
+                    grupos = Parser::cargarGrupos(gruposFile);
+                }
+                modeloDVFS = modeloDVFSPorDefecto();
+                if (simType == SimulationType::Calendarizacion && dvfsFile[0] != '\0') {
+                    modeloDVFS = Parser::cargarDVFS(dvfsFile);
+                    normalizarModelo(modeloDVFS);
+                }
 
                 if (simType == SimulationType::Sincronizacion) {
                     // Cargar recursos y acciones
@@ -252,12 +631,17 @@ int main() {
         ImGui::Separator();
 
         // Mostrar información cargada para revisión
-        if (datosCargados) {
+        if (datosCargados && simType != SimulationType::Remota) {
             ImGui::Text("Información Cargada:");
             ImGui::Text("Procesos:");
             ImGui::BeginChild("##listaProcesos", ImVec2(0, 80), true);
-            for (const auto& p : procesos) {
-                ImGui::Text("- %s (BT=%d, AT=%d, PRIO=%d)", p.pid.c_str(), p.burstTime, p.arrivalTime, p.priority);
+            for (const auto& p : *carga) {
+                if (p.tieneES()) {
+                    ImGui::Text("- %s (BT=%lld, AT=%lld, PRIO=%d, %zu ráfagas de E/S)", p.pid.c_str(), p.burstTime,
+                                p.arrivalTime, p.priority, p.rafagasES.size());
+                } else {
+                    ImGui::Text("- %s (BT=%lld, AT=%lld, PRIO=%d)", p.pid.c_str(), p.burstTime, p.arrivalTime, p.priority);
+                }
             }
             ImGui::EndChild();
 
@@ -265,14 +649,14 @@ int main() {
                 ImGui::Text("Recursos:");
                 ImGui::BeginChild("##listaRecursos", ImVec2(0, 60), true);
                 for (const auto& r : recursos) {
-                    ImGui::Text("- %s (Cnt=%d)", r.nombre.c_str(), r.contadorOriginal);
+                    ImGui::Text("- %s (Cnt=%d, %s)", r.nombre.c_str(), r.contadorOriginal, nombreEntrega(r.entrega));
                 }
                 ImGui::EndChild();
 
                 ImGui::Text("Acciones:");
                 ImGui::BeginChild("##listaAcciones", ImVec2(0, 80), true);
                 for (const auto& a : acciones) {
-                    ImGui::Text("- %s %s %s en ciclo %d", a.pid.c_str(), a.tipo.c_str(), a.recurso.c_str(), a.ciclo);
+                    ImGui::Text("- %s %s %s en ciclo %lld", a.pid.c_str(), a.tipo.c_str(), a.recurso.c_str(), a.ciclo);
                 }
                 ImGui::EndChild();
             }
@@ -281,128 +665,69 @@ int main() {
         ImGui::Separator();
 
         // Botón para ejecutar simulación
-        if (ImGui::Button(simulacionListo ? "Reiniciar Simulación" : "Ejecutar Simulación")) {
+        if (simType != SimulationType::Remota &&
+            ImGui::Button(simulacionListo ? "Reiniciar Simulación" : "Ejecutar Simulación")) {
             if (!datosCargados) {
                 ImGui::OpenPopup("ErrorSim");
             } else {
                 // Preparar simuladores y ejecutar
-                eventosGantt.clear();
-                pidToRow.clear();
+                resultados.clear();
+                perfilesRecursos.clear();
+                lineas.clear();
+                estadisticas.reiniciar();
                 currentCycle = 0;
-                tiempoSimulacion = 0.0f;
+                tiempoSimulacion = 0.0;
                 corriendo = false;
 
-                // Mapear PIDs a filas
-                for (size_t i = 0; i < procesos.size(); ++i) {
-                    pidToRow[procesos[i].pid] = static_cast<int>(i);
-                }
-
                 if (simType == SimulationType::Calendarizacion) {
-                    simuladorCal.cargarProcesos(procesos);
-                    simuladorCal.setQuantum(quantum);
-
-                    int offsetFila = 0;
-                    std::vector<Proceso> originalProcesos = procesos; // guardamos copia
-
-                    if (algoFIFO) {
-                        simuladorCal.cargarProcesos(originalProcesos);
-                        simuladorCal.ejecutar(TipoAlgoritmo::FIFO);
-                        auto ev = simuladorCal.getEventos();
-                        for (auto& e : ev) {
-                            int row = pidToRow[e.pid] + offsetFila * originalProcesos.size();
-                            e.estado = "RUNNING";
-                            e.pid = e.pid + "|FIFO";
-                            procesos.push_back(Proceso(e.pid, 0, 0, 0));
-                            pidToRow[e.pid] = row;
-                            eventosGantt.push_back(e);
-                        }
-                        offsetFila++;
-                    }
-                    if (algoSJF) {
-                        simuladorCal.cargarProcesos(originalProcesos);
-                        simuladorCal.ejecutar(TipoAlgoritmo::SJF);
-                        auto ev = simuladorCal.getEventos();
-                        for (auto& e : ev) {
-                            int row = pidToRow[e.pid] + offsetFila * originalProcesos.size();
-                            e.estado = "RUNNING";
-                            e.pid = e.pid + "|SJF";
-                            procesos.push_back(Proceso(e.pid, 0, 0, 0));
-                            pidToRow[e.pid] = row;
-                            eventosGantt.push_back(e);
+                    // Todos los algoritmos leen la misma carga compartida y
+                    // cada uno produce su propio resultado
+                    const std::pair<bool, TipoAlgoritmo> seleccion[] = {
+                        {algoFIFO, TipoAlgoritmo::FIFO},
+                        {algoSJF,  TipoAlgoritmo::SJF},
+                        {algoSRTF, TipoAlgoritmo::SRTF},
+                        {algoRR,   TipoAlgoritmo::ROUND_ROBIN},
+                        {algoPRIO, TipoAlgoritmo::PRIORITY}
+                    };
+                    for (const auto& algo : seleccion) {
+                        if (!algo.first) continue;
+                        SimuladorCalendarizacion& simuladorCal = simuladoresCal[algo.second];
+                        simuladorCal.setDispositivos(dispositivos);
+                        simuladorCal.setGrupos(grupos);
+                        if (gobernador > 0) {
+                            simuladorCal.setDVFS(modeloDVFS, static_cast<TipoGobernador>(gobernador - 1));
+                        } else {
+                            simuladorCal.setDVFS(modeloDVFS, nullptr);
                         }
-                        offsetFila++;
-                    }
-                    if (algoSRTF) {
-                        simuladorCal.cargarProcesos(originalProcesos);
-                        simuladorCal.ejecutar(TipoAlgoritmo::SRTF);
-                        auto ev = simuladorCal.getEventos();
-                        for (auto& e : ev) {
-                            int row = pidToRow[e.pid] + offsetFila * originalProcesos.size();
-                            e.estado = "RUNNING";
-                            e.pid = e.pid + "|SRTF";
-                            procesos.push_back(Proceso(e.pid, 0, 0, 0));
-                            pidToRow[e.pid] = row;
-                            eventosGantt.push_back(e);
-                        }
-                        offsetFila++;
-                    }
-                    if (algoRR) {
-                        simuladorCal.cargarProcesos(originalProcesos);
+                        simuladorCal.cargarCarga(carga);
                         simuladorCal.setQuantum(quantum);
-                        simuladorCal.ejecutar(TipoAlgoritmo::ROUND_ROBIN);
-                        auto ev = simuladorCal.getEventos();
-                        for (auto& e : ev) {
-                            int row = pidToRow[e.pid] + offsetFila * originalProcesos.size();
-                            e.estado = "RUNNING";
-                            e.pid = e.pid + "|RR";
-                            procesos.push_back(Proceso(e.pid, 0, 0, 0));
-                            pidToRow[e.pid] = row;
-                            eventosGantt.push_back(e);
-                        }
-                        offsetFila++;
-                    }
-                    if (algoPRIO) {
-                        simuladorCal.cargarProcesos(originalProcesos);
-                        simuladorCal.ejecutar(TipoAlgoritmo::PRIORITY);
-                        auto ev = simuladorCal.getEventos();
-                        for (auto& e : ev) {
-                            int row = pidToRow[e.pid] + offsetFila * originalProcesos.size();
-                            e.estado = "RUNNING";
-                            e.pid = e.pid + "|PRIO";
-                            procesos.push_back(Proceso(e.pid, 0, 0, 0));
-                            pidToRow[e.pid] = row;
-                            eventosGantt.push_back(e);
-                        }
-                        offsetFila++;
+                        simuladorCal.ejecutarIncremental(algo.second);
+                        estadisticas.acumular(simuladorCal.getEstadisticas());
+                        resultados.push_back(simuladorCal.tomarResultado());
                     }
 
-                    // Métricas promedio (basado en el último algoritmo ejecutado)
-                    avgWaitingTime    = simuladorCal.getAvgWaitingTime();
-                    avgCompletionTime = simuladorCal.getAvgCompletionTime();
-                    avgResponseTime   = simuladorCal.getAvgResponseTime();
-
                 } else {
                     // Sincronización
-                    simuladorSync.cargarProcesos(procesos);
+                    simuladorSync.setDispositivos(dispositivos);
+                    simuladorSync.setGrupos(grupos);
+                    simuladorSync.cargarCarga(carga);
                     simuladorSync.setQuantum(quantum);
                     simuladorSync.cargarRecursos(recursos);
                     simuladorSync.cargarAcciones(acciones);
+                    simuladorSync.setProtocolo(static_cast<ProtocoloRecursos>(protocolo));
+                    simuladorSync.setEntregaPorDefecto(static_cast<PoliticaEntrega>(entrega + 1), parametroEntrega);
+                    simuladorSync.setCostoDespertar(costoDespertar);
                     simuladorSync.ejecutar(TipoAlgoritmo::FIFO); // FIFO para calendarización previa
-                    eventosGantt = simuladorSync.getEventos();
-
-                    // Métricas promedio (usa valores de calendarización interna)
-                    avgWaitingTime    = simuladorSync.getAvgWaitingTime();
-                    avgCompletionTime = simuladorSync.getAvgCompletionTime();
-                    avgResponseTime   = simuladorSync.getAvgResponseTime();
+                    estadisticas.acumular(simuladorSync.getEstadisticas());
+                    perfilesRecursos = simuladorSync.getPerfilRecursos();
+                    recursoSeleccionado = 0;
+                    reordenarRecursos = true;
+                    resultados.push_back(simuladorSync.tomarResultado());
                 }
 
-                // Encontrar ciclo máximo
-                maxCycle = 0;
-                for (const auto& e : eventosGantt) {
-                    if (e.fin > maxCycle) {
-                        maxCycle = e.fin;
-                    }
-                }
+                resultadoEstado = 0;
+                prepararVista();
+
                 simulacionListo = true;
                 corriendo = false;
                 ImGui::OpenPopup("SimListo");
@@ -429,33 +754,275 @@ int main() {
         // Mostrar métricas una vez simulado
         if (simulacionListo) {
             ImGui::Text("Métricas de Eficiencia:");
-            ImGui::Text("Avg Waiting Time    : %.2f", avgWaitingTime);
-            ImGui::Text("Avg Completion Time : %.2f", avgCompletionTime);
-            ImGui::Text("Avg Response Time   : %.2f", avgResponseTime);
+            for (size_t i = 0; i < resultados.size(); ++i) {
+                const ResultadoSimulacion& r = resultados[i];
+                ImGui::Text("[%s]", nombreAlgoritmo(r.algoritmo));
+                ImGui::Text("Avg Waiting Time    : %.2f", r.avgWaitingTime);
+                ImGui::Text("Avg Completion Time : %.2f", r.avgCompletionTime);
+                ImGui::Text("Avg Response Time   : %.2f", r.avgResponseTime);
+                ImGui::Text("Waiting min/max/sd  : %lld / %lld / %.2f", r.resumenEspera.minimo,
+                            r.resumenEspera.maximo, std::sqrt(r.resumenEspera.varianza));
+                ImGui::Text("CPU / Throughput    : %.1f%% / %.4f", 100.0 * r.rendimiento.utilizacionCPU,
+                            r.rendimiento.throughput);
+                for (const auto& d : r.rendimiento.dispositivos) {
+                    ImGui::Text("  %s: %.1f%% ocupado, %lld solicitudes, espera en cola %lld", d.nombre.c_str(),
+                                100.0 * d.utilizacion, d.solicitudes, d.espera);
+                }
+                for (const auto& g : r.rendimiento.grupos) {
+                    ImGui::Text("  %*s%s: CPU %lld (merecida %.0f), cuota %.1f%% / %.1f%%, respuesta %.2f",
+                                2 * g.nivel, "", g.nombre.c_str(), g.cpu, g.cpuMerecida, 100.0 * g.cuota,
+                                100.0 * g.cuotaObjetivo, g.respuestaPromedio);
+                    if (g.respuestaObjetivo > 0) {
+                        ImGui::SameLine();
+                        ImGui::TextColored(g.respuestaPromedio <= g.respuestaObjetivo
+                                               ? ImVec4(0.4f, 0.9f, 0.4f, 1.0f) : ImVec4(0.9f, 0.4f, 0.4f, 1.0f),
+                                           "(objetivo %lld)", g.respuestaObjetivo);
+                    }
+                }
+                const ConsumoEnergia& e = r.rendimiento.energia;
+                if (!e.gobernador.empty()) {
+                    ImGui::Text("Energía             : %.2f con %s (activa %.2f, ociosa %.2f, %lld cambios)",
+                                e.total, e.gobernador.c_str(), e.activa, e.ociosa, e.numCambios);
+                    ImGui::Text("Frecuencia media    : %.0f", e.frecuenciaMedia);
+                }
+
+                // Distribución del tiempo de espera entre mínimo y máximo
+                const std::vector<float>& h = histogramasEspera[i];
+                std::string id = std::string("##hist") + nombreAlgoritmo(r.algoritmo);
+                ImGui::PlotHistogram(id.c_str(), h.data(), static_cast<int>(h.size()),
+                                     0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+            }
+
+            // Tiempo bloqueado por nivel de prioridad (solo sincronización)
+            if (simType == SimulationType::Sincronizacion) {
+                ResumenBloqueo bloqueo = simuladorSync.getResumenBloqueo();
+                ImGui::Text("Bloqueo por prioridad (%s):", nombreProtocolo(simuladorSync.getProtocolo()));
+                for (const auto& nivel : bloqueo.niveles) {
+                    ImGui::Text("  Prioridad %d: %lld ciclos, máximo %lld (%lld procesos)",
+                                nivel.prioridad, nivel.total, nivel.maximo, nivel.procesos);
+                }
+                ImGui::Text("Inversiones: %lld  Ciclos cedidos: %lld", bloqueo.inversiones, bloqueo.ciclosDonados);
+
+                // Costo de la contención frente a la espera
+                const ResumenContencion& c = simuladorSync.getResumenContencion();
+                ImGui::Text("Trabajo completado : %lld / %lld", c.trabajo, c.trabajoTotal);
+                ImGui::Text("Giro / despertar   : %lld / %lld ciclos", c.ciclosGiro, c.ciclosDespertar);
+                ImGui::Text("Despertares inútiles: %lld de %lld", c.despertaresInutiles, c.despertares);
+                ImGui::Text("Adelantamientos    : %lld", c.adelantamientos);
+                ImGui::Text("Espera media / máx : %.2f / %lld",
+                            c.esperas > 0 ? static_cast<double>(c.esperaTotal) / c.esperas : 0.0, c.esperaMaxima);
+            }
+
+            // Contención por recurso: tabla ordenable y detalle del
+            // recurso seleccionado
+            if (!perfilesRecursos.empty() && ImGui::CollapsingHeader("Contención por recurso")) {
+                if (ImGui::BeginTable("##recursos", 8,
+                                      ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable |
+                                      ImGuiTableFlags_ScrollY,
+                                      ImVec2(0, 150))) {
+                    ImGui::TableSetupScrollFreeze(0, 1);
+                    ImGui::TableSetupColumn("Recurso");
+                    ImGui::TableSetupColumn("Adq.");
+                    ImGui::TableSetupColumn("Disput.");
+                    ImGui::TableSetupColumn("Cola máx");
+                    ImGui::TableSetupColumn("Retención");
+                    ImGui::TableSetupColumn("Espera");
+                    ImGui::TableSetupColumn("Espera total",
+                                            ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+                    ImGui::TableSetupColumn("Uso");
+                    ImGui::TableHeadersRow();
+
+                    // Reordenar solo cuando cambia la columna, el sentido o
+                    // los datos
+                    ImGuiTableSortSpecs* orden = ImGui::TableGetSortSpecs();
+                    if (orden && (orden->SpecsDirty || reordenarRecursos) && orden->SpecsCount > 0) {
+                        const ImGuiTableColumnSortSpecs& spec = orden->Specs[0];
+                        auto clave = [&spec](const PerfilRecurso& p) -> double {
+                            switch (spec.ColumnIndex) {
+                                case 1: return static_cast<double>(p.adquisiciones);
+                                case 2: return static_cast<double>(p.disputadas);
+                                case 3: return static_cast<double>(p.colaMaxima);
+                                case 4: return p.retencion.media;
+                                case 5: return p.espera.media;
+                                case 6: return static_cast<double>(p.espera.suma);
+                                default: return p.utilizacion;
+                            }
+                        };
+                        bool ascendente = spec.SortDirection == ImGuiSortDirection_Ascending;
+                        std::stable_sort(perfilesRecursos.begin(), perfilesRecursos.end(),
+                            [&](const PerfilRecurso& a, const PerfilRecurso& b) {
+                                if (spec.ColumnIndex == 0) {
+                                    return ascendente ? a.nombre < b.nombre : b.nombre < a.nombre;
+                                }
+                                return ascendente ? clave(a) < clave(b) : clave(b) < clave(a);
+                            });
+                        orden->SpecsDirty = false;
+                        reordenarRecursos = false;
+                    }
+
+                    for (size_t r = 0; r < perfilesRecursos.size(); ++r) {
+                        const PerfilRecurso& p = perfilesRecursos[r];
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        if (ImGui::Selectable(p.nombre.c_str(), recursoSeleccionado == static_cast<int>(r),
+                                              ImGuiSelectableFlags_SpanAllColumns)) {
+                            recursoSeleccionado = static_cast<int>(r);
+                        }
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%lld", p.adquisiciones);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%lld", p.disputadas);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%zu", p.colaMaxima);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f / %lld", p.retencion.media, p.retencion.maximo);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f / %lld", p.espera.media, p.espera.maximo);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.0Lf", p.espera.suma);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.1f%%", 100.0 * p.utilizacion);
+                    }
+                    ImGui::EndTable();
+                }
+
+                recursoSeleccionado = std::min(recursoSeleccionado, static_cast<int>(perfilesRecursos.size()) - 1);
+                const PerfilRecurso& p = perfilesRecursos[recursoSeleccionado];
+                std::vector<float> retencion(p.histogramaRetencion.begin(), p.histogramaRetencion.end());
+                std::vector<float> espera(p.histogramaEspera.begin(), p.histogramaEspera.end());
+                ImGui::Text("%s (capacidad %d)", p.nombre.c_str(), p.capacidad);
+                ImGui::Text("Retención [%lld, %lld]:", p.retencion.minimo, p.retencion.maximo);
+                ImGui::PlotHistogram("##retencion", retencion.data(), static_cast<int>(retencion.size()),
+                                     0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+                ImGui::Text("Espera [%lld, %lld]:", p.espera.minimo, p.espera.maximo);
+                ImGui::PlotHistogram("##espera", espera.data(), static_cast<int>(espera.size()),
+                                     0, nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+                ImGui::Text("Uso en el tiempo:");
+                ImGui::PlotLines("##uso", p.usoEnElTiempo.data(), static_cast<int>(p.usoEnElTiempo.size()),
+                                 0, nullptr, 0.0f, 1.0f, ImVec2(0, 40));
+            }
+
+            // Instrumentación (panel plegable)
+            if (ImGui::CollapsingHeader("Instrumentación")) {
+                if (INSTRUMENTACION_ACTIVA) {
+                    ImGui::Text("Despachos        : %lld", estadisticas.despachos);
+                    ImGui::Text("Expropiaciones   : %lld", estadisticas.expropiaciones);
+                    ImGui::Text("Eventos emitidos : %lld", estadisticas.eventosEmitidos);
+                    ImGui::Text("Búsquedas recurso: %lld", estadisticas.busquedasRecurso);
+                    for (int f = 0; f < NUM_FASES; ++f) {
+                        ImGui::Text("%-18s: %.1f us", nombreFase(f), estadisticas.nanosFase[f] / 1000.0);
+                    }
+                    ImGui::Text("Total            : %.1f us", estadisticas.nanosTotal / 1000.0);
+                } else {
+                    ImGui::TextUnformatted("Compilado sin SIMULADOR_INSTRUMENTACION.");
+                }
+            }
 
             ImGui::Separator();
             // Controles de animación
             ImGui::Text("Animación:");
-            ImGui::SliderFloat("Velocidad", &velocidad, 0.1f, 10.0f, "%.1f");
-            if (ImGui::Button(corriendo ? "Pausar" : "Iniciar")) {
-                corriendo = !corriendo;
-                if (!corriendo) {
-                    // Si se pausó, no reiniciar el tiempo
-                } else {
-                    // Si inicia por primera vez, resetear tiempo
-                    if (currentCycle >= maxCycle) {
-                        currentCycle = 0;
-                        tiempoSimulacion = 0.0f;
-                    }
+            ImGui::SliderFloat("Velocidad", &velocidad, 0.1f, 100000.0f, "%.1f", ImGuiSliderFlags_Logarithmic);
+            ImGui::SliderFloat("Zoom", &pixelsPerCycle, 0.0001f, 50.0f, "%.4f px/ciclo", ImGuiSliderFlags_Logarithmic);
+
+            // Saltar a un ciclo: el tiempo de animación se ajusta para que
+            // la reproducción continúe desde ahí
+            auto irACiclo = [&](Tiempo ciclo) {
+                currentCycle = std::max<Tiempo>(0, std::min(ciclo, maxCycle));
+                tiempoSimulacion = eje.aEje(currentCycle) * segundosPorCiclo;
+                centrarCursor = true;
+            };
+
+            if (ImGui::Button(corriendo && direccion < 0 ? "Pausar##rev" : "<< Reversa")) {
+                corriendo = !(corriendo && direccion < 0);
+                direccion = -1;
+                if (corriendo && currentCycle <= 0) {
+                    irACiclo(maxCycle);
+                }
+            }
+            ImGui::SameLine();
+            if (ImGui::Button(corriendo && direccion > 0 ? "Pausar" : "Iniciar")) {
+                corriendo = !(corriendo && direccion > 0);
+                direccion = 1;
+                // Si ya llegó al final, empezar de nuevo
+                if (corriendo && currentCycle >= maxCycle) {
+                    irACiclo(0);
                 }
             }
             ImGui::SameLine();
             if (ImGui::Button("Reiniciar")) {
                 corriendo = false;
-                currentCycle = 0;
-                tiempoSimulacion = 0.0f;
+                irACiclo(0);
+            }
+
+            // Paso a paso y barra de búsqueda
+            if (ImGui::Button("<")) {
+                corriendo = false;
+                irACiclo(currentCycle - 1);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button(">")) {
+                corriendo = false;
+                irACiclo(currentCycle + 1);
+            }
+            ImGui::SameLine();
+            Tiempo cicloBarra = currentCycle;
+            const Tiempo cicloCero = 0;
+            if (ImGui::SliderScalar("##ciclo", ImGuiDataType_S64, &cicloBarra, &cicloCero, &maxCycle, "%lld")) {
+                irACiclo(cicloBarra);
+            }
+            ImGui::InputScalar("##destino", ImGuiDataType_S64, &cicloDestino);
+            ImGui::SameLine();
+            if (ImGui::Button("Ir a")) {
+                corriendo = false;
+                irACiclo(cicloDestino);
+            }
+            ImGui::Text("Ciclo Actual: %lld / %lld", currentCycle, maxCycle);
+
+            // Estado de los procesos en el ciclo actual
+            if (!lineas.empty() && ImGui::CollapsingHeader("Estado en el ciclo actual")) {
+                if (lineas.size() > 1) {
+                    std::vector<const char*> nombres;
+                    for (const auto& r : resultados) {
+                        nombres.push_back(nombreAlgoritmo(r.algoritmo));
+                    }
+                    ImGui::Combo("Algoritmo", &resultadoEstado, nombres.data(), static_cast<int>(nombres.size()));
+                }
+                const LineaTiempo& linea = lineas[resultadoEstado];
+                LineaTiempo::Conteo conteo = linea.contarEn(currentCycle);
+                ImGui::Text("Llegados: %d  Terminados: %d  CPU: %s",
+                            conteo.llegados, conteo.terminados,
+                            conteo.enCpu >= 0 ? (*carga)[conteo.enCpu].pid.c_str() : "libre");
+
+                if (ImGui::BeginTable("##estado", 4,
+                                      ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                                      ImVec2(0, 200))) {
+                    ImGui::TableSetupScrollFreeze(0, 1);
+                    ImGui::TableSetupColumn("PID");
+                    ImGui::TableSetupColumn("Estado");
+                    ImGui::TableSetupColumn("Ejecutado");
+                    ImGui::TableSetupColumn("Restante");
+                    ImGui::TableHeadersRow();
+
+                    // Solo se consultan las filas visibles
+                    ImGuiListClipper clipper;
+                    clipper.Begin(static_cast<int>(carga->size()));
+                    while (clipper.Step()) {
+                        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                            LineaTiempo::Foto foto = linea.estadoEn(i, currentCycle);
+                            ImGui::TableNextRow();
+                            ImGui::TableNextColumn();
+                            ImGui::TextUnformatted((*carga)[i].pid.c_str());
+                            ImGui::TableNextColumn();
+                            ImGui::TextUnformatted(LineaTiempo::nombreEstado(foto.estado));
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%lld", foto.ejecutado);
+                            ImGui::TableNextColumn();
+                            ImGui::Text("%lld", foto.restante);
+                        }
+                    }
+                    ImGui::EndTable();
+                }
             }
-            ImGui::Text("Ciclo Actual: %d / %d", currentCycle, maxCycle);
         }
 
         ImGui::End(); // << Fin de "Controles del Simulador"
@@ -470,17 +1037,22 @@ int main() {
                      ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse);
 
         if (simulacionListo) {
-            // Actualizar animación si está corriendo
+            // Actualizar animación si está corriendo. Avanza sobre el eje,
+            // así que los huecos comprimidos se cruzan en pocos pasos
             if (corriendo) {
-                tiempoSimulacion += deltaClock.getElapsedTime().asSeconds() * velocidad;
-                int cicloAvanzado = static_cast<int>(tiempoSimulacion / segundosPorCiclo);
-                if (cicloAvanzado > currentCycle) {
-                    currentCycle = cicloAvanzado;
-                    if (currentCycle > maxCycle) {
-                        currentCycle = maxCycle;
-                        corriendo = false;
-                    }
+                tiempoSimulacion += deltaClock.getElapsedTime().asSeconds() * velocidad * direccion;
+                Tiempo cicloAvanzado = eje.aTiempo(tiempoSimulacion / segundosPorCiclo);
+                if (cicloAvanzado >= maxCycle) {
+                    cicloAvanzado = maxCycle;
+                    corriendo = false;
+                } else if (cicloAvanzado <= 0) {
+                    cicloAvanzado = 0;
+                    corriendo = false;
+                }
+                if (!corriendo) {
+                    tiempoSimulacion = eje.aEje(cicloAvanzado) * segundosPorCiclo;
                 }
+                currentCycle = cicloAvanzado;
             }
 
             ImGui::BeginChild("##GanttScrollArea", ImVec2(0, 0), true,
@@ -489,62 +1061,64 @@ int main() {
             ImDrawList* drawList = ImGui::GetWindowDrawList();
             ImVec2 origin = ImGui::GetCursorScreenPos();
 
-            // Tamaños de filas
-            float rowHeight = 24.0f;
-            float labelWidth = 60.0f;
-            float contentHeight = (static_cast<float>(procesos.size()) * rowHeight) + 30.0f;
-            float contentWidth = CycleToX(maxCycle + 1, pixelsPerCycle) + labelWidth + 50.0f;
-
-            // Dibujar líneas horizontales por fila
-            for (size_t i = 0; i < procesos.size(); ++i) {
-                float y = origin.y + 5 + i * rowHeight;
-                drawList->AddLine(
-                    ImVec2(origin.x + labelWidth, y),
-                    ImVec2(origin.x + contentWidth, y),
-                    IM_COL32(70, 70, 70, 255), 1.0f
-                );
-                // Etiqueta de PID
-                drawList->AddText(
-                    ImVec2(origin.x + 2, y - (rowHeight / 2) + 6),
-                    IM_COL32(200, 200, 200, 255),
-                    procesos[i].pid.c_str()
-                );
-            }
-
-            // Dibujar eventos de Gantt hasta currentCycle
-            for (const auto& e : eventosGantt) {
-                if (e.fin <= currentCycle) {
-                    int fila = pidToRow[e.pid];
-                    float y = origin.y + 5 + fila * rowHeight;
-                    float x0 = origin.x + labelWidth + CycleToX(e.inicio, pixelsPerCycle);
-                    float x1 = origin.x + labelWidth + CycleToX(e.fin, pixelsPerCycle);
-
-                    ImU32 col;
-                    if (e.estado == "RUNNING") {
-                        col = ColorFromPID(e.pid);
-                    } else if (e.estado == "WAITING") {
-                        col = IM_COL32(200, 50, 50, 200);
-                    } else if (e.estado == "ACCESSED") {
-                        col = IM_COL32(50, 200, 50, 200);
-                    } else {
-                        col = ColorFromPID(e.pid);
-                    }
+            // Tamaño del contenido
+            size_t numProcesos = carga->size();
+            size_t numFilas = resultados.size() * numProcesos;
+            float contentHeight = (static_cast<float>(numFilas) * rowHeight) + 30.0f;
+            float contentWidth = CycleToX(eje.aEje(maxCycle + 1), pixelsPerCycle) + labelWidth + 50.0f;
 
-                    drawList->AddRectFilled(
-                        ImVec2(x0, y - (rowHeight / 2) + 4),
-                        ImVec2(x1, y + (rowHeight / 2) - 4),
-                        col
-                    );
-                    drawList->AddText(
-                        ImVec2(x0 + 2, y - 5),
-                        IM_COL32(0, 0, 0, 255),
-                        std::to_string(e.inicio).c_str()
-                    );
-                }
+            // Tras un salto, centrar el cursor en la vista
+            if (centrarCursor) {
+                ImGui::SetScrollX(labelWidth + CycleToX(eje.aEje(currentCycle), pixelsPerCycle) - ImGui::GetWindowWidth() / 2);
+                centrarCursor = false;
+            }
+
+            // Rehacer la caché solo si cambió lo que muestra
+            ClaveGantt clave;
+            clave.version = versionVista;
+            clave.pixelsPerCycle = pixelsPerCycle;
+            clave.scrollX = ImGui::GetScrollX();
+            clave.scrollY = ImGui::GetScrollY();
+            clave.ancho = static_cast<unsigned>(std::max(1.0f, ImGui::GetWindowWidth()));
+            clave.alto = static_cast<unsigned>(std::max(1.0f, ImGui::GetWindowHeight()));
+            if (clave != claveGantt) {
+                dibujarGantt(clave);
+                claveGantt = clave;
+            }
+
+            // Esquina de la parte visible en pantalla y posición del
+            // cursor dentro de ella
+            ImVec2 vista(origin.x + clave.scrollX, origin.y + clave.scrollY);
+            float cursorVista = labelWidth + CycleToX(eje.aEje(currentCycle), pixelsPerCycle) - clave.scrollX;
+
+            // Las imágenes se recortan al contenido para no agrandarlo
+            int anchoVisible = static_cast<int>(std::max(0.0f, std::min(static_cast<float>(clave.ancho), contentWidth - clave.scrollX)));
+            int altoVisible = static_cast<int>(std::max(0.0f, std::min(static_cast<float>(clave.alto), contentHeight - clave.scrollY)));
+            int anchoBarras = std::min(anchoVisible, static_cast<int>(std::max(0.0f, cursorVista)));
+
+            // Las texturas de SFML quedan de cabeza: el rectángulo va de
+            // abajo hacia arriba
+            int base = static_cast<int>(clave.alto);
+            if (anchoVisible > 0 && altoVisible > 0) {
+                sf::Sprite fondo(lienzoFondo.getTexture(), sf::IntRect(0, base, anchoVisible, -altoVisible));
+                ImGui::SetCursorScreenPos(vista);
+                ImGui::Image(fondo, sf::Vector2f(static_cast<float>(anchoVisible), static_cast<float>(altoVisible)));
+            }
+            if (anchoBarras > 0 && altoVisible > 0) {
+                sf::Sprite barras(lienzoBarras.getTexture(), sf::IntRect(0, base, anchoBarras, -altoVisible));
+                ImGui::SetCursorScreenPos(vista);
+                ImGui::Image(barras, sf::Vector2f(static_cast<float>(anchoBarras), static_cast<float>(altoVisible)));
+            }
+            for (const auto& t : etiquetasFondo) {
+                drawList->AddText(ImVec2(vista.x + t.posicion.x, vista.y + t.posicion.y), t.color, t.texto.c_str());
+            }
+            for (const auto& t : etiquetasBarras) {
+                if (t.posicion.x >= cursorVista) continue;
+                drawList->AddText(ImVec2(vista.x + t.posicion.x, vista.y + t.posicion.y), t.color, t.texto.c_str());
             }
 
             // Línea vertical que marca currentCycle
-            float xLine = origin.x + labelWidth + CycleToX(currentCycle, pixelsPerCycle);
+            float xLine = vista.x + cursorVista;
             drawList->AddLine(
                 ImVec2(xLine, origin.y + 2),
                 ImVec2(xLine, origin.y + contentHeight),
@@ -552,6 +1126,7 @@ int main() {
             );
 
             // Espacio final para scrollbar
+            ImGui::SetCursorScreenPos(origin);
             ImGui::Dummy(ImVec2(contentWidth, contentHeight));
             ImGui::EndChild();
         } else {